@@ -0,0 +1,324 @@
+#!/usr/bin/env python3
+
+# Design space exploration over the config.yml of a benchmark
+#
+# Every design point is a copy of the benchmark config.yml with some values
+# replaced. The points are generated with systembuilder.py and simulated by
+# gem5 processes on a local pool of workers, and the selected stats of every
+# point are collected into one CSV table. See dse_template.yml for the sweep
+# file format.
+#
+# Points share work across gem5 processes:
+#  - The first point runs alone and fills the static graph cache of every
+#    accelerator (LLVMInterface graph_cache), so the others skip IR parsing
+#    and loop analysis.
+#  - CACTI estimates are memoized in cacti_cache.txt under M5_PATH.
+#  - With --checkpoint, each address map is booted once up to the guest
+#    m5_checkpoint() call, and its points restore that checkpoint. Points
+#    sharing a checkpoint should only differ in timing, FU and SPM port
+#    parameters, which are not part of the checkpointed state.
+#
+# Points that change the address map (SPM sizes) get their own copy of the
+# benchmark with the regenerated header, and their software is rebuilt.
+
+# Import needed packages
+import argparse
+import copy
+import csv
+import hashlib
+import itertools
+import os
+import re
+import shutil
+import subprocess
+import sys
+import yaml
+from concurrent.futures import ThreadPoolExecutor
+
+# This requires M5_PATH to point to your gem5-SALAM directory
+M5_Path = os.getenv('M5_PATH')
+
+defaultGem5Args = ["--mem-size=4GB",
+                   "--mem-type=DDR4_2400_8x8",
+                   "--disk-image=$M5_PATH/baremetal/common/fake.iso",
+                   "--machine-type=VExpress_GEM5_V1",
+                   "--dtb-file=none", "--bare-metal",
+                   "--cpu-type=DerivO3CPU",
+                   "--caches", "--l2cache"]
+
+defaultStats = [r"^simSeconds$",
+                r"^hostSeconds$",
+                r"\.llvm_interface\.cycles$",
+                r"\.llvm_interface\.stallCycles$",
+                r"\.llvm_interface\.dynamicInsts$",
+                r"\.salam_power_model\.power\.totalArea$",
+                r"\.salam_power_model\.power\.totalEnergy$"]
+
+statsBegin = "---------- Begin Simulation Statistics ----------"
+
+# Parse Arguements
+parser = argparse.ArgumentParser(description="SALAM Design Space Exploration")
+parser.add_argument('--sweep', help="Sweep file, see dse_template.yml", required=True)
+parser.add_argument('--outdir', help="Output directory for the gem5 runs and " +
+"results.csv, relative to M5_PATH", default="BM_ARM_OUT/dse")
+parser.add_argument('--jobs', type=int, default=os.cpu_count(),
+help="Number of gem5 processes to run at once")
+parser.add_argument('--binary', help="gem5 binary", default="build/ARM/gem5.opt")
+parser.add_argument('--checkpoint', action="store_true",
+help="Boot each address map once and restore its checkpoint for every point")
+parser.add_argument('--dump', type=int, default=0,
+help="Stats dump to collect, 0 is the first. Benchmarks that reset and dump " +
+"stats around their region of interest report it in the first dump")
+parser.add_argument('--keep', action="store_true",
+help="Keep the generated benchmark copies and configs")
+parser.add_argument('--path', help="Path to M5 Directory", required=False)
+args = parser.parse_args()
+
+if M5_Path is None:
+    print("Looking for Path Argument from Command Line")
+    M5_Path = args.path
+    if M5_Path is None:
+        print("M5_PATH Not Found")
+        exit(1)
+M5_Path = os.path.abspath(M5_Path)
+
+CONFIG_Path = M5_Path + "/configs/SALAM/generated/"
+
+class Dimension:
+    # One swept value of config.yml
+    def __init__(self, entry):
+        self.values = entry['values']
+        if 'var' in entry:
+            # Key of a variable of an accelerator in acc_cluster
+            self.kind = 'var'
+            self.target = entry['var']
+            default = self.target['acc'] + "." + self.target['name'] + "." + self.target['key']
+        elif 'cycles' in entry:
+            # Runtime cycles of an instruction in hw_config
+            self.kind = 'cycles'
+            self.target = entry['cycles']
+            default = self.target['acc'] + "." + self.target['inst'] + ".cycles"
+        elif 'param' in entry:
+            # SimObject parameter of an accelerator, see HWAccConfig.applyParams
+            self.kind = 'param'
+            self.target = entry['param']
+            default = self.target['acc'] + "." + self.target['name']
+        else:
+            print("Sweep entry needs a var, cycles or param target: " + str(entry))
+            exit(1)
+        self.label = entry.get('label', default)
+
+    def apply(self, documents, value):
+        target = self.target
+        for document in documents:
+            if self.kind == 'var':
+                for device in document.get('acc_cluster', []):
+                    if 'Accelerator' not in device:
+                        continue
+                    items = device['Accelerator']
+                    if not any(item.get('Name') == target['acc'] for item in items):
+                        continue
+                    for item in items:
+                        for var in item.get('Var', []):
+                            if var.get('Name') == target['name']:
+                                var[target['key']] = value
+                                return
+            else:
+                hwConfig = document.get('hw_config')
+                if hwConfig is None or target['acc'] not in hwConfig:
+                    continue
+                if hwConfig[target['acc']] is None:
+                    hwConfig[target['acc']] = {}
+                accConfig = hwConfig[target['acc']]
+                if self.kind == 'cycles':
+                    accConfig['instructions'][target['inst']]['runtime_cycles'] = value
+                else:
+                    accConfig.setdefault('params', {})[target['name']] = value
+                return
+        print("Sweep target not found in config.yml: " + self.label)
+        exit(1)
+
+class Point:
+    def __init__(self, index, values):
+        self.index = index
+        self.values = values
+        self.name = "p%04d" % index
+        self.outdir = None
+        self.workDir = None
+        self.sysName = None
+        self.kernel = None
+        self.mapKey = None
+
+def run(cmd, log, cwd=M5_Path):
+    with open(log, "w") as output:
+        return subprocess.run(cmd, cwd=cwd, stdout=output, stderr=subprocess.STDOUT).returncode
+
+def headers(benchDir):
+    contents = {}
+    for fileName in sorted(os.listdir(benchDir)):
+        if fileName.endswith("_hw_defines.h"):
+            with open(os.path.join(benchDir, fileName)) as header:
+                contents[fileName] = header.read()
+    return contents
+
+def generate(point, sweep, dimensions, baseDocuments, graphCache):
+    benchDir = os.path.join(M5_Path, sweep['bench'])
+    bench = os.path.basename(benchDir.rstrip("/"))
+    # A sibling of the benchmark, so its relative includes still resolve
+    point.workDir = benchDir.rstrip("/") + "_dse_" + point.name
+    point.sysName = bench + "_dse_" + point.name
+    shutil.rmtree(point.workDir, ignore_errors=True)
+    shutil.copytree(benchDir, point.workDir, symlinks=True)
+
+    documents = copy.deepcopy(baseDocuments)
+    for dimension, value in zip(dimensions, point.values):
+        dimension.apply(documents, value)
+    # Every accelerator shares the static graph cache of the sweep
+    for document in documents:
+        hwConfig = document.get('hw_config') or {}
+        for key in hwConfig:
+            if hwConfig[key] is None:
+                hwConfig[key] = {}
+            hwConfig[key].setdefault('params', {}).setdefault(
+                'llvm_interface.graph_cache', graphCache)
+    with open(os.path.join(point.workDir, "config.yml"), "w") as config:
+        yaml.safe_dump_all(documents, config, explicit_start=True, sort_keys=False)
+
+    log = os.path.join(point.outdir, "systembuilder.log")
+    if run([sys.executable, M5_Path + "/SALAM-Configurator/systembuilder.py",
+            "--sysName", point.sysName,
+            "--benchDir", os.path.relpath(point.workDir, M5_Path),
+            "--path", M5_Path], log) != 0:
+        print(point.name + ": systembuilder failed, see " + log)
+        return False
+
+    generated = headers(point.workDir)
+    point.mapKey = hashlib.sha1(repr(sorted(generated.items())).encode()).hexdigest()[:12]
+    if generated == headers(benchDir):
+        point.kernel = os.path.join(benchDir, "sw", "main.elf")
+    else:
+        # The address map moved, the software needs the new header
+        log = os.path.join(point.outdir, "make.log")
+        if run(["make", "-C", os.path.join(point.workDir, "sw")], log) != 0:
+            print(point.name + ": software build failed, see " + log)
+            return False
+        point.kernel = os.path.join(point.workDir, "sw", "main.elf")
+    return True
+
+def gem5Command(point, sweep, extra):
+    gem5Args = [os.path.expandvars(arg) for arg in sweep.get('gem5_args', defaultGem5Args)]
+    return ([os.path.join(M5_Path, args.binary), "--outdir=" + point.outdir,
+             CONFIG_Path + "fs_" + point.sysName + ".py",
+             "--kernel=" + point.kernel,
+             "--accpath=" + os.path.dirname(point.workDir),
+             "--accbench=" + os.path.basename(point.workDir)]
+            + gem5Args + extra)
+
+def simulate(point, sweep, checkpoints):
+    extra = []
+    if point.mapKey in checkpoints:
+        extra = ["--checkpoint-dir=" + checkpoints[point.mapKey], "-r", "1"]
+    log = os.path.join(point.outdir, "sim.log")
+    status = run(gem5Command(point, sweep, extra), log)
+    if status != 0:
+        print(point.name + ": gem5 exited with " + str(status) + ", see " + log)
+    else:
+        print(point.name + ": done")
+    return status == 0
+
+def boot(point, sweep, checkpointDir):
+    # Runs until the guest takes its first checkpoint
+    os.makedirs(checkpointDir, exist_ok=True)
+    log = os.path.join(checkpointDir, "boot.log")
+    status = run(gem5Command(point, sweep, ["--checkpoint-dir=" + checkpointDir,
+                                            "--max-checkpoints=1"]), log)
+    if status != 0 or not any(d.startswith("cpt.") for d in os.listdir(checkpointDir)):
+        print("Boot of address map " + point.mapKey + " took no checkpoint, see " + log)
+        return False
+    return True
+
+def collect(point, patterns):
+    statsFile = os.path.join(point.outdir, "stats.txt")
+    if not os.path.exists(statsFile):
+        return {}
+    with open(statsFile) as stats:
+        dumps = stats.read().split(statsBegin)[1:]
+    if args.dump >= len(dumps):
+        return {}
+    results = {}
+    for line in dumps[args.dump].splitlines():
+        fields = line.split()
+        if len(fields) < 2:
+            continue
+        if any(pattern.search(fields[0]) for pattern in patterns):
+            results[fields[0]] = fields[1]
+    return results
+
+def main():
+    with open(args.sweep) as sweepFile:
+        sweep = yaml.safe_load(sweepFile)
+    dimensions = [Dimension(entry) for entry in sweep['sweep']]
+    patterns = [re.compile(pattern) for pattern in sweep.get('stats', defaultStats)]
+    with open(os.path.join(M5_Path, sweep['bench'], "config.yml")) as config:
+        baseDocuments = [document for document in yaml.safe_load_all(config)
+                         if document is not None]
+
+    outdir = os.path.join(M5_Path, args.outdir)
+    graphCache = os.path.join(outdir, "graph_cache")
+    os.makedirs(graphCache, exist_ok=True)
+
+    points = [Point(index, values) for index, values in
+              enumerate(itertools.product(*[d.values for d in dimensions]))]
+    print("Generating " + str(len(points)) + " design points")
+    for point in points:
+        point.outdir = os.path.join(outdir, point.name)
+        os.makedirs(point.outdir, exist_ok=True)
+    # systembuilder writes into the shared generated config directory
+    ready = [point for point in points if generate(point, sweep, dimensions, baseDocuments, graphCache)]
+
+    checkpoints = {}
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        if args.checkpoint:
+            firstOfMap = {}
+            for point in ready:
+                firstOfMap.setdefault(point.mapKey, point)
+            print("Booting " + str(len(firstOfMap)) + " address maps")
+            dirs = {key: os.path.join(outdir, "checkpoints", key) for key in firstOfMap}
+            booted = pool.map(lambda key: boot(firstOfMap[key], sweep, dirs[key]), list(firstOfMap))
+            for key, ok in zip(list(firstOfMap), booted):
+                if ok:
+                    checkpoints[key] = dirs[key]
+        if ready:
+            # Fill the graph cache before fanning out
+            simulate(ready[0], sweep, checkpoints)
+            list(pool.map(lambda point: simulate(point, sweep, checkpoints), ready[1:]))
+
+    columns = []
+    rows = []
+    for point in points:
+        results = collect(point, patterns)
+        for stat in results:
+            if stat not in columns:
+                columns.append(stat)
+        rows.append((point, results))
+    table = os.path.join(outdir, "results.csv")
+    with open(table, "w", newline="") as csvFile:
+        writer = csv.writer(csvFile)
+        writer.writerow(["point"] + [d.label for d in dimensions] + columns)
+        for point, results in rows:
+            writer.writerow([point.name] + list(point.values) +
+                            [results.get(stat, "") for stat in columns])
+    print("Results of " + str(sum(1 for _, r in rows if r)) + "/" + str(len(points)) +
+          " points written to " + table)
+
+    if not args.keep:
+        for point in points:
+            if point.workDir:
+                shutil.rmtree(point.workDir, ignore_errors=True)
+            if point.sysName:
+                for generated in (point.sysName + ".py", "fs_" + point.sysName + ".py"):
+                    if os.path.exists(CONFIG_Path + generated):
+                        os.remove(CONFIG_Path + generated)
+
+if __name__ == "__main__":
+    main()
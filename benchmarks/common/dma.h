@@ -7,15 +7,50 @@ volatile char * FLAGS = (char *)(MMR_ADDR);
 volatile size_t * SRC = (size_t *)(MMR_ADDR+1);
 volatile size_t * DST = (size_t *)(MMR_ADDR+9);
 volatile int * LEN = (int *)(MMR_ADDR+17);
+// Strided transfer registers, mapped when pio_size is at least 52
+volatile unsigned * ELEM_SIZE = (unsigned *)(MMR_ADDR+24);
+volatile unsigned * ROWS = (unsigned *)(MMR_ADDR+28);
+volatile unsigned * PLANES = (unsigned *)(MMR_ADDR+32);
+volatile unsigned * SRC_ROW_STRIDE = (unsigned *)(MMR_ADDR+36);
+volatile unsigned * DST_ROW_STRIDE = (unsigned *)(MMR_ADDR+40);
+volatile unsigned * SRC_PLANE_STRIDE = (unsigned *)(MMR_ADDR+44);
+volatile unsigned * DST_PLANE_STRIDE = (unsigned *)(MMR_ADDR+48);
 volatile unsigned flag;
+// Set while the strided registers hold a tile, so plain copies reset them.
+// The strided registers are only written on DMAs that use dmacpyTile.
+unsigned dmaTiled = 0;
 
-void dmacpy(void * dst, void * src, int len) {
+void dmaStart(void * dst, void * src, int len) {
     *SRC = (size_t)src;
     *DST = (size_t)dst;
     *LEN = len;
     *FLAGS |= 0x01;
 }
 
+void dmacpy(void * dst, void * src, int len) {
+    if (dmaTiled) {
+        *ELEM_SIZE = 1;
+        *ROWS = 1;
+        *PLANES = 1;
+        dmaTiled = 0;
+    }
+    dmaStart(dst, src, len);
+}
+
+// Copy a 2D tile of rows of len bytes
+void dmacpyTile(void * dst, void * src, int len, unsigned rows,
+                unsigned srcStride, unsigned dstStride) {
+    *ELEM_SIZE = 1;
+    *ROWS = rows;
+    *PLANES = 1;
+    *SRC_ROW_STRIDE = srcStride;
+    *DST_ROW_STRIDE = dstStride;
+    *SRC_PLANE_STRIDE = 0;
+    *DST_PLANE_STRIDE = 0;
+    dmaTiled = 1;
+    dmaStart(dst, src, len);
+}
+
 int pollDma() {
     return ((*FLAGS&0x04)==0x04);
 }
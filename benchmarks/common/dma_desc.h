@@ -0,0 +1,79 @@
+#ifndef __DMA_DESC_H__
+#define __DMA_DESC_H__
+
+#include "inttypes.h"
+
+#define MMR_ADDR    0x2ff00000
+#define CH_OFFSET   56
+#define CH_SIZE     16
+
+// Descriptor flags
+#define DESC_INT    0x1
+
+// Channel flags
+#define CH_START    0x01
+#define CH_RUNNING  0x02
+#define CH_INTR     0x04
+
+// Must match DmaDescriptor in src/hwacc/noncoherent_dma.hh. The DMA is not
+// coherent, so descriptors must reach memory before a chain is started.
+typedef struct {
+    uint64_t src;
+    uint64_t dst;
+    uint64_t next;
+    uint32_t len;
+    uint32_t flags;
+    uint32_t rows;
+    uint32_t planes;
+    uint32_t srcRowStride;
+    uint32_t dstRowStride;
+    uint32_t srcPlaneStride;
+    uint32_t dstPlaneStride;
+    uint32_t elemSize;
+    uint32_t reserved;
+} __attribute__((aligned(64))) DMA_DESC;
+
+#define CH_HEAD(ch)      ((volatile uint64_t *)(MMR_ADDR+CH_OFFSET+(ch)*CH_SIZE))
+#define CH_COMPLETED(ch) ((volatile uint32_t *)(MMR_ADDR+CH_OFFSET+(ch)*CH_SIZE+8))
+#define CH_FLAGS(ch)     ((volatile uint32_t *)(MMR_ADDR+CH_OFFSET+(ch)*CH_SIZE+12))
+
+// Fill a 2D tile copy: rows of len bytes, strided on both sides
+void descTile(DMA_DESC * desc, void * dst, void * src, uint32_t len,
+              uint32_t rows, uint32_t srcStride, uint32_t dstStride) {
+    desc->src = (uint64_t)src;
+    desc->dst = (uint64_t)dst;
+    desc->next = 0;
+    desc->len = len;
+    desc->flags = 0;
+    desc->rows = rows;
+    desc->planes = 1;
+    desc->srcRowStride = srcStride;
+    desc->dstRowStride = dstStride;
+    desc->srcPlaneStride = 0;
+    desc->dstPlaneStride = 0;
+    desc->elemSize = 1;
+    desc->reserved = 0;
+}
+
+// Link descs[0..count) into a chain that interrupts once at the end
+void descChain(DMA_DESC * descs, int count) {
+    for (int i = 0; i < count; i++) {
+        descs[i].next = (i+1 < count) ? (uint64_t)&descs[i+1] : 0;
+        descs[i].flags = (i+1 < count) ? 0 : DESC_INT;
+    }
+}
+
+void dmaStartChain(int ch, DMA_DESC * head) {
+    *CH_HEAD(ch) = (uint64_t)head;
+    *CH_FLAGS(ch) |= CH_START;
+}
+
+int pollDmaChain(int ch) {
+    return ((*CH_FLAGS(ch)&CH_INTR)==CH_INTR);
+}
+
+void resetDmaChain(int ch) {
+    *CH_FLAGS(ch) = 0;
+}
+
+#endif //__DMA_DESC_H__
@@ -6,6 +6,18 @@ from pathlib import Path
 import yaml
 import os
 
+def applyParams(acc, params):
+    # SimObject parameter overrides from the hw_config params of an
+    # accelerator, keyed by their dotted path under the accelerator, e.g.
+    #   llvm_interface.sched_threshold: 500
+    #   hw_interface.functional_units.integer_adder.limit: 2
+    for path, value in params.items():
+        obj = acc
+        attrs = path.split('.')
+        for attr in attrs[:-1]:
+            obj = getattr(obj, attr)
+        setattr(obj, attrs[-1], value)
+
 def AccConfig(acc, bench_file, config_file):
     # Initialize LLVMInterface Objects
     acc.llvm_interface = LLVMInterface()
@@ -32,6 +44,7 @@ def AccConfig(acc, bench_file, config_file):
     # Define HW Counts
     acc.hw_interface.cycle_counts = CycleCounts()
     #acc.hw_interface.cycle_counts
+    acc_config = None
     
     if benchPath[m5PathLen+1] == 'mobilenetv2':
         fu_yaml = open(config_file, 'r')
@@ -40,6 +53,7 @@ def AccConfig(acc, bench_file, config_file):
             current_acc = document[0]['Name'] + '_' + benchname 
             if(benchPath[9] == document[0]['Name']):
                 print(current_acc + " Profile Loaded")
+                acc_config = yaml_inst_list['hw_config'][current_acc]
                 # print(yaml_inst_list['hw_config'][benchname])
                 inst_list = yaml_inst_list['hw_config'][current_acc]['instructions'].keys()
                 for instruction in inst_list:
@@ -49,7 +63,8 @@ def AccConfig(acc, bench_file, config_file):
     else:
         fu_yaml = open(config_file, 'r')
         yaml_inst_list = yaml.safe_load(fu_yaml)
-        if yaml_inst_list['hw_config'][benchname] is not None:
+        acc_config = yaml_inst_list['hw_config'][benchname]
+        if acc_config is not None:
             inst_list = yaml_inst_list['hw_config'][benchname]['instructions'].keys()
             for instruction in inst_list:
                 setattr(acc.hw_interface.cycle_counts, instruction, yaml_inst_list['hw_config'][benchname]['instructions'][instruction]['runtime_cycles'])
@@ -129,6 +144,9 @@ def AccConfig(acc, bench_file, config_file):
     acc.hw_interface.simulator_config = SimulatorConfig()
     acc.hw_interface.opcodes = InstOpCodes()
 
+    if acc_config is not None and acc_config.get('params'):
+        applyParams(acc, acc_config['params'])
+
 #def AccSPMConfig(acc, spm, config_file):
     # Setup config file parser
     #Config = ConfigParser.ConfigParser()
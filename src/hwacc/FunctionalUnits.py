@@ -49,13 +49,13 @@ class DoubleMultiplier(SimObject):
 	time_units = Param.String("ns", "Default values set from double_multiplier.yml")
 	area_units = Param.String("um^2", "Default values set from double_multiplier.yml")
 	fu_latency = Param.UInt32(5, "Default values set from double_multiplier.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from double_multiplier.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from double_multiplier.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from double_multiplier.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from double_multiplier.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from double_multiplier.yml")
-	area = Param.UInt32(5.981433, "Default values set from double_multiplier.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from double_multiplier.yml")
+	internal_power = Param.Float(0.009743773, "Default values set from double_multiplier.yml")
+	switch_power = Param.Float(0.007400587, "Default values set from double_multiplier.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from double_multiplier.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from double_multiplier.yml")
+	leakage_power = Param.Float(7.395312e-05, "Default values set from double_multiplier.yml")
+	area = Param.Float(5.981433, "Default values set from double_multiplier.yml")
+	path_delay = Param.Float(1.75, "Default values set from double_multiplier.yml")
 
 class BitRegister(SimObject):
 	# SimObject type
@@ -83,13 +83,13 @@ class BitRegister(SimObject):
 	time_units = Param.String("ns", "Default values set from bit_register.yml")
 	area_units = Param.String("um^2", "Default values set from bit_register.yml")
 	fu_latency = Param.UInt32(5, "Default values set from bit_register.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from bit_register.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from bit_register.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from bit_register.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from bit_register.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from bit_register.yml")
-	area = Param.UInt32(5.981433, "Default values set from bit_register.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from bit_register.yml")
+	internal_power = Param.Float(1.322600e-03, "Default values set from bit_register.yml")
+	switch_power = Param.Float(1.792126e-04, "Default values set from bit_register.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from bit_register.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from bit_register.yml")
+	leakage_power = Param.Float(7.395312e-05, "Default values set from bit_register.yml")
+	area = Param.Float(5.981433e+00, "Default values set from bit_register.yml")
+	path_delay = Param.Float(1.75, "Default values set from bit_register.yml")
 
 class BitwiseOperations(SimObject):
 	# SimObject type
@@ -117,13 +117,13 @@ class BitwiseOperations(SimObject):
 	time_units = Param.String("ns", "Default values set from bitwise_operations.yml")
 	area_units = Param.String("um^2", "Default values set from bitwise_operations.yml")
 	fu_latency = Param.UInt32(5, "Default values set from bitwise_operations.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from bitwise_operations.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from bitwise_operations.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from bitwise_operations.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from bitwise_operations.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from bitwise_operations.yml")
-	area = Param.UInt32(5.981433, "Default values set from bitwise_operations.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from bitwise_operations.yml")
+	internal_power = Param.Float(1.680942e-03, "Default values set from bitwise_operations.yml")
+	switch_power = Param.Float(1.322420e-03, "Default values set from bitwise_operations.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from bitwise_operations.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from bitwise_operations.yml")
+	leakage_power = Param.Float(6.111633e-04, "Default values set from bitwise_operations.yml")
+	area = Param.Float(5.036996e+01, "Default values set from bitwise_operations.yml")
+	path_delay = Param.Float(1.75, "Default values set from bitwise_operations.yml")
 
 class DoubleAdder(SimObject):
 	# SimObject type
@@ -151,13 +151,13 @@ class DoubleAdder(SimObject):
 	time_units = Param.String("ns", "Default values set from double_adder.yml")
 	area_units = Param.String("um^2", "Default values set from double_adder.yml")
 	fu_latency = Param.UInt32(5, "Default values set from double_adder.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from double_adder.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from double_adder.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from double_adder.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from double_adder.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from double_adder.yml")
-	area = Param.UInt32(5.981433, "Default values set from double_adder.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from double_adder.yml")
+	internal_power = Param.Float(0.009743773, "Default values set from double_adder.yml")
+	switch_power = Param.Float(0.007400587, "Default values set from double_adder.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from double_adder.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from double_adder.yml")
+	leakage_power = Param.Float(7.395312e-05, "Default values set from double_adder.yml")
+	area = Param.Float(5.981433, "Default values set from double_adder.yml")
+	path_delay = Param.Float(1.75, "Default values set from double_adder.yml")
 
 class FloatDivider(SimObject):
 	# SimObject type
@@ -185,13 +185,13 @@ class FloatDivider(SimObject):
 	time_units = Param.String("ns", "Default values set from float_divider.yml")
 	area_units = Param.String("um^2", "Default values set from float_divider.yml")
 	fu_latency = Param.UInt32(5, "Default values set from float_divider.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from float_divider.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from float_divider.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from float_divider.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from float_divider.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from float_divider.yml")
-	area = Param.UInt32(5.981433, "Default values set from float_divider.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from float_divider.yml")
+	internal_power = Param.Float(0.009743773, "Default values set from float_divider.yml")
+	switch_power = Param.Float(0.007400587, "Default values set from float_divider.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from float_divider.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from float_divider.yml")
+	leakage_power = Param.Float(7.395312e-05, "Default values set from float_divider.yml")
+	area = Param.Float(5.981433, "Default values set from float_divider.yml")
+	path_delay = Param.Float(1.75, "Default values set from float_divider.yml")
 
 class BitShifter(SimObject):
 	# SimObject type
@@ -219,13 +219,13 @@ class BitShifter(SimObject):
 	time_units = Param.String("ns", "Default values set from bit_shifter.yml")
 	area_units = Param.String("um^2", "Default values set from bit_shifter.yml")
 	fu_latency = Param.UInt32(5, "Default values set from bit_shifter.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from bit_shifter.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from bit_shifter.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from bit_shifter.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from bit_shifter.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from bit_shifter.yml")
-	area = Param.UInt32(5.981433, "Default values set from bit_shifter.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from bit_shifter.yml")
+	internal_power = Param.Float(1.680942e-03, "Default values set from bit_shifter.yml")
+	switch_power = Param.Float(1.322420e-03, "Default values set from bit_shifter.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from bit_shifter.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from bit_shifter.yml")
+	leakage_power = Param.Float(6.111633e-04, "Default values set from bit_shifter.yml")
+	area = Param.Float(5.036996e+01, "Default values set from bit_shifter.yml")
+	path_delay = Param.Float(1.75, "Default values set from bit_shifter.yml")
 
 class IntegerMultiplier(SimObject):
 	# SimObject type
@@ -253,13 +253,13 @@ class IntegerMultiplier(SimObject):
 	time_units = Param.String("ns", "Default values set from integer_multiplier.yml")
 	area_units = Param.String("um^2", "Default values set from integer_multiplier.yml")
 	fu_latency = Param.UInt32(5, "Default values set from integer_multiplier.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from integer_multiplier.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from integer_multiplier.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from integer_multiplier.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from integer_multiplier.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from integer_multiplier.yml")
-	area = Param.UInt32(5.981433, "Default values set from integer_multiplier.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from integer_multiplier.yml")
+	internal_power = Param.Float(5.725752e-01, "Default values set from integer_multiplier.yml")
+	switch_power = Param.Float(8.662890e-01, "Default values set from integer_multiplier.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from integer_multiplier.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from integer_multiplier.yml")
+	leakage_power = Param.Float(4.817683e-02, "Default values set from integer_multiplier.yml")
+	area = Param.Float(4.595000e+03, "Default values set from integer_multiplier.yml")
+	path_delay = Param.Float(1.75, "Default values set from integer_multiplier.yml")
 
 class IntegerAdder(SimObject):
 	# SimObject type
@@ -287,13 +287,13 @@ class IntegerAdder(SimObject):
 	time_units = Param.String("ns", "Default values set from integer_adder.yml")
 	area_units = Param.String("um^2", "Default values set from integer_adder.yml")
 	fu_latency = Param.UInt32(5, "Default values set from integer_adder.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from integer_adder.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from integer_adder.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from integer_adder.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from integer_adder.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from integer_adder.yml")
-	area = Param.UInt32(5.981433, "Default values set from integer_adder.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from integer_adder.yml")
+	internal_power = Param.Float(8.115300e-03, "Default values set from integer_adder.yml")
+	switch_power = Param.Float(6.162853e-03, "Default values set from integer_adder.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from integer_adder.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from integer_adder.yml")
+	leakage_power = Param.Float(2.380803e-03, "Default values set from integer_adder.yml")
+	area = Param.Float(1.794430e+02, "Default values set from integer_adder.yml")
+	path_delay = Param.Float(1.75, "Default values set from integer_adder.yml")
 
 class DoubleDivider(SimObject):
 	# SimObject type
@@ -321,13 +321,13 @@ class DoubleDivider(SimObject):
 	time_units = Param.String("ns", "Default values set from double_divider.yml")
 	area_units = Param.String("um^2", "Default values set from double_divider.yml")
 	fu_latency = Param.UInt32(5, "Default values set from double_divider.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from double_divider.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from double_divider.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from double_divider.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from double_divider.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from double_divider.yml")
-	area = Param.UInt32(5.981433, "Default values set from double_divider.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from double_divider.yml")
+	internal_power = Param.Float(0.009743773, "Default values set from double_divider.yml")
+	switch_power = Param.Float(0.007400587, "Default values set from double_divider.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from double_divider.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from double_divider.yml")
+	leakage_power = Param.Float(7.395312e-05, "Default values set from double_divider.yml")
+	area = Param.Float(5.981433, "Default values set from double_divider.yml")
+	path_delay = Param.Float(1.75, "Default values set from double_divider.yml")
 
 class FloatAdder(SimObject):
 	# SimObject type
@@ -355,13 +355,13 @@ class FloatAdder(SimObject):
 	time_units = Param.String("ns", "Default values set from float_adder.yml")
 	area_units = Param.String("um^2", "Default values set from float_adder.yml")
 	fu_latency = Param.UInt32(5, "Default values set from float_adder.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from float_adder.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from float_adder.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from float_adder.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from float_adder.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from float_adder.yml")
-	area = Param.UInt32(5.981433, "Default values set from float_adder.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from float_adder.yml")
+	internal_power = Param.Float(0.009743773, "Default values set from float_adder.yml")
+	switch_power = Param.Float(0.007400587, "Default values set from float_adder.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from float_adder.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from float_adder.yml")
+	leakage_power = Param.Float(7.395312e-05, "Default values set from float_adder.yml")
+	area = Param.Float(5.981433, "Default values set from float_adder.yml")
+	path_delay = Param.Float(1.75, "Default values set from float_adder.yml")
 
 class FloatMultiplier(SimObject):
 	# SimObject type
@@ -389,11 +389,11 @@ class FloatMultiplier(SimObject):
 	time_units = Param.String("ns", "Default values set from float_multiplier.yml")
 	area_units = Param.String("um^2", "Default values set from float_multiplier.yml")
 	fu_latency = Param.UInt32(5, "Default values set from float_multiplier.yml")
-	internal_power = Param.UInt32(0.009743773, "Default values set from float_multiplier.yml")
-	switch_power = Param.UInt32(0.007400587, "Default values set from float_multiplier.yml")
-	dynamic_power = Param.UInt32(0.001800732, "Default values set from float_multiplier.yml")
-	dynamic_energy = Param.UInt32(0.009003937, "Default values set from float_multiplier.yml")
-	leakage_power = Param.UInt32(7.395312e-05, "Default values set from float_multiplier.yml")
-	area = Param.UInt32(5.981433, "Default values set from float_multiplier.yml")
-	path_delay = Param.UInt32(1.75, "Default values set from float_multiplier.yml")
+	internal_power = Param.Float(0.009743773, "Default values set from float_multiplier.yml")
+	switch_power = Param.Float(0.007400587, "Default values set from float_multiplier.yml")
+	dynamic_power = Param.Float(0.001800732, "Default values set from float_multiplier.yml")
+	dynamic_energy = Param.Float(0.009003937, "Default values set from float_multiplier.yml")
+	leakage_power = Param.Float(7.395312e-05, "Default values set from float_multiplier.yml")
+	area = Param.Float(5.981433, "Default values set from float_multiplier.yml")
+	path_delay = Param.Float(1.75, "Default values set from float_multiplier.yml")
 
@@ -21,4 +21,5 @@ class HWInterface(SimObject):
     salam_power_model = Param.SALAMPowerModel(Parent.any, "SALAM Power Model")
     simulator_config = Param.SimulatorConfig(Parent.any, "Simulation Configuration")
     opcodes = Param.InstOpCodes(Parent.any, "Instruction LLVM OpCode Enumeration to SALAM Type")
+    issue_width = Param.UInt32(0, "Operations issued to functional units per cycle across all unit types, 0 = unlimited")
     
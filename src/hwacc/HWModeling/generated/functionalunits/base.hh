@@ -3,6 +3,7 @@
 
 #include "../../src/salam_power_model.hh"
 
+#include <algorithm>
 #include <map>
 #include <iostream>
 #include <cstdlib>
@@ -39,10 +40,27 @@ class FunctionalUnitBase
 		double _area;
 		double _path_delay;
 
-		uint64_t _available;
+		uint64_t _available = 0;
 
 		uint64_t _in_use = 0;
 
+		// Reservation model. Units are held for their occupancy and handed
+		// back through a ring of per-cycle release counts
+		uint64_t _cycle = 0;
+		std::vector<uint32_t> _release_ring = std::vector<uint32_t>(16, 0);
+		uint64_t _issued = 0;
+		uint64_t _stalls = 0;
+		uint64_t _peak_in_use = 0;
+
+		void grow_release_ring(uint64_t cycles) {
+			size_t size = _release_ring.size();
+			while (size <= cycles) size <<= 1;
+			std::vector<uint32_t> ring(size, 0);
+			for (uint64_t i = 1; i < _release_ring.size(); i++)
+				ring[(_cycle + i) & (size - 1)] = _release_ring[(_cycle + i) & (_release_ring.size() - 1)];
+			_release_ring.swap(ring);
+		}
+
 	public:
 		FunctionalUnitBase();
 		FunctionalUnitBase( std::string alias,
@@ -124,12 +142,49 @@ class FunctionalUnitBase
 		double get_leakage_power() { return _leakage_power; }
 		double get_area() { return _area; }
 		double get_path_delay() { return _path_delay; }
-		bool is_available() { return (_in_use >= _available); }
-		void use_functional_unit() { _in_use++; }
-		void clear_functional_unit() { _in_use--; }
+		// A non-zero limit fixes the number of units, otherwise there is one
+		// unit per static instruction mapped to this type
+		uint64_t get_functional_unit_limit() { return _limit ? _limit : _available; }
 		void set_functional_unit_limit(uint64_t available) { _available = available; }
 		void inc_functional_unit_limit() { _available++; }
-		uint64_t get_functional_unit_limit() { return _available; }
+		bool is_available() { return (_in_use < get_functional_unit_limit()); }
+		// Pipelined units accept a new operation every ceil(latency/stages)
+		// cycles, other units are held until the operation completes
+		bool is_pipelined() { return (_stages > 1); }
+		uint64_t get_occupancy(uint64_t latency) {
+			if (is_pipelined()) return std::max<uint64_t>(1, (latency + _stages - 1) / _stages);
+			return std::max<uint64_t>(1, latency);
+		}
+		void use_functional_unit(uint64_t latency) {
+			uint64_t occupancy = get_occupancy(latency);
+			if (occupancy >= _release_ring.size()) grow_release_ring(occupancy);
+			_release_ring[(_cycle + occupancy) & (_release_ring.size() - 1)]++;
+			_in_use++;
+			_issued++;
+			_peak_in_use = std::max(_peak_in_use, _in_use);
+		}
+		void stall_functional_unit() { _stalls++; }
+		// Release every unit whose occupancy ended by the given cycle
+		void advance(uint64_t cycle) {
+			if (cycle <= _cycle) return;
+			uint64_t steps = std::min<uint64_t>(cycle - _cycle, _release_ring.size());
+			for (uint64_t i = 1; i <= steps; i++) {
+				uint32_t &released = _release_ring[(_cycle + i) & (_release_ring.size() - 1)];
+				_in_use -= released;
+				released = 0;
+			}
+			_cycle = cycle;
+		}
+		// Next cycle a reserved unit is released, 0 if none are reserved
+		uint64_t next_release() {
+			if (_in_use == 0) return 0;
+			for (uint64_t i = 1; i < _release_ring.size(); i++)
+				if (_release_ring[(_cycle + i) & (_release_ring.size() - 1)]) return _cycle + i;
+			return 0;
+		}
+		uint64_t get_issued() { return _issued; }
+		uint64_t get_stalls() { return _stalls; }
+		uint64_t get_peak_in_use() { return _peak_in_use; }
 
 };
 #endif // __HWMODEL_FUNCTIONAL_UNIT_BASE_HH__
\ No newline at end of file
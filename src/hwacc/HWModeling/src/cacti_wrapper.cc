@@ -1,124 +1,145 @@
-#include "cacti_wrapper.hh"
-
-uca_org_t cactiWrapper(unsigned num_of_bytes, unsigned wordsize, unsigned num_ports, int cache_type) {
-  int cache_size = num_of_bytes;
-  int line_size = wordsize;  // in bytes
-  if (wordsize < 4)          // minimum line size in cacti is 32-bit/4-byte
-    line_size = 4;
-  if (cache_size / line_size < 64)
-    cache_size = line_size * 64;  // minimum scratchpad size: 64 words
-  int associativity = 1;
-  int rw_ports = num_ports;
-  if (rw_ports == 0)
-    rw_ports = 1;
-  int excl_read_ports = 0;
-  int excl_write_ports = 0;
-  int single_ended_read_ports = 0;
-  int search_ports = 0;
-  int banks = 1;
-  double tech_node = 40;  // in nm
-  //# following three parameters are meaningful only for main memories
-  int page_sz = 0;
-  int burst_length = 8;
-  int pre_width = 8;
-  int output_width = wordsize * 8;
-  //# to model special structure like branch target buffers, directory, etc.
-  //# change the tag size parameter
-  //# if you want cacti to calculate the tagbits, set the tag size to "default"
-  int specific_tag = false;
-  int tag_width = 0;
-  int access_mode = 2;  // 0 normal, 1 seq, 2 fast
-  int cache = cache_type;   // scratch ram 0 or cache 1
-  int main_mem = 0;
-  // assign weights for CACTI optimizations
-  int obj_func_delay = 0;
-  int obj_func_dynamic_power = 0;
-  int obj_func_leakage_power = 100;
-  int obj_func_area = 0;
-  int obj_func_cycle_time = 0;
-  // from CACTI example config...
-  int dev_func_delay = 20;
-  int dev_func_dynamic_power = 100000;
-  int dev_func_leakage_power = 100000;
-  int dev_func_area = 1000000;
-  int dev_func_cycle_time = 1000000;
-
-  int ed_ed2_none = 2;  // 0 - ED, 1 - ED^2, 2 - use weight and deviate
-  int temp = 300;
-  int wt = 0;  // 0 - default(search across everything), 1 - global, 2 - 5%
-               // delay penalty, 3 - 10%, 4 - 20 %, 5 - 30%, 6 - low-swing
-  int data_arr_ram_cell_tech_flavor_in =
-      0;  // 0(itrs-hp) 1-itrs-lstp(low standby power)
-  int data_arr_peri_global_tech_flavor_in = 0;  // 0(itrs-hp)
-  int tag_arr_ram_cell_tech_flavor_in = 0;      // itrs-hp
-  int tag_arr_peri_global_tech_flavor_in = 0;   // itrs-hp
-  int interconnect_projection_type_in = 1;      // 0 - aggressive, 1 - normal
-  int wire_inside_mat_type_in = 1;   // 2 - global, 0 - local, 1 - semi-global
-  int wire_outside_mat_type_in = 1;  // 2 - global
-  int REPEATERS_IN_HTREE_SEGMENTS_in =
-      1;  // TODO for now only wires with repeaters are supported
-  int VERTICAL_HTREE_WIRES_OVER_THE_ARRAY_in = 0;
-  int BROADCAST_ADDR_DATAIN_OVER_VERTICAL_HTREES_in = 0;
-  int force_wiretype = 1;
-  int wiretype = 30;
-  int force_config = 0;
-  int ndwl = 1;
-  int ndbl = 1;
-  int nspd = 0;
-  int ndcm = 1;
-  int ndsam1 = 0;
-  int ndsam2 = 0;
-  int ecc = 0;
-  return cacti_interface(cache_size,
-                         line_size,
-                         associativity,
-                         rw_ports,
-                         excl_read_ports,
-                         excl_write_ports,
-                         single_ended_read_ports,
-                         search_ports,
-                         banks,
-                         tech_node,  // in nm
-                         output_width,
-                         specific_tag,
-                         tag_width,
-                         access_mode,  // 0 normal, 1 seq, 2 fast
-                         cache,        // scratch ram or cache
-                         main_mem,
-                         obj_func_delay,
-                         obj_func_dynamic_power,
-                         obj_func_leakage_power,
-                         obj_func_cycle_time,
-                         obj_func_area,
-                         dev_func_delay,
-                         dev_func_dynamic_power,
-                         dev_func_leakage_power,
-                         dev_func_area,
-                         dev_func_cycle_time,
-                         ed_ed2_none,
-                         temp,
-                         wt,
-                         data_arr_ram_cell_tech_flavor_in,
-                         data_arr_peri_global_tech_flavor_in,
-                         tag_arr_ram_cell_tech_flavor_in,
-                         tag_arr_peri_global_tech_flavor_in,
-                         interconnect_projection_type_in,
-                         wire_inside_mat_type_in,
-                         wire_outside_mat_type_in,
-                         REPEATERS_IN_HTREE_SEGMENTS_in,
-                         VERTICAL_HTREE_WIRES_OVER_THE_ARRAY_in,
-                         BROADCAST_ADDR_DATAIN_OVER_VERTICAL_HTREES_in,
-                         page_sz,
-                         burst_length,
-                         pre_width,
-                         force_wiretype,
-                         wiretype,
-                         force_config,
-                         ndwl,
-                         ndbl,
-                         nspd,
-                         ndcm,
-                         ndsam1,
-                         ndsam2,
-                         ecc);
-}
\ No newline at end of file
+#include "cacti_wrapper.hh"
+
+#include "base/logging.hh"
+#include "mcpat/cacti/cacti_interface.h"
+#include "mcpat/cacti/parameter.h"
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+CactiResult cactiWrapper(const CactiConfig &config) {
+  int cache_size = config.size;
+  int line_size = config.wordSize;  // in bytes
+  if (line_size < 4)          // minimum line size in cacti is 32-bit/4-byte
+    line_size = 4;
+  if (cache_size / line_size < 64)
+    cache_size = line_size * 64;  // minimum scratchpad size: 64 words
+  int rw_ports = config.ports;
+  if (rw_ports == 0)
+    rw_ports = 1;
+
+  // Same configuration the cacti-SALAM scripts use. The plain interface
+  // does not print a report or write out.csv to the working directory
+  InputParameter *ip = new InputParameter();
+  ip->cache_sz = cache_size;
+  ip->line_sz = line_size;
+  ip->assoc = 1;
+  ip->nbanks = 1;
+  ip->out_w = line_size * 8;
+  ip->specific_tag = false;
+  ip->tag_w = 42;
+  ip->access_mode = 2;  // 0 normal, 1 seq, 2 fast
+  ip->F_sz_nm = 40;     // technology node
+  ip->F_sz_um = ip->F_sz_nm / 1000;
+  ip->is_main_mem = false;
+  ip->is_cache = (config.type == 1);
+  ip->pure_ram = (config.type == 0);
+  ip->pure_cam = (config.type == 2);
+  ip->num_rw_ports = rw_ports;
+  ip->num_rd_ports = 0;
+  ip->num_wr_ports = 0;
+  ip->num_se_rd_ports = 0;
+  ip->num_search_ports = 0;
+  // Page size, burst length and prefetch width only matter for main memories
+  ip->page_sz_bits = 0;
+  ip->burst_len = 8;
+  ip->int_prefetch_w = 8;
+  // Optimize for leakage power, with the deviations of the CACTI examples
+  ip->delay_wt = 0;
+  ip->dynamic_power_wt = 0;
+  ip->leakage_power_wt = 100;
+  ip->area_wt = 0;
+  ip->cycle_time_wt = 0;
+  ip->delay_dev = 20;
+  ip->dynamic_power_dev = 100000;
+  ip->leakage_power_dev = 100000;
+  ip->area_dev = 1000000;
+  ip->cycle_time_dev = 1000000;
+  ip->ed = 2;  // 0 - ED, 1 - ED^2, 2 - use weight and deviate
+  ip->temp = 300;
+  ip->data_arr_ram_cell_tech_type = 0;  // itrs-hp
+  ip->data_arr_peri_global_tech_type = 0;
+  ip->tag_arr_ram_cell_tech_type = 0;
+  ip->tag_arr_peri_global_tech_type = 0;
+  ip->ic_proj_type = 1;      // 0 - aggressive, 1 - normal
+  ip->wire_is_mat_type = 1;  // 2 - global, 0 - local, 1 - semi-global
+  ip->wire_os_mat_type = 1;
+  ip->rpters_in_htree = true;
+  ip->ver_htree_wires_over_array = 0;
+  ip->broadcast_addr_din_over_ver_htrees = 0;
+  ip->force_wiretype = true;
+  ip->wt = Global_30;
+  ip->force_cache_config = false;
+  ip->nuca = 0;
+  ip->add_ecc_b_ = false;
+  ip->print_detail = 0;
+
+  uca_org_t result = cacti_interface(ip);
+  fatal_if(!result.valid, "CACTI found no solution for %d bytes with %d byte "
+           "words and %d ports\n", cache_size, line_size, rw_ports);
+  CactiResult estimate;
+  estimate.area = result.area;
+  estimate.readEnergy = result.power.readOp.dynamic;
+  estimate.writeEnergy = result.power.writeOp.dynamic;
+  estimate.leakagePower = result.power.readOp.leakage + result.power.readOp.gate_leakage;
+  estimate.accessTime = result.access_time;
+  result.cleanup();
+  delete ip;
+  g_ip = nullptr;
+  return estimate;
+}
+
+namespace
+{
+
+std::map<CactiConfig, CactiResult> memo;
+std::set<std::string> loadedFiles;
+
+// One line per estimate:
+// size word_size ports type area read_energy write_energy leakage access_time
+void
+loadMemo(const std::string &memo_file) {
+  if (!loadedFiles.insert(memo_file).second) return;
+  std::ifstream in(memo_file);
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    CactiConfig config;
+    CactiResult result;
+    if (fields >> config.size >> config.wordSize >> config.ports >> config.type
+               >> result.area >> result.readEnergy >> result.writeEnergy
+               >> result.leakagePower >> result.accessTime)
+      memo.emplace(config, result);
+    else
+      warn("Ignoring malformed CACTI memo entry in %s: %s\n", memo_file, line);
+  }
+}
+
+} // anonymous namespace
+
+CactiResult cactiEstimate(const CactiConfig &config, const std::string &memo_file) {
+  if (!memo_file.empty()) loadMemo(memo_file);
+  auto it = memo.find(config);
+  if (it != memo.end()) return it->second;
+
+  inform("Running CACTI for %d bytes with %d byte words and %d ports\n",
+         config.size, config.wordSize, config.ports);
+  CactiResult result = cactiWrapper(config);
+  memo.emplace(config, result);
+  if (!memo_file.empty()) {
+    // A single append per entry, so runs sharing the file do not interleave
+    std::ostringstream entry;
+    entry.precision(17);
+    entry << config.size << " " << config.wordSize << " " << config.ports << " "
+          << config.type << " " << result.area << " " << result.readEnergy << " "
+          << result.writeEnergy << " " << result.leakagePower << " "
+          << result.accessTime << "\n";
+    std::ofstream out(memo_file, std::ios::app);
+    warn_if(!(out << entry.str() << std::flush),
+            "Could not add CACTI result to %s\n", memo_file);
+  }
+  return result;
+}
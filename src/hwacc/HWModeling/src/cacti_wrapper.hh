@@ -1,9 +1,40 @@
 #ifndef __HWMODEL_CACTI_WRAPPER_HH__
 #define __HWMODEL_CACTI_WRAPPER_HH__
 
-#include "../../../../ext/mcpat/cacti/cacti_interface.h"
+#include <cstdint>
+#include <string>
 
+// Shape of an SRAM array modeled by CACTI
+struct CactiConfig {
+    uint64_t size;
+    uint32_t wordSize;
+    uint32_t ports;
+    int type; // 0 scratch RAM, 1 cache
 
-uca_org_t cactiWrapper(unsigned num_of_bytes, unsigned wordsize, unsigned num_ports, int cache_type);
+    bool operator<(const CactiConfig &other) const {
+        if (size != other.size) return size < other.size;
+        if (wordSize != other.wordSize) return wordSize < other.wordSize;
+        if (ports != other.ports) return ports < other.ports;
+        return type < other.type;
+    }
+};
 
-#endif //__HWMODEL_CACTI_WRAPPER_HH__
\ No newline at end of file
+// CACTI estimate of one array in SI units, except area which is in um^2.
+// Energies are per access of one word
+struct CactiResult {
+    double area;
+    double readEnergy;
+    double writeEnergy;
+    double leakagePower;
+    double accessTime;
+};
+
+// Runs CACTI for one array, which takes seconds
+CactiResult cactiWrapper(const CactiConfig &config);
+
+// Memoized cactiWrapper. Results are kept for the whole simulation, and if
+// memo_file is not empty they are also loaded from and appended to that
+// file, so runs that share it only solve each shape once
+CactiResult cactiEstimate(const CactiConfig &config, const std::string &memo_file);
+
+#endif //__HWMODEL_CACTI_WRAPPER_HH__
@@ -0,0 +1,131 @@
+#include "cycle_trace.hh"
+
+#include "base/logging.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+void
+writeU32(std::ofstream &out, uint32_t value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+} // anonymous namespace
+
+CycleTrace::CycleTrace(const std::string &path,
+                       const std::vector<std::string> &columns,
+                       uint32_t chunk_rows, bool _compress) :
+    out(path, std::ios::binary | std::ios::trunc),
+    numColumns(columns.size()),
+    chunkRows(std::max<uint32_t>(chunk_rows, 1)),
+    compress(_compress),
+    front(numColumns * chunkRows),
+    back(numColumns * chunkRows)
+{
+    fatal_if(!out, "Could not open cycle trace %s\n", path);
+    fatal_if(numColumns == 0, "Cycle trace %s has no columns\n", path);
+
+    out.write("SALAMCT", 8);
+    writeU32(out, Version);
+    writeU32(out, compress ? FlagCompressed : 0);
+    writeU32(out, chunkRows);
+    writeU32(out, numColumns);
+    for (auto &column : columns) {
+        writeU32(out, column.size());
+        out.write(column.data(), column.size());
+    }
+    writer = std::thread(&CycleTrace::run, this);
+}
+
+CycleTrace::~CycleTrace()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closing = true;
+    }
+    cv.notify_all();
+    writer.join();
+}
+
+void
+CycleTrace::waitIdle(std::unique_lock<std::mutex> &guard)
+{
+    cv.wait(guard, [this] { return !backFull; });
+    fatal_if(failed, "Failed to write cycle trace\n");
+}
+
+void
+CycleTrace::swap()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    // Double buffering: only wait if the writer still owns the other chunk
+    waitIdle(guard);
+    front.swap(back);
+    backRows = frontRows;
+    frontRows = 0;
+    backFull = true;
+    guard.unlock();
+    cv.notify_all();
+}
+
+void
+CycleTrace::flush()
+{
+    if (frontRows) swap();
+    std::unique_lock<std::mutex> guard(lock);
+    waitIdle(guard);
+    out.flush();
+}
+
+void
+CycleTrace::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        cv.wait(guard, [this] { return backFull || closing; });
+        if (!backFull) return;
+        // The simulation does not touch the back chunk until it is released
+        guard.unlock();
+        writeChunk();
+        guard.lock();
+        backFull = false;
+        cv.notify_all();
+    }
+}
+
+void
+CycleTrace::writeChunk()
+{
+    // Close the gaps left by a partial chunk so the columns are contiguous
+    size_t bytes = backRows * sizeof(int32_t);
+    if (backRows < chunkRows) {
+        for (size_t col = 1; col < numColumns; col++)
+            std::memmove(&back[col * backRows], &back[col * chunkRows], bytes);
+    }
+    bytes *= numColumns;
+
+    const char *data = reinterpret_cast<const char *>(back.data());
+    if (compress) {
+        uLongf stored = compressBound(bytes);
+        packed.resize(stored);
+        if (compress2(packed.data(), &stored,
+                      reinterpret_cast<const Bytef *>(data), bytes,
+                      Z_BEST_SPEED) != Z_OK) {
+            failed = true;
+            return;
+        }
+        data = reinterpret_cast<const char *>(packed.data());
+        bytes = stored;
+    }
+    writeU32(out, backRows);
+    writeU32(out, bytes);
+    out.write(data, bytes);
+    if (!out) failed = true;
+}
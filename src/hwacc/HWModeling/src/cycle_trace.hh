@@ -0,0 +1,77 @@
+#ifndef __HWMODEL_CYCLE_TRACE_HH__
+#define __HWMODEL_CYCLE_TRACE_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Streams fixed-size per-cycle records to a binary file. Every record holds
+ * one int32 value per column, and records are gathered into chunks stored
+ * column by column so a reader can load each column as one array. A full
+ * chunk is swapped with the idle one and written, optionally deflated with
+ * zlib, by a writer thread, so the simulation only stalls when the writer
+ * falls a whole chunk behind.
+ *
+ * File layout, all integers in host byte order (little-endian):
+ *   header: "SALAMCT\0", u32 version, u32 flags, u32 chunk rows,
+ *           u32 columns, then per column u32 name length and the name
+ *   chunk:  u32 rows, u32 stored bytes, then the stored bytes, which are
+ *           rows int32 values of each column in turn, deflated if flags
+ *           has FlagCompressed set
+ */
+class CycleTrace
+{
+  public:
+    static constexpr uint32_t Version = 1;
+    static constexpr uint32_t FlagCompressed = 0x1;
+
+    CycleTrace(const std::string &path, const std::vector<std::string> &columns,
+               uint32_t chunk_rows, bool compress);
+    ~CycleTrace();
+
+    size_t columns() const { return numColumns; }
+
+    /** Append one record of columns() values */
+    void
+    append(const int32_t *values)
+    {
+        for (size_t col = 0; col < numColumns; col++)
+            front[col * chunkRows + frontRows] = values[col];
+        if (++frontRows == chunkRows) swap();
+    }
+
+    /** Hand the partial chunk to the writer and wait until it is written */
+    void flush();
+
+  private:
+    std::ofstream out;
+    const size_t numColumns;
+    const uint32_t chunkRows;
+    const bool compress;
+
+    // Chunks are column-major with chunkRows slots per column
+    std::vector<int32_t> front;
+    uint32_t frontRows = 0;
+    std::vector<int32_t> back;
+    uint32_t backRows = 0;
+    std::vector<uint8_t> packed;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    bool backFull = false;
+    bool closing = false;
+    bool failed = false;
+    std::thread writer;
+
+    void swap();
+    void waitIdle(std::unique_lock<std::mutex> &guard);
+    void run();
+    void writeChunk();
+};
+
+#endif //__HWMODEL_CYCLE_TRACE_HH__
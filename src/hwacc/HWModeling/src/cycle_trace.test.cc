@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <zlib.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "hwacc/HWModeling/src/cycle_trace.hh"
+
+/*
+ * Writes cycle traces and reads them back the way Scripts/readCycleTrace.py
+ * does.
+ */
+
+namespace
+{
+
+struct Trace
+{
+    uint32_t flags = 0;
+    uint32_t chunkRows = 0;
+    std::vector<std::string> names;
+    std::vector<std::vector<int32_t>> columns;
+};
+
+uint32_t
+readU32(std::ifstream &in)
+{
+    uint32_t value = 0;
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+}
+
+Trace
+load(const std::string &path)
+{
+    Trace trace;
+    std::ifstream in(path, std::ios::binary);
+    char magic[8];
+    in.read(magic, 8);
+    EXPECT_EQ(std::string(magic), "SALAMCT");
+    EXPECT_EQ(readU32(in), CycleTrace::Version);
+    trace.flags = readU32(in);
+    trace.chunkRows = readU32(in);
+    uint32_t columns = readU32(in);
+    for (uint32_t col = 0; col < columns; col++) {
+        std::string name(readU32(in), '\0');
+        in.read(&name[0], name.size());
+        trace.names.push_back(name);
+    }
+    trace.columns.resize(columns);
+
+    while (true) {
+        uint32_t rows = readU32(in);
+        if (!in) break;
+        std::vector<char> stored(readU32(in));
+        in.read(stored.data(), stored.size());
+        std::vector<int32_t> chunk(rows * columns);
+        uLongf bytes = chunk.size() * sizeof(int32_t);
+        if (trace.flags & CycleTrace::FlagCompressed) {
+            EXPECT_EQ(uncompress(reinterpret_cast<Bytef *>(chunk.data()), &bytes,
+                                 reinterpret_cast<const Bytef *>(stored.data()),
+                                 stored.size()), Z_OK);
+        } else {
+            EXPECT_EQ(stored.size(), bytes);
+            std::copy(stored.begin(), stored.end(),
+                      reinterpret_cast<char *>(chunk.data()));
+        }
+        for (uint32_t col = 0; col < columns; col++) {
+            trace.columns[col].insert(trace.columns[col].end(),
+                                      chunk.begin() + col * rows,
+                                      chunk.begin() + (col + 1) * rows);
+        }
+    }
+    return trace;
+}
+
+int32_t
+value(size_t row, size_t col)
+{
+    return (col == 0) ? row : (row * 7 + col * 13) % (col + 3);
+}
+
+void
+roundTrip(bool compress, uint32_t chunk_rows, size_t rows)
+{
+    std::string path = ::testing::TempDir() + "cycle_trace.bin";
+    std::vector<std::string> names = {"cycle", "loadActive", "fu.integer_adder"};
+    {
+        CycleTrace trace(path, names, chunk_rows, compress);
+        std::vector<int32_t> record(names.size());
+        for (size_t row = 0; row < rows; row++) {
+            for (size_t col = 0; col < names.size(); col++)
+                record[col] = value(row, col);
+            trace.append(record.data());
+            // Flushing mid-run leaves a short chunk behind
+            if (row == rows / 3) trace.flush();
+        }
+    }
+    Trace trace = load(path);
+    std::remove(path.c_str());
+    EXPECT_EQ(trace.flags, compress ? CycleTrace::FlagCompressed : 0u);
+    EXPECT_EQ(trace.chunkRows, chunk_rows);
+    ASSERT_EQ(trace.names, names);
+    for (size_t col = 0; col < names.size(); col++) {
+        ASSERT_EQ(trace.columns[col].size(), rows);
+        for (size_t row = 0; row < rows; row++)
+            ASSERT_EQ(trace.columns[col][row], value(row, col)) << row << " " << col;
+    }
+}
+
+} // anonymous namespace
+
+TEST(CycleTrace, RoundTrip)
+{
+    roundTrip(false, 64, 1000);
+    roundTrip(true, 64, 1000);
+    roundTrip(true, 1000, 1000);
+    roundTrip(false, 4096, 10);
+}
@@ -8,149 +8,63 @@ HWInterface::HWInterface(const HWInterfaceParams &params) :
     inst_config(params.inst_config),
     opcodes(params.opcodes),
     salam_power_model(params.salam_power_model),
-    simulator_config(params.simulator_config) { }
+    simulator_config(params.simulator_config),
+    issue_width(params.issue_width) {
+        // Index the functional units by their enum value for O(1) lookups
+        for (auto fu : functional_units->functional_unit_list) {
+            uint32_t enum_value = fu->get_enum_value();
+            if (enum_value >= fu_table.size()) fu_table.resize(enum_value + 1, nullptr);
+            fu_table[enum_value] = fu;
+        }
+    }
+
+bool
+HWInterface::availableIssuePort(uint64_t functional_unit) {
+    // Only operations on a modeled unit take one of the issue ports
+    if (!issue_width || !getFunctionalUnit(functional_unit)) return true;
+    return issued < issue_width;
+}
 
-bool 
+bool
 HWInterface::availableFunctionalUnit(uint64_t functional_unit) {
-    //std::cout << "\n\n\nTest 1 - " <<  functional_unit << "\n\n\n";
-    switch(functional_unit) {
-        case INTADDER : {
-            if (functional_units->_integer_adder->is_available()) {
-                functional_units->_integer_adder->use_functional_unit();
-                return true;
-            } break;
-        }
-        case INTMULTI : {
-            if (functional_units->_integer_multiplier->is_available()) {
-                functional_units->_integer_multiplier->use_functional_unit();
-                return true;
-            } break;
-        }
-        case INTSHIFTER : {
-            if (functional_units->_bit_shifter->is_available()) {
-                functional_units->_bit_shifter->use_functional_unit();
-                return true;
-            } break;
-        } 
-        case INTBITWISE : {
-            //std::cout << "\n\n\nTest 1 - 1 -";
-            //std::cout << functional_units->_bitwise_operations->get_alias() << "\n\n\n";
-            if (functional_units->_bitwise_operations->is_available()) {
-                //std::cout << "\n\n\nTest 1 - 2\n\n\n";
-                functional_units->_bitwise_operations->use_functional_unit();
-                //std::cout << "\n\n\nTest 1 - 3\n\n\n";
-                return true;
-            } break;
-        }
-        case FPSPADDER : {
-            if (functional_units->_float_adder->is_available()) {
-                functional_units->_float_adder->use_functional_unit();
-                return true;
-            } break;
-        }
-        case FPDPADDER : {
-            if (functional_units->_double_adder->is_available()) {
-                functional_units->_double_adder->use_functional_unit();
-                return true;
-            } break;
-        }
-        case FPSPMULTI : {
-            if (functional_units->_float_multiplier->is_available()) {
-                functional_units->_float_multiplier->use_functional_unit();
-                return true;
-            } break;
-        }
-        case FPSPDIVID : {
-            if (functional_units->_float_divider->is_available()) {
-                functional_units->_float_divider->use_functional_unit();
-                return true;
-            } break;
-        }
-        case FPDPMULTI : {
-            if (functional_units->_double_multiplier->is_available()) {
-                functional_units->_double_multiplier->use_functional_unit();
-                return true;
-            } break;
-        }
-        case FPDPDIVID : {
-            if (functional_units->_double_divider->is_available()) {
-                functional_units->_double_divider->use_functional_unit();
-                return true;
-            } break;
-        }
-        case COMPARE : { break; }
-        case GETELEMENTPTR : { break; }
-        case CONVERSION : { break; }
-        case OTHERINST : { break; }
-        case REGISTER : {
-            if (functional_units->_bit_register->is_available()) {
-                functional_units->_bit_register->use_functional_unit();
-                return true;
-            } break;
-        }
-        case COUNTER : { break; }
-        default: { 
-            // assert() 
-            return false;
-        }
+    // Types without a modeled unit (compare, GEP, conversion, ...) never stall
+    FunctionalUnitBase * fu = getFunctionalUnit(functional_unit);
+    return (fu == nullptr) || fu->is_available();
+}
+
+void
+HWInterface::useFunctionalUnit(uint64_t functional_unit, uint64_t latency) {
+    FunctionalUnitBase * fu = getFunctionalUnit(functional_unit);
+    if (fu) {
+        issued++;
+        fu->use_functional_unit(latency);
+        salam_power_model->useFunctionalUnit(functional_unit, fu->get_occupancy(latency));
     }
-    return false;
 }
 
 void
-HWInterface::clearFunctionalUnit(uint64_t unit) {
-    switch(unit) {
-        case INTADDER : { 
-                functional_units->_integer_adder->clear_functional_unit();
-                break;
-            } 
-        case INTMULTI : { 
-                functional_units->_integer_multiplier->clear_functional_unit();
-                break;
-            }
-        case INTSHIFTER : { 
-                functional_units->_bit_shifter->clear_functional_unit();
-                break;
-            }
-        case INTBITWISE : { 
-                functional_units->_bitwise_operations->clear_functional_unit();
-                break;
-            }
-        case FPSPADDER : { 
-                functional_units->_float_adder->clear_functional_unit();
-                break;
-            }
-        case FPDPADDER : { 
-                functional_units->_double_adder->clear_functional_unit();
-                break;
-            }
-        case FPSPMULTI : { 
-                functional_units->_float_multiplier->clear_functional_unit();
-                break;
-            }
-        case FPSPDIVID : { 
-                functional_units->_float_divider->clear_functional_unit();
-                break;
-            }
-        case FPDPMULTI : { 
-                functional_units->_double_multiplier->clear_functional_unit();
-                break;
-            }
-        case FPDPDIVID : { 
-                functional_units->_double_divider->clear_functional_unit();
-                break;
-            }
-        case COMPARE : { break; }
-        case GETELEMENTPTR : { break; }
-        case CONVERSION : { break; }
-        case OTHERINST : { break; }
-        case REGISTER : { 
-                functional_units->_bit_register->clear_functional_unit();
-                break;
-            }
-        case COUNTER : { break; }
-        default: { 
-            // assert() 
-        }
+HWInterface::stallFunctionalUnit(uint64_t functional_unit) {
+    FunctionalUnitBase * fu = getFunctionalUnit(functional_unit);
+    if (fu) fu->stall_functional_unit();
+}
+
+void
+HWInterface::advanceFunctionalUnits(uint64_t cycle) {
+    for (auto fu : functional_units->functional_unit_list) fu->advance(cycle);
+    if (cycle > issue_cycle) {
+        issued = 0;
+        issue_stalled = false;
+        issue_cycle = cycle;
+    }
+}
+
+uint64_t
+HWInterface::nextFunctionalUnitRelease() {
+    // Issue ports are refilled on the next cycle
+    uint64_t next = issue_stalled ? issue_cycle + 1 : 0;
+    for (auto fu : functional_units->functional_unit_list) {
+        uint64_t release = fu->next_release();
+        if (release && (!next || (release < next))) next = release;
     }
-}
\ No newline at end of file
+    return next;
+}
@@ -24,6 +24,12 @@ class HWInterface : public SimObject
 {
     friend class LLVMInterface;
     private:
+        std::vector<FunctionalUnitBase *> fu_table;
+        // Issue ports shared by every functional unit type
+        uint32_t issue_width;
+        uint32_t issued = 0;
+        uint64_t issue_cycle = 0;
+        bool issue_stalled = false;
     protected:
     public:
         CycleCounts *cycle_counts;
@@ -36,9 +42,16 @@ class HWInterface : public SimObject
 
         HWInterface();
         HWInterface(const HWInterfaceParams &params);
+        FunctionalUnitBase * getFunctionalUnit(uint64_t functional_unit) {
+            return (functional_unit < fu_table.size()) ? fu_table[functional_unit] : nullptr;
+        }
+        bool availableIssuePort(uint64_t functional_unit);
+        void stallIssuePort() { issue_stalled = true; }
         bool availableFunctionalUnit(uint64_t functional_unit);
-        void clearFunctionalUnit(uint64_t functional_unit);
-        
+        void useFunctionalUnit(uint64_t functional_unit, uint64_t latency);
+        void stallFunctionalUnit(uint64_t functional_unit);
+        void advanceFunctionalUnits(uint64_t cycle);
+        uint64_t nextFunctionalUnitRelease();
 
 };
 
@@ -1,32 +1,23 @@
 #include "hw_statistics.hh"
 
+#include "base/output.hh"
+#include "sim/sim_exit.hh"
+
+#include "functional_units.hh"
+
 HWStatistics::HWStatistics(const HWStatisticsParams &params) :
-    SimObject(params) { 
-        
-        statBufferSize = 10000;
-        statBufferPreDefine = 2;
+    SimObject(params),
+    cycle_tracking(params.cycle_tracking),
+    tracePath(params.cycle_trace.empty() ? name() + ".cycle_trace" :
+              params.cycle_trace),
+    traceChunk(params.cycle_trace_chunk),
+    traceCompress(params.cycle_trace_compress) {
         dbg = false;
-
-        for (int i=0 ; i<statBufferPreDefine; i++ ) {
-            std::vector<HW_Cycle_Stats> hw_cycle_buffer;
-            hw_cycle_buffer.reserve(statBufferSize);
-            hw_buffer_list.push_back(hw_cycle_buffer);
-        }
-        hw_buffer = hw_buffer_list.begin();
-        cycle_buffer = hw_buffer->begin();
         clearStats();
+        // Write out the last chunk even if the simulation ends mid-kernel
+        if (cycle_tracking) registerExitCallback([this]() { trace.reset(); });
     }
 
-
-void
-HWStatistics::updateHWStatsCycleStart() {
-    if (dbg) DPRINTF(SALAM_Debug, "Updating Cycle Statistics Buffer\n");
-    (*hw_buffer).insert(cycle_buffer, current_cycle_stats);
-    clearStats();
-    updateBuffer();
-    
-}
-
 void
 HWStatistics::clearStats() {
     if (dbg) DPRINTF(SALAM_Debug, "Clearing Cycle Statistics\n");
@@ -35,45 +26,59 @@ HWStatistics::clearStats() {
 }
 
 void
-HWStatistics::updateHWStatsCycleEnd(int curr_cycle) {
+HWStatistics::updateHWStatsCycleEnd(const HW_Cycle_Stats &function_stats) {
     if (dbg) DPRINTF(SALAM_Debug, "Updating Cycle Statistics\n");
-    current_cycle_stats.cycle = curr_cycle;
+    current_cycle_stats.add(function_stats);
+}
 
+void
+HWStatistics::openTrace(const std::vector<FunctionalUnitBase *> &fus) {
+    std::vector<std::string> columns = {
+        "cycle", "resInFlight",
+        "loadInFlight", "loadInternal", "loadActive", "loadRawStall",
+        "storeInFlight", "storeActive",
+        "compInFlight", "compLaunched", "compActive", "compFUStall",
+        "compCommited" };
+    for (auto fu : fus) columns.push_back("fu." + fu->get_alias());
+    std::string path = simout.resolve(tracePath);
+    DPRINTF(SALAM_Debug, "Opening cycle trace %s\n", path);
+    trace.reset(new CycleTrace(path, columns, traceChunk, traceCompress));
+    record.resize(columns.size());
 }
 
 void
-HWStatistics::updateBuffer() {
-    if (dbg) DPRINTF(SALAM_Debug, "Checking Buffer[%i][%i]\n", current_buffer_index, hw_buffer_list.at(current_buffer_index).size());
-    if (hw_buffer_list.at(current_buffer_index).size() == statBufferSize) {
-        current_buffer_index++;
-        if(current_buffer_index == statBufferPreDefine) {
-            if (dbg) DPRINTF(SALAM_Debug, "Creating New Buffer Window\n");
-            std::vector<HW_Cycle_Stats> hw_cycle_buffer;
-            hw_cycle_buffer.reserve(statBufferSize);
-            hw_buffer_list.push_back(hw_cycle_buffer);
-            hw_buffer = hw_buffer_list.end();
-            cycle_buffer = hw_buffer->begin();
-        } else {
-            if (dbg) DPRINTF(SALAM_Debug, "Next Buffer Window\n");
-            hw_buffer++;
-            cycle_buffer = hw_buffer->begin();
-        }
-    } else {
-        cycle_buffer = hw_buffer->end();
-    }
+HWStatistics::traceCycle(int curr_cycle, const std::vector<FunctionalUnitBase *> &fus) {
+    if (!trace) openTrace(fus);
+    assert(record.size() == (fus.size() + HW_Cycle_Stats::Fields));
+    current_cycle_stats.cycle = curr_cycle;
+    // Same order as the columns in openTrace
+    int32_t *value = record.data();
+    *value++ = current_cycle_stats.cycle;
+    *value++ = current_cycle_stats.resInFlight;
+    *value++ = current_cycle_stats.loadInFlight;
+    *value++ = current_cycle_stats.loadInternal;
+    *value++ = current_cycle_stats.loadAcitve;
+    *value++ = current_cycle_stats.loadRawStall;
+    *value++ = current_cycle_stats.storeInFlight;
+    *value++ = current_cycle_stats.storeActive;
+    *value++ = current_cycle_stats.compInFlight;
+    *value++ = current_cycle_stats.compLaunched;
+    *value++ = current_cycle_stats.compActive;
+    *value++ = current_cycle_stats.compFUStall;
+    *value++ = current_cycle_stats.compCommited;
+    for (auto fu : fus) *value++ = fu->get_in_use();
+    trace->append(record.data());
+    clearStats();
+}
+
+void
+HWStatistics::flushTrace() {
+    if (trace) trace->flush();
 }
 
 
 void
 HWStatistics::print() {
-    if (dbg) DPRINTF(SALAM_Debug," Buffers: %i\n", (current_buffer_index + 1));
-    for (auto buffers : hw_buffer_list) {
-        for (auto cycles : buffers) {
-            // This loops through the full runtime, starting at cycle 1 to completion
-            //std::cout << " Cycle: " << cycles.cycle;
-        }
-    }
-
 
 /*
     std::cout << "********************************************************************************" << std::endl;
@@ -5,14 +5,18 @@
 #include "sim/sim_object.hh"
 
 #include "hwacc/LLVMRead/src/debug_flags.hh"
+#include "cycle_trace.hh"
 
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <memory>
 #include <vector>
 
 using namespace gem5;
 
+class FunctionalUnitBase;
+
 
 // Things here are output only once at end of simulation
 struct HW_Params {
@@ -26,6 +30,9 @@ struct HW_Params {
 
 // These are outputs that are stored each cycle
 struct HW_Cycle_Stats {
+    // Number of values below, each is a column of the cycle trace
+    static const int Fields = 13;
+
     int cycle;
 
     int resInFlight;
@@ -50,8 +57,32 @@ struct HW_Cycle_Stats {
         cycle = 0;
         resInFlight = 0;
         loadInFlight = 0;
+        loadInternal = 0;
+        loadAcitve = 0;
+        loadRawStall = 0;
         storeInFlight = 0;
+        storeActive = 0;
         compInFlight = 0;
+        compLaunched = 0;
+        compActive = 0;
+        compFUStall = 0;
+        compCommited = 0;
+    }
+
+    // Sum the stats of another active function in the same cycle
+    void add(const HW_Cycle_Stats &other) {
+        resInFlight += other.resInFlight;
+        loadInFlight += other.loadInFlight;
+        loadInternal += other.loadInternal;
+        loadAcitve += other.loadAcitve;
+        loadRawStall += other.loadRawStall;
+        storeInFlight += other.storeInFlight;
+        storeActive += other.storeActive;
+        compInFlight += other.compInFlight;
+        compLaunched += other.compLaunched;
+        compActive += other.compActive;
+        compFUStall += other.compFUStall;
+        compCommited += other.compCommited;
     }
 };
 
@@ -60,20 +91,18 @@ class HWStatistics : public SimObject
     private:
         HW_Params hw_params;
         HW_Cycle_Stats current_cycle_stats;
-        std::vector<HW_Cycle_Stats>::iterator cycle_buffer;
-        std::vector<std::vector<HW_Cycle_Stats>> hw_buffer_list;
-        std::vector<std::vector<HW_Cycle_Stats>>::iterator hw_buffer;
 
-        // Make Into SimObjects to pass from config.yml
-        bool cycle_tracking = false;
+        bool cycle_tracking;
         bool dbg;
-        int statBufferSize;
-        int statBufferPreDefine;
-
 
-        // Class Only
-        int current_buffer_index = 0;
+        // Cycle trace, opened on the first traced cycle
+        std::string tracePath;
+        uint32_t traceChunk;
+        bool traceCompress;
+        std::unique_ptr<CycleTrace> trace;
+        std::vector<int32_t> record;
 
+        void openTrace(const std::vector<FunctionalUnitBase *> &fus);
 
     public:
         HWStatistics();
@@ -83,9 +112,9 @@ class HWStatistics : public SimObject
         void print();
         void simpleStats();
         void unitCorrections();
-        void updateHWStatsCycleStart();
-        void updateHWStatsCycleEnd(int curr_cycle);
-        void updateBuffer();
+        void updateHWStatsCycleEnd(const HW_Cycle_Stats &function_stats);
+        void traceCycle(int curr_cycle, const std::vector<FunctionalUnitBase *> &fus);
+        void flushTrace();
         void clearStats();
 };
 
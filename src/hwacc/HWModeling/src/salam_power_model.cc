@@ -1,5 +1,152 @@
 #include "salam_power_model.hh"
 
+#include "base/logging.hh"
+#include "sim/core.hh"
+
+#include "functional_units.hh"
+
+namespace
+{
+
+double
+prefixScale(const std::string &unit, const std::string &base)
+{
+    fatal_if((unit.size() < base.size()) ||
+             (unit.compare(unit.size() - base.size(), base.size(), base) != 0),
+             "Power model unit %s is not in %s\n", unit, base);
+    std::string prefix = unit.substr(0, unit.size() - base.size());
+    if (prefix.empty()) return 1;
+    if (prefix == "k") return 1e3;
+    if (prefix == "m") return 1e-3;
+    if (prefix == "u") return 1e-6;
+    if (prefix == "n") return 1e-9;
+    if (prefix == "p") return 1e-12;
+    if (prefix == "f") return 1e-15;
+    fatal("Unknown prefix in power model unit %s\n", unit);
+}
+
+} // anonymous namespace
+
 SALAMPowerModel::SALAMPowerModel(const SALAMPowerModelParams &params) :
-    SimObject(params) { }
+    SimObject(params),
+    powerStats(*this) {
+        FunctionalUnits *fus = params.functional_units;
+        bitRegister = makeEntry(fus->_bit_register);
+        for (auto fu : fus->functional_unit_list) {
+            if (fu == fus->_bit_register) continue;
+            uint32_t enum_value = fu->get_enum_value();
+            if (enum_value >= fuIndex.size()) fuIndex.resize(enum_value + 1, -1);
+            fuIndex[enum_value] = table.size();
+            table.push_back(makeEntry(fu));
+        }
+
+        for (auto stat : { &powerStats.units, &powerStats.area, &powerStats.leakagePower,
+                           &powerStats.busyCycles, &powerStats.dynamicEnergy }) {
+            stat->init(table.size()).flags(statistics::total | statistics::nozero);
+            for (size_t i = 0; i < table.size(); i++)
+                stat->subname(i, table[i].fu->get_alias());
+        }
+    }
+
+SALAMPowerModel::Entry
+SALAMPowerModel::makeEntry(FunctionalUnitBase *fu) {
+    double power = prefixScale(fu->get_power_units(), "W");
+    double length = prefixScale(fu->get_area_units(), "m^2") / 1e-6;
+    Entry entry;
+    entry.fu = fu;
+    entry.area = fu->get_area() * length * length;
+    entry.leakagePower = fu->get_leakage_power() * power;
+    entry.activePower = (fu->get_internal_power() + fu->get_switch_power()) * power;
+    entry.cycleEnergy = entry.activePower * clockPeriod;
+    return entry;
+}
+
+void
+SALAMPowerModel::setStaticStats() {
+    for (size_t i = 0; i < table.size(); i++) {
+        uint64_t units = table[i].fu->get_functional_unit_limit();
+        powerStats.units[i] = units;
+        powerStats.area[i] = units * table[i].area;
+        powerStats.leakagePower[i] = units * table[i].leakagePower;
+    }
+    powerStats.registerBits = registerBits;
+    powerStats.registerArea = registerBits * bitRegister.area;
+    powerStats.registerLeakagePower = registerBits * bitRegister.leakagePower;
+}
+
+void
+SALAMPowerModel::kernelStart(Tick clock_period) {
+    clockPeriod = clock_period / sim_clock::as_float::s;
+    for (auto &entry : table) entry.cycleEnergy = entry.activePower * clockPeriod;
+    bitRegister.cycleEnergy = bitRegister.activePower * clockPeriod;
+    setStaticStats();
+}
+
+void
+SALAMPowerModel::kernelEnd(uint64_t cycles, uint64_t reg_bits, uint64_t reg_reads,
+                           uint64_t reg_writes, uint64_t reg_bit_accesses) {
+    registerBits = reg_bits;
+    powerStats.cycles += cycles;
+    powerStats.runtime += cycles * clockPeriod;
+    powerStats.registerReads += reg_reads;
+    powerStats.registerWrites += reg_writes;
+    powerStats.registerDynamicEnergy += reg_bit_accesses * bitRegister.cycleEnergy;
+    setStaticStats();
+}
+
+SALAMPowerModel::PowerStats::PowerStats(SALAMPowerModel &_model)
+    : statistics::Group(&_model, "power"),
+    model(_model),
+    ADD_STAT(units, statistics::units::Count::get(),
+             "Number of functional units of each type"),
+    ADD_STAT(area, statistics::units::Unspecified::get(),
+             "Area of each functional unit type (um^2)"),
+    ADD_STAT(leakagePower, statistics::units::Watt::get(),
+             "Leakage power of each functional unit type"),
+    ADD_STAT(registerBits, statistics::units::Bit::get(),
+             "Number of register bits"),
+    ADD_STAT(registerArea, statistics::units::Unspecified::get(),
+             "Area of the registers (um^2)"),
+    ADD_STAT(registerLeakagePower, statistics::units::Watt::get(),
+             "Leakage power of the registers"),
+    ADD_STAT(cycles, statistics::units::Cycle::get(),
+             "Number of cycles the datapath ran"),
+    ADD_STAT(runtime, statistics::units::Second::get(),
+             "Time the datapath ran"),
+    ADD_STAT(busyCycles, statistics::units::Cycle::get(),
+             "Cycles units of each type were occupied, summed over the units"),
+    ADD_STAT(dynamicEnergy, statistics::units::Joule::get(),
+             "Dynamic energy of each functional unit type"),
+    ADD_STAT(registerReads, statistics::units::Count::get(),
+             "Number of register reads"),
+    ADD_STAT(registerWrites, statistics::units::Count::get(),
+             "Number of register writes"),
+    ADD_STAT(registerDynamicEnergy, statistics::units::Joule::get(),
+             "Dynamic energy of the registers"),
+    ADD_STAT(totalArea, statistics::units::Unspecified::get(),
+             "Area of the datapath (um^2)",
+             sum(area) + registerArea),
+    ADD_STAT(totalLeakagePower, statistics::units::Watt::get(),
+             "Leakage power of the datapath",
+             sum(leakagePower) + registerLeakagePower),
+    ADD_STAT(totalDynamicEnergy, statistics::units::Joule::get(),
+             "Dynamic energy of the datapath",
+             sum(dynamicEnergy) + registerDynamicEnergy),
+    ADD_STAT(dynamicPower, statistics::units::Watt::get(),
+             "Average dynamic power of the datapath",
+             totalDynamicEnergy / runtime),
+    ADD_STAT(totalPower, statistics::units::Watt::get(),
+             "Average power of the datapath",
+             dynamicPower + totalLeakagePower),
+    ADD_STAT(totalEnergy, statistics::units::Joule::get(),
+             "Energy of the datapath, dynamic and leakage",
+             totalDynamicEnergy + totalLeakagePower * runtime)
+{
+}
 
+void
+SALAMPowerModel::PowerStats::resetStats() {
+    statistics::Group::resetStats();
+    // The datapath does not change with a stats reset, only the activity
+    model.setStaticStats();
+}
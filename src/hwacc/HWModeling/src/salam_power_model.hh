@@ -2,38 +2,107 @@
 #define __HWMODEL_SALAM_POWER_MODEL_HH__
 
 #include "params/SALAMPowerModel.hh"
+#include "base/statistics.hh"
 #include "sim/sim_object.hh"
 
 #include <iostream>
 #include <cstdlib>
+#include <string>
 #include <vector>
 
 using namespace gem5;
 
+class FunctionalUnitBase;
+class FunctionalUnits;
+
+/**
+ * Area and power of the datapath, from the power model of each generated
+ * functional unit definition. Every unit type contributes area and leakage
+ * per instantiated unit, and its internal and switching power for every
+ * cycle a unit is occupied. The bit register does the same per register bit,
+ * with one active cycle per bit read or written. Everything is converted to
+ * SI units, except area which is reported in um^2.
+ */
 class SALAMPowerModel : public SimObject
 {
     private:
-        struct units {
-            std::string name;
-            double exponent;
-        } power_unit, energy_unit, time_unit, area_unit;
-        
-        double internal_power;
-        double swtich_power;
-        double dynmaic_power;
-        double leakage_power;
-
-        double dynamic_energy;
-        double latency;
-        double path_delay;
-        double area;
-
-    protected:
+        // Power model of one functional unit type
+        struct Entry {
+            FunctionalUnitBase *fu;
+            double area;
+            double leakagePower;
+            // Internal plus switching power, and its energy over one cycle
+            double activePower;
+            double cycleEnergy;
+        };
+        std::vector<Entry> table;
+        // Stat index of each functional unit enum value, -1 if not modeled
+        std::vector<int> fuIndex;
+        Entry bitRegister;
+        uint64_t registerBits = 0;
+        // Seconds
+        double clockPeriod = 0;
+
+        Entry makeEntry(FunctionalUnitBase *fu);
+        void setStaticStats();
+
+        struct PowerStats : public statistics::Group
+        {
+            PowerStats(SALAMPowerModel &model);
+            void resetStats() override;
+
+            SALAMPowerModel &model;
+
+            /** @{ Datapath, recomputed when a kernel starts */
+            statistics::Vector units;
+            statistics::Vector area;
+            statistics::Vector leakagePower;
+            statistics::Scalar registerBits;
+            statistics::Scalar registerArea;
+            statistics::Scalar registerLeakagePower;
+            /** @} */
+
+            /** @{ Activity */
+            statistics::Scalar cycles;
+            statistics::Scalar runtime;
+            statistics::Vector busyCycles;
+            statistics::Vector dynamicEnergy;
+            statistics::Scalar registerReads;
+            statistics::Scalar registerWrites;
+            statistics::Scalar registerDynamicEnergy;
+            /** @} */
+
+            statistics::Formula totalArea;
+            statistics::Formula totalLeakagePower;
+            statistics::Formula totalDynamicEnergy;
+            statistics::Formula dynamicPower;
+            statistics::Formula totalPower;
+            statistics::Formula totalEnergy;
+        } powerStats;
 
     public:
         SALAMPowerModel();
         SALAMPowerModel(const SALAMPowerModelParams &params);
-    
+
+        /** Set the datapath of a kernel once its units are instantiated */
+        void kernelStart(Tick clock_period);
+
+        /** A functional unit was reserved for the given number of cycles */
+        void
+        useFunctionalUnit(uint64_t functional_unit, uint64_t occupancy) {
+            int index = (functional_unit < fuIndex.size()) ? fuIndex[functional_unit] : -1;
+            if (index < 0) return;
+            powerStats.busyCycles[index] += occupancy;
+            powerStats.dynamicEnergy[index] += occupancy * table[index].cycleEnergy;
+        }
+
+        /** Account the runtime and register activity of a finished kernel */
+        void kernelEnd(uint64_t cycles, uint64_t reg_bits, uint64_t reg_reads,
+                       uint64_t reg_writes, uint64_t reg_bit_accesses);
+
+        double getTotalArea() { return powerStats.totalArea.total(); }
+        double getTotalLeakagePower() { return powerStats.totalLeakagePower.total(); }
+        double getTotalDynamicEnergy() { return powerStats.totalDynamicEnergy.total(); }
 };
 
-#endif //__HWMODEL_SALAM_POWER_MODEL_HH__
\ No newline at end of file
+#endif //__HWMODEL_SALAM_POWER_MODEL_HH__
@@ -0,0 +1,58 @@
+#include "sram_power.hh"
+
+SRAMPower::SRAMPower(statistics::Group *parent) :
+    statistics::Group(parent, "power"),
+    ADD_STAT(area, statistics::units::Unspecified::get(),
+             "Area of the memory arrays (um^2)"),
+    ADD_STAT(leakagePower, statistics::units::Watt::get(),
+             "Leakage power of the memory arrays"),
+    ADD_STAT(readEnergy, statistics::units::Joule::get(),
+             "Dynamic energy of a word read"),
+    ADD_STAT(writeEnergy, statistics::units::Joule::get(),
+             "Dynamic energy of a word write"),
+    ADD_STAT(accessTime, statistics::units::Second::get(),
+             "Access time of a memory array"),
+    ADD_STAT(reads, statistics::units::Count::get(),
+             "Number of word reads"),
+    ADD_STAT(writes, statistics::units::Count::get(),
+             "Number of word writes"),
+    ADD_STAT(dynamicEnergy, statistics::units::Joule::get(),
+             "Dynamic energy of the memory accesses",
+             reads * readEnergy + writes * writeEnergy)
+{
+    using namespace statistics;
+
+    area.flags(nozero);
+    leakagePower.flags(nozero);
+    readEnergy.flags(nozero);
+    writeEnergy.flags(nozero);
+    accessTime.flags(nozero);
+    reads.flags(nozero);
+    writes.flags(nozero);
+    dynamicEnergy.flags(nozero);
+}
+
+void
+SRAMPower::configure(const CactiResult &array, unsigned num_arrays,
+                     unsigned word_size) {
+    estimate = array;
+    arrays = num_arrays;
+    wordSize = word_size;
+    setStaticStats();
+}
+
+void
+SRAMPower::setStaticStats() {
+    area = estimate.area * arrays;
+    leakagePower = estimate.leakagePower * arrays;
+    readEnergy = estimate.readEnergy;
+    writeEnergy = estimate.writeEnergy;
+    accessTime = estimate.accessTime;
+}
+
+void
+SRAMPower::resetStats() {
+    statistics::Group::resetStats();
+    // The memory does not change with a stats reset, only the activity
+    if (enabled()) setStaticStats();
+}
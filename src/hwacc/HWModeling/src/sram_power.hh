@@ -0,0 +1,57 @@
+#ifndef __HWMODEL_SRAM_POWER_HH__
+#define __HWMODEL_SRAM_POWER_HH__
+
+#include "base/intmath.hh"
+#include "base/statistics.hh"
+
+#include "cacti_wrapper.hh"
+
+using namespace gem5;
+
+/**
+ * Area, leakage and access energy of a memory built from one or more
+ * identical SRAM arrays, from a CACTI estimate of one array. Accesses are
+ * counted in words of the modeled array. Nothing is reported until an
+ * estimate is set.
+ */
+class SRAMPower : public statistics::Group
+{
+    private:
+        CactiResult estimate{};
+        unsigned arrays = 0;
+        unsigned wordSize = 0;
+
+        void setStaticStats();
+
+    public:
+        SRAMPower(statistics::Group *parent);
+
+        /** Model the memory as arrays copies of the estimated array */
+        void configure(const CactiResult &array, unsigned num_arrays,
+                       unsigned word_size);
+        bool enabled() const { return wordSize != 0; }
+
+        /** Account an access of the given number of bytes */
+        void
+        access(bool read, unsigned bytes) {
+            if (!wordSize) return;
+            if (read) reads += divCeil(bytes, wordSize);
+            else writes += divCeil(bytes, wordSize);
+        }
+
+        void resetStats() override;
+
+        /** @{ Memory, set by configure */
+        statistics::Scalar area;
+        statistics::Scalar leakagePower;
+        statistics::Scalar readEnergy;
+        statistics::Scalar writeEnergy;
+        statistics::Scalar accessTime;
+        /** @} */
+
+        statistics::Scalar reads;
+        statistics::Scalar writes;
+        statistics::Formula dynamicEnergy;
+};
+
+#endif //__HWMODEL_SRAM_POWER_HH__
@@ -9,6 +9,12 @@ class LLVMInterface(ComputeUnit):
     
     in_file = Param.String("LLVM Trace File")
     lockstep_mode = Param.Bool(True, "TRUE: Stall datapath if any operation stalls. FALSE: Only stall datapath regions with stalls")
+    ready_list_scheduling = Param.Bool(False, "TRUE: Only visit instructions whose dependencies have resolved and retire multi-cycle operations from a timing wheel. FALSE: Poll the full reservation and compute queues every cycle. Both produce identical cycle counts")
+    compute_kernels = Param.Bool(False, "TRUE: Execute arithmetic, compare and integer cast instructions through kernels specialized on opcode and bit width when the static graph is built. FALSE: Use the virtual compute() of each instruction, kept for validation")
+    simd_lanes = Param.UInt32(0, "Lanes processed per cycle by vector instructions. A vector instruction takes ceil(lanes/simd_lanes) times its scalar cycle count. 0 issues any vector in the scalar cycle count")
+    quiescence = Param.Bool(False, "TRUE: Stop ticking while all work waits on memory and account the skipped cycles on wakeup. FALSE: Tick every cycle")
+    graph_cache = Param.String("", "Directory for cached static graphs, keyed by the IR file hash. Repeated runs on the same kernel skip IR parsing and loop analysis. Empty disables the cache")
     sched_threshold = Param.UInt32(10000, "Scheduling window threshold. Prevents scheduling windows size from exploding during regions of high loop parallelism")
+    host_profile_period = Param.UInt32(64, "Host time of the runtime engine is measured for one in every N runs of each profiled section and scaled by N. 0 disables host time profiling")
     clock_period = Param.Int32(10, "System clock speed")
     top_name = Param.String("top", "Name of the top-level function for the accelerator")
\ No newline at end of file
@@ -0,0 +1,730 @@
+//------------------------------------------//
+#include "compute_kernels.hh"
+#include "instruction.hh"
+//------------------------------------------//
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+// Bytes written back to the return register, matching Value::getSizeInBytes
+constexpr size_t
+bytesOf(unsigned bits)
+{
+    return ((bits - 1) >> 3) + 1;
+}
+
+// Integer operations, the signed ones take sign extended operands
+struct AddOp { static uint64_t apply(uint64_t a, uint64_t b) { return a + b; } };
+struct SubOp { static uint64_t apply(uint64_t a, uint64_t b) { return a - b; } };
+struct MulOp { static uint64_t apply(uint64_t a, uint64_t b) { return a * b; } };
+struct UDivOp { static uint64_t apply(uint64_t a, uint64_t b) { return a / b; } };
+struct URemOp { static uint64_t apply(uint64_t a, uint64_t b) { return a % b; } };
+struct ShlOp { static uint64_t apply(uint64_t a, uint64_t b) { return a << b; } };
+struct LShrOp { static uint64_t apply(uint64_t a, uint64_t b) { return a >> b; } };
+struct AndOp { static uint64_t apply(uint64_t a, uint64_t b) { return a & b; } };
+struct OrOp { static uint64_t apply(uint64_t a, uint64_t b) { return a | b; } };
+struct XorOp { static uint64_t apply(uint64_t a, uint64_t b) { return a ^ b; } };
+struct SDivOp { static int64_t apply(int64_t a, int64_t b) { return a / b; } };
+struct SRemOp { static int64_t apply(int64_t a, int64_t b) { return a % b; } };
+struct AShrOp { static int64_t apply(int64_t a, int64_t b) { return a >> b; } };
+
+// Floating point operations
+struct FAddOp { template <class T> static T apply(T a, T b) { return a + b; } };
+struct FSubOp { template <class T> static T apply(T a, T b) { return a - b; } };
+struct FMulOp { template <class T> static T apply(T a, T b) { return a * b; } };
+struct FDivOp { template <class T> static T apply(T a, T b) { return a / b; } };
+struct FRemOp { template <class T> static T apply(T a, T b) { return std::remainder(a, b); } };
+
+// Integer comparisons
+struct EqCmp { template <class T> static bool apply(T a, T b) { return a == b; } };
+struct NeCmp { template <class T> static bool apply(T a, T b) { return a != b; } };
+struct GtCmp { template <class T> static bool apply(T a, T b) { return a > b; } };
+struct GeCmp { template <class T> static bool apply(T a, T b) { return a >= b; } };
+struct LtCmp { template <class T> static bool apply(T a, T b) { return a < b; } };
+struct LeCmp { template <class T> static bool apply(T a, T b) { return a <= b; } };
+
+template <class Op, unsigned Bits>
+void
+unsignedKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    uint64_t op1 = operands[0].getOpRegister().getUnsignedInt();
+    uint64_t op2 = operands[1].getOpRegister().getUnsignedInt();
+    result->writeIntData(Op::apply(op1, op2), bytesOf(Bits));
+}
+
+template <class Op, unsigned Bits>
+void
+signedKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    int64_t op1 = operands[0].getOpRegister().getSignedInt(Bits);
+    int64_t op2 = operands[1].getOpRegister().getSignedInt(Bits);
+    result->writeIntData((uint64_t)Op::apply(op1, op2), bytesOf(Bits));
+}
+
+template <class Op>
+void
+floatKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    float value = Op::apply(operands[0].getOpRegister().getFloat(),
+                            operands[1].getOpRegister().getFloat());
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(float));
+    result->writeFloatData(bits, sizeof(float));
+}
+
+template <class Op>
+void
+doubleKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    double value = Op::apply(operands[0].getOpRegister().getDouble(),
+                             operands[1].getOpRegister().getDouble());
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(double));
+    result->writeFloatData(bits, sizeof(double));
+}
+
+template <class Cmp>
+void
+unsignedCmpKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    bool value = Cmp::apply(operands[0].getOpRegister().getUnsignedInt(),
+                            operands[1].getOpRegister().getUnsignedInt());
+    result->writeIntData(value ? 1 : 0, bytesOf(1));
+}
+
+template <class Cmp, unsigned Bits>
+void
+signedCmpKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    bool value = Cmp::apply(operands[0].getOpRegister().getSignedInt(Bits),
+                            operands[1].getOpRegister().getSignedInt(Bits));
+    result->writeIntData(value ? 1 : 0, bytesOf(1));
+}
+
+template <class Cmp>
+void
+pointerCmpKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    bool value = Cmp::apply(operands[0].getOpRegister().getPtrData(),
+                            operands[1].getOpRegister().getPtrData());
+    result->writeIntData(value ? 1 : 0, bytesOf(1));
+}
+
+// Trunc and ZExt, the register write drops or keeps the upper bytes
+template <unsigned Bits>
+void
+moveKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    result->writeIntData(operands[0].getOpRegister().getUnsignedInt(), bytesOf(Bits));
+}
+
+template <unsigned SrcBits, unsigned Bits>
+void
+sextKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    int64_t value = operands[0].getOpRegister().getSignedInt(SrcBits);
+    result->writeIntData((uint64_t)value, bytesOf(Bits));
+}
+
+// Instantiate a kernel for the integer widths with a native host type
+#define SALAM_INT_WIDTH_CASES(KERNEL, ...)                            \
+    case 1: return KERNEL<__VA_ARGS__ 1>;                             \
+    case 8: return KERNEL<__VA_ARGS__ 8>;                             \
+    case 16: return KERNEL<__VA_ARGS__ 16>;                           \
+    case 32: return KERNEL<__VA_ARGS__ 32>;                           \
+    case 64: return KERNEL<__VA_ARGS__ 64>;
+
+#define SALAM_SIGNED_WIDTH_CASES(KERNEL, ...)                         \
+    case 8: return KERNEL<__VA_ARGS__ 8>;                             \
+    case 16: return KERNEL<__VA_ARGS__ 16>;                           \
+    case 32: return KERNEL<__VA_ARGS__ 32>;                           \
+    case 64: return KERNEL<__VA_ARGS__ 64>;
+
+template <class Op>
+SALAM::ComputeKernel
+lowerUnsigned(unsigned bits)
+{
+    switch (bits) {
+        SALAM_INT_WIDTH_CASES(unsignedKernel, Op,)
+        default: return nullptr;
+    }
+}
+
+template <class Op>
+SALAM::ComputeKernel
+lowerSigned(unsigned bits)
+{
+    switch (bits) {
+        SALAM_SIGNED_WIDTH_CASES(signedKernel, Op,)
+        default: return nullptr;
+    }
+}
+
+template <class Op>
+SALAM::ComputeKernel
+lowerFloat(unsigned bits)
+{
+    switch (bits) {
+        case 32: return floatKernel<Op>;
+        case 64: return doubleKernel<Op>;
+        default: return nullptr;
+    }
+}
+
+template <class Cmp>
+SALAM::ComputeKernel
+lowerUnsignedCmp(unsigned bits, bool pointer)
+{
+    if (pointer) return pointerCmpKernel<Cmp>;
+    switch (bits) {
+        case 1: case 8: case 16: case 32: case 64: return unsignedCmpKernel<Cmp>;
+        default: return nullptr;
+    }
+}
+
+template <class Cmp>
+SALAM::ComputeKernel
+lowerSignedCmp(unsigned bits, bool pointer)
+{
+    if (pointer) return nullptr;
+    switch (bits) {
+        SALAM_SIGNED_WIDTH_CASES(signedCmpKernel, Cmp,)
+        default: return nullptr;
+    }
+}
+
+SALAM::ComputeKernel
+lowerMove(unsigned bits)
+{
+    switch (bits) {
+        SALAM_INT_WIDTH_CASES(moveKernel,)
+        default: return nullptr;
+    }
+}
+
+template <unsigned SrcBits>
+SALAM::ComputeKernel
+lowerSExtTo(unsigned bits)
+{
+    switch (bits) {
+        SALAM_SIGNED_WIDTH_CASES(sextKernel, SrcBits,)
+        default: return nullptr;
+    }
+}
+
+SALAM::ComputeKernel
+lowerSExt(unsigned srcBits, unsigned bits)
+{
+    switch (srcBits) {
+        case 8: return lowerSExtTo<8>(bits);
+        case 16: return lowerSExtTo<16>(bits);
+        case 32: return lowerSExtTo<32>(bits);
+        case 64: return lowerSExtTo<64>(bits);
+        default: return nullptr;
+    }
+}
+
+// Vector lanes are packed at their native width, the loops below are plain
+// arrays of host types and are left to the compiler to vectorize
+template <class T>
+inline T
+loadLane(const uint8_t *data, size_t lane)
+{
+    T value;
+    std::memcpy(&value, data + lane * sizeof(T), sizeof(T));
+    return value;
+}
+
+template <class T>
+inline void
+storeLane(uint8_t *data, size_t lane, T value)
+{
+    std::memcpy(data + lane * sizeof(T), &value, sizeof(T));
+}
+
+// Floating point comparisons, the unordered predicates are true for NaN
+struct FalseCmp { template <class T> static bool apply(T a, T b) { return false; } };
+struct OEqCmp { template <class T> static bool apply(T a, T b) { return a == b; } };
+struct OGtCmp { template <class T> static bool apply(T a, T b) { return a > b; } };
+struct OGeCmp { template <class T> static bool apply(T a, T b) { return a >= b; } };
+struct OLtCmp { template <class T> static bool apply(T a, T b) { return a < b; } };
+struct OLeCmp { template <class T> static bool apply(T a, T b) { return a <= b; } };
+struct ONeCmp { template <class T> static bool apply(T a, T b) { return (a < b) || (a > b); } };
+struct OrdCmp { template <class T> static bool apply(T a, T b) { return (a == a) && (b == b); } };
+struct UnoCmp { template <class T> static bool apply(T a, T b) { return (a != a) || (b != b); } };
+struct UEqCmp { template <class T> static bool apply(T a, T b) { return !((a < b) || (a > b)); } };
+struct UGtCmp { template <class T> static bool apply(T a, T b) { return !(a <= b); } };
+struct UGeCmp { template <class T> static bool apply(T a, T b) { return !(a < b); } };
+struct ULtCmp { template <class T> static bool apply(T a, T b) { return !(a >= b); } };
+struct ULeCmp { template <class T> static bool apply(T a, T b) { return !(a > b); } };
+struct UNeCmp { template <class T> static bool apply(T a, T b) { return a != b; } };
+struct TrueCmp { template <class T> static bool apply(T a, T b) { return true; } };
+
+template <class Op, class T>
+void
+vectorIntKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    const uint8_t *a = operands[0].getOpRegister().getVectorData();
+    const uint8_t *b = operands[1].getOpRegister().getVectorData();
+    uint8_t *r = result->getVectorBuffer();
+    size_t lanes = result->getLanes();
+    for (size_t i = 0; i < lanes; i++)
+        storeLane<T>(r, i, (T)Op::apply(loadLane<T>(a, i), loadLane<T>(b, i)));
+}
+
+template <class Op, class T>
+void
+vectorFloatKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    const uint8_t *a = operands[0].getOpRegister().getVectorData();
+    const uint8_t *b = operands[1].getOpRegister().getVectorData();
+    uint8_t *r = result->getVectorBuffer();
+    size_t lanes = result->getLanes();
+    for (size_t i = 0; i < lanes; i++)
+        storeLane<T>(r, i, Op::template apply<T>(loadLane<T>(a, i), loadLane<T>(b, i)));
+}
+
+// Comparison results are i1 lanes, one byte each
+template <class Cmp, class T>
+void
+vectorCmpKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    const uint8_t *a = operands[0].getOpRegister().getVectorData();
+    const uint8_t *b = operands[1].getOpRegister().getVectorData();
+    uint8_t *r = result->getVectorBuffer();
+    size_t lanes = result->getLanes();
+    for (size_t i = 0; i < lanes; i++)
+        r[i] = Cmp::template apply<T>(loadLane<T>(a, i), loadLane<T>(b, i)) ? 1 : 0;
+}
+
+template <class T>
+void
+vectorSelectKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    auto &cond = operands[0].getOpRegister();
+    auto &trueVal = operands[1].getOpRegister();
+    auto &falseVal = operands[2].getOpRegister();
+    size_t lanes = result->getLanes();
+    if (!cond.isVector()) {
+        auto &selected = (cond.getUnsignedInt() == 1) ? trueVal : falseVal;
+        result->writeVectorData(selected.getVectorData(), lanes * sizeof(T));
+        return;
+    }
+    const uint8_t *c = cond.getVectorData();
+    const uint8_t *a = trueVal.getVectorData();
+    const uint8_t *b = falseVal.getVectorData();
+    uint8_t *r = result->getVectorBuffer();
+    for (size_t i = 0; i < lanes; i++)
+        storeLane<T>(r, i, (c[i] & 1) ? loadLane<T>(a, i) : loadLane<T>(b, i));
+}
+
+// Integer resizes and int/float conversions, From and To are lane types
+template <class From, class To>
+void
+vectorConvertKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    const uint8_t *a = operands[0].getOpRegister().getVectorData();
+    uint8_t *r = result->getVectorBuffer();
+    size_t lanes = result->getLanes();
+    for (size_t i = 0; i < lanes; i++)
+        storeLane<To>(r, i, (To)loadLane<From>(a, i));
+}
+
+// i1 lanes are stored as 0/1 bytes, so truncating to i1 keeps the low bit
+template <class From>
+void
+vectorTruncToBoolKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    const uint8_t *a = operands[0].getOpRegister().getVectorData();
+    uint8_t *r = result->getVectorBuffer();
+    size_t lanes = result->getLanes();
+    for (size_t i = 0; i < lanes; i++)
+        r[i] = loadLane<From>(a, i) & 1;
+}
+
+// Signed extension or conversion of i1 lanes, true is -1
+template <class To>
+void
+vectorBoolSExtKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    const uint8_t *a = operands[0].getOpRegister().getVectorData();
+    uint8_t *r = result->getVectorBuffer();
+    size_t lanes = result->getLanes();
+    for (size_t i = 0; i < lanes; i++)
+        storeLane<To>(r, i, (a[i] & 1) ? (To)-1 : (To)0);
+}
+
+// Bit casts between vectors, or between a vector and a scalar of equal size
+void
+vectorBitCastKernel(SALAM::Operand *operands, SALAM::Register *result)
+{
+    auto &src = operands[0].getOpRegister();
+    uint64_t scalar = 0;
+    const uint8_t *data = nullptr;
+    if (src.isVector()) {
+        data = src.getVectorData();
+    } else {
+        scalar = src.getRawData();
+        data = reinterpret_cast<const uint8_t *>(&scalar);
+    }
+    if (result->isVector()) {
+        result->writeVectorData(data, result->getLanes() * result->getLaneBytes());
+        return;
+    }
+    uint64_t bits = 0;
+    std::memcpy(&bits, data, std::min<size_t>(sizeof(bits), src.getLanes() * src.getLaneBytes()));
+    if (result->isFP()) result->writeFloatData(bits);
+    else if (result->isPtr()) result->writePtrData(bits);
+    else result->writeIntData(bits);
+}
+
+enum LaneType { U8, U16, U32, U64, S8, S16, S32, S64, F32, F64, BadLane };
+
+LaneType
+laneType(SALAM::Register *reg, bool isSigned)
+{
+    if (reg->isFP()) {
+        switch (reg->getLaneBytes()) {
+            case 4: return F32;
+            case 8: return F64;
+            default: return BadLane;
+        }
+    }
+    switch (reg->getLaneBytes()) {
+        case 1: return isSigned ? S8 : U8;
+        case 2: return isSigned ? S16 : U16;
+        case 4: return isSigned ? S32 : U32;
+        case 8: return isSigned ? S64 : U64;
+        default: return BadLane;
+    }
+}
+
+#define SALAM_INT_LANE_CASES(KERNEL, ...)                             \
+    case U8: return KERNEL<__VA_ARGS__ uint8_t>;                      \
+    case U16: return KERNEL<__VA_ARGS__ uint16_t>;                    \
+    case U32: return KERNEL<__VA_ARGS__ uint32_t>;                    \
+    case U64: return KERNEL<__VA_ARGS__ uint64_t>;                    \
+    case S8: return KERNEL<__VA_ARGS__ int8_t>;                       \
+    case S16: return KERNEL<__VA_ARGS__ int16_t>;                     \
+    case S32: return KERNEL<__VA_ARGS__ int32_t>;                     \
+    case S64: return KERNEL<__VA_ARGS__ int64_t>;
+
+#define SALAM_LANE_TYPE_CASES(KERNEL, ...)                            \
+    SALAM_INT_LANE_CASES(KERNEL, __VA_ARGS__)                         \
+    case F32: return KERNEL<__VA_ARGS__ float>;                       \
+    case F64: return KERNEL<__VA_ARGS__ double>;
+
+template <class Op>
+SALAM::ComputeKernel
+lowerVectorInt(LaneType lane)
+{
+    switch (lane) {
+        SALAM_INT_LANE_CASES(vectorIntKernel, Op,)
+        default: return nullptr;
+    }
+}
+
+template <class Op>
+SALAM::ComputeKernel
+lowerVectorFloat(LaneType lane)
+{
+    switch (lane) {
+        case F32: return vectorFloatKernel<Op, float>;
+        case F64: return vectorFloatKernel<Op, double>;
+        default: return nullptr;
+    }
+}
+
+template <class Cmp>
+SALAM::ComputeKernel
+lowerVectorCmp(LaneType lane)
+{
+    switch (lane) {
+        case BadLane: return nullptr;
+        SALAM_LANE_TYPE_CASES(vectorCmpKernel, Cmp,)
+    }
+    return nullptr;
+}
+
+SALAM::ComputeKernel
+lowerVectorSelect(LaneType lane)
+{
+    switch (lane) {
+        case BadLane: return nullptr;
+        SALAM_LANE_TYPE_CASES(vectorSelectKernel,)
+    }
+    return nullptr;
+}
+
+template <class From>
+SALAM::ComputeKernel
+lowerVectorConvertTo(LaneType to)
+{
+    switch (to) {
+        case BadLane: return nullptr;
+        SALAM_LANE_TYPE_CASES(vectorConvertKernel, From,)
+    }
+    return nullptr;
+}
+
+SALAM::ComputeKernel
+lowerVectorConvert(LaneType from, LaneType to)
+{
+    switch (from) {
+        case U8: return lowerVectorConvertTo<uint8_t>(to);
+        case U16: return lowerVectorConvertTo<uint16_t>(to);
+        case U32: return lowerVectorConvertTo<uint32_t>(to);
+        case U64: return lowerVectorConvertTo<uint64_t>(to);
+        case S8: return lowerVectorConvertTo<int8_t>(to);
+        case S16: return lowerVectorConvertTo<int16_t>(to);
+        case S32: return lowerVectorConvertTo<int32_t>(to);
+        case S64: return lowerVectorConvertTo<int64_t>(to);
+        case F32: return lowerVectorConvertTo<float>(to);
+        case F64: return lowerVectorConvertTo<double>(to);
+        default: return nullptr;
+    }
+}
+
+SALAM::ComputeKernel
+lowerVectorTruncToBool(LaneType from)
+{
+    switch (from) {
+        case U8: return vectorTruncToBoolKernel<uint8_t>;
+        case U16: return vectorTruncToBoolKernel<uint16_t>;
+        case U32: return vectorTruncToBoolKernel<uint32_t>;
+        case U64: return vectorTruncToBoolKernel<uint64_t>;
+        default: return nullptr;
+    }
+}
+
+SALAM::ComputeKernel
+lowerVectorBoolSExt(LaneType to)
+{
+    switch (to) {
+        case S8: return vectorBoolSExtKernel<int8_t>;
+        case S16: return vectorBoolSExtKernel<int16_t>;
+        case S32: return vectorBoolSExtKernel<int32_t>;
+        case S64: return vectorBoolSExtKernel<int64_t>;
+        case F32: return vectorBoolSExtKernel<float>;
+        case F64: return vectorBoolSExtKernel<double>;
+        default: return nullptr;
+    }
+}
+
+#undef SALAM_INT_LANE_CASES
+#undef SALAM_LANE_TYPE_CASES
+
+#undef SALAM_INT_WIDTH_CASES
+#undef SALAM_SIGNED_WIDTH_CASES
+
+} // anonymous namespace
+
+SALAM::ComputeKernel
+SALAM::lowerComputeKernel(SALAM::Instruction *inst)
+{
+    auto result = inst->getReg();
+    if (!result) return nullptr;
+    // Every lowered opcode reads its operands from the first one or two
+    // static dependencies, which must carry a register of a known type
+    auto deps = inst->getStaticDependencies();
+    if (deps.empty() || !deps.front()->getReg()) return nullptr;
+    auto op = deps.front();
+    unsigned bits = inst->getSize();
+    unsigned opBits = op->getSize();
+    bool intResult = result->isInt();
+    bool fpResult = result->isFP();
+    bool pointerOps = op->getReg()->isPtr();
+
+    switch (inst->getOpode()) {
+        case llvm::Instruction::Add: return intResult ? lowerUnsigned<AddOp>(bits) : nullptr;
+        case llvm::Instruction::Sub: return intResult ? lowerUnsigned<SubOp>(bits) : nullptr;
+        case llvm::Instruction::Mul: return intResult ? lowerUnsigned<MulOp>(bits) : nullptr;
+        case llvm::Instruction::UDiv: return intResult ? lowerUnsigned<UDivOp>(bits) : nullptr;
+        case llvm::Instruction::URem: return intResult ? lowerUnsigned<URemOp>(bits) : nullptr;
+        case llvm::Instruction::Shl: return intResult ? lowerUnsigned<ShlOp>(bits) : nullptr;
+        case llvm::Instruction::LShr: return intResult ? lowerUnsigned<LShrOp>(bits) : nullptr;
+        case llvm::Instruction::And: return intResult ? lowerUnsigned<AndOp>(bits) : nullptr;
+        case llvm::Instruction::Or: return intResult ? lowerUnsigned<OrOp>(bits) : nullptr;
+        case llvm::Instruction::Xor: return intResult ? lowerUnsigned<XorOp>(bits) : nullptr;
+        case llvm::Instruction::SDiv: return intResult ? lowerSigned<SDivOp>(bits) : nullptr;
+        case llvm::Instruction::SRem: return intResult ? lowerSigned<SRemOp>(bits) : nullptr;
+        case llvm::Instruction::AShr: return intResult ? lowerSigned<AShrOp>(bits) : nullptr;
+        case llvm::Instruction::FAdd: return fpResult ? lowerFloat<FAddOp>(bits) : nullptr;
+        case llvm::Instruction::FSub: return fpResult ? lowerFloat<FSubOp>(bits) : nullptr;
+        case llvm::Instruction::FMul: return fpResult ? lowerFloat<FMulOp>(bits) : nullptr;
+        case llvm::Instruction::FDiv: return fpResult ? lowerFloat<FDivOp>(bits) : nullptr;
+        case llvm::Instruction::FRem: return fpResult ? lowerFloat<FRemOp>(bits) : nullptr;
+        case llvm::Instruction::Trunc:
+        case llvm::Instruction::ZExt:
+            return (intResult && !pointerOps) ? lowerMove(bits) : nullptr;
+        case llvm::Instruction::SExt:
+            return (intResult && !pointerOps) ? lowerSExt(opBits, bits) : nullptr;
+        case llvm::Instruction::ICmp:
+        {
+            auto cmp = static_cast<SALAM::ICmp *>(inst);
+            if (!intResult) return nullptr;
+            switch (cmp->getPredicate()) {
+                case SALAM::Predicate::ICMP_EQ: return lowerUnsignedCmp<EqCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_NE: return lowerUnsignedCmp<NeCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_UGT: return lowerUnsignedCmp<GtCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_UGE: return lowerUnsignedCmp<GeCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_ULT: return lowerUnsignedCmp<LtCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_ULE: return lowerUnsignedCmp<LeCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_SGT: return lowerSignedCmp<GtCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_SGE: return lowerSignedCmp<GeCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_SLT: return lowerSignedCmp<LtCmp>(opBits, pointerOps);
+                case SALAM::Predicate::ICMP_SLE: return lowerSignedCmp<LeCmp>(opBits, pointerOps);
+                default: return nullptr;
+            }
+        }
+        default:
+            // Memory, control flow and the remaining conversions keep compute()
+            return nullptr;
+    }
+}
+
+bool
+SALAM::isLaneWise(SALAM::Instruction *inst)
+{
+    auto result = inst->getReg();
+    auto deps = inst->getStaticDependencies();
+    bool vector = (result && result->isVector()) ||
+                  (!deps.empty() && deps.front()->getReg() && deps.front()->getReg()->isVector());
+    if (!vector) return false;
+    switch (inst->getOpode()) {
+        case llvm::Instruction::Add: case llvm::Instruction::Sub:
+        case llvm::Instruction::Mul: case llvm::Instruction::UDiv:
+        case llvm::Instruction::URem: case llvm::Instruction::SDiv:
+        case llvm::Instruction::SRem: case llvm::Instruction::Shl:
+        case llvm::Instruction::LShr: case llvm::Instruction::AShr:
+        case llvm::Instruction::And: case llvm::Instruction::Or:
+        case llvm::Instruction::Xor: case llvm::Instruction::FAdd:
+        case llvm::Instruction::FSub: case llvm::Instruction::FMul:
+        case llvm::Instruction::FDiv: case llvm::Instruction::FRem:
+        case llvm::Instruction::ICmp: case llvm::Instruction::FCmp:
+        case llvm::Instruction::Trunc: case llvm::Instruction::ZExt:
+        case llvm::Instruction::SExt: case llvm::Instruction::FPTrunc:
+        case llvm::Instruction::FPExt: case llvm::Instruction::FPToUI:
+        case llvm::Instruction::FPToSI: case llvm::Instruction::UIToFP:
+        case llvm::Instruction::SIToFP: case llvm::Instruction::PtrToInt:
+        case llvm::Instruction::IntToPtr: case llvm::Instruction::BitCast:
+        case llvm::Instruction::Select:
+            return true;
+        default:
+            // Memory, phi and the element/shuffle instructions move whole
+            // vector registers in compute()
+            return false;
+    }
+}
+
+SALAM::ComputeKernel
+SALAM::lowerVectorKernel(SALAM::Instruction *inst)
+{
+    auto result = inst->getReg();
+    auto deps = inst->getStaticDependencies();
+    if (!result || deps.empty() || !deps.front()->getReg()) return nullptr;
+    auto opReg = deps.front()->getReg();
+    unsigned bits = inst->getSize();
+    unsigned opBits = deps.front()->getSize();
+    LaneType lane = laneType(result, false);
+    LaneType signedLane = laneType(result, true);
+    // i1 lanes only support the bitwise operations
+    bool boolLanes = !result->isFP() && (bits == 1);
+
+    if (inst->getOpode() == llvm::Instruction::BitCast) return vectorBitCastKernel;
+    if (!result->isVector() || !opReg->isVector()) {
+        // Only select may mix a scalar condition with vector operands
+        if (inst->getOpode() != llvm::Instruction::Select || !result->isVector())
+            return nullptr;
+    }
+
+    switch (inst->getOpode()) {
+        case llvm::Instruction::Add: return boolLanes ? nullptr : lowerVectorInt<AddOp>(lane);
+        case llvm::Instruction::Sub: return boolLanes ? nullptr : lowerVectorInt<SubOp>(lane);
+        case llvm::Instruction::Mul: return boolLanes ? nullptr : lowerVectorInt<MulOp>(lane);
+        case llvm::Instruction::UDiv: return boolLanes ? nullptr : lowerVectorInt<UDivOp>(lane);
+        case llvm::Instruction::URem: return boolLanes ? nullptr : lowerVectorInt<URemOp>(lane);
+        case llvm::Instruction::Shl: return boolLanes ? nullptr : lowerVectorInt<ShlOp>(lane);
+        case llvm::Instruction::LShr: return boolLanes ? nullptr : lowerVectorInt<LShrOp>(lane);
+        case llvm::Instruction::SDiv: return boolLanes ? nullptr : lowerVectorInt<SDivOp>(signedLane);
+        case llvm::Instruction::SRem: return boolLanes ? nullptr : lowerVectorInt<SRemOp>(signedLane);
+        case llvm::Instruction::AShr: return boolLanes ? nullptr : lowerVectorInt<AShrOp>(signedLane);
+        case llvm::Instruction::And: return lowerVectorInt<AndOp>(lane);
+        case llvm::Instruction::Or: return lowerVectorInt<OrOp>(lane);
+        case llvm::Instruction::Xor: return lowerVectorInt<XorOp>(lane);
+        case llvm::Instruction::FAdd: return lowerVectorFloat<FAddOp>(lane);
+        case llvm::Instruction::FSub: return lowerVectorFloat<FSubOp>(lane);
+        case llvm::Instruction::FMul: return lowerVectorFloat<FMulOp>(lane);
+        case llvm::Instruction::FDiv: return lowerVectorFloat<FDivOp>(lane);
+        case llvm::Instruction::FRem: return lowerVectorFloat<FRemOp>(lane);
+        case llvm::Instruction::Select: return lowerVectorSelect(lane);
+        case llvm::Instruction::ICmp:
+        {
+            auto cmp = static_cast<SALAM::ICmp *>(inst);
+            LaneType opLane = laneType(opReg, false);
+            LaneType opSigned = laneType(opReg, true);
+            if (opBits == 1) opSigned = BadLane;
+            switch (cmp->getPredicate()) {
+                case SALAM::Predicate::ICMP_EQ: return lowerVectorCmp<EqCmp>(opLane);
+                case SALAM::Predicate::ICMP_NE: return lowerVectorCmp<NeCmp>(opLane);
+                case SALAM::Predicate::ICMP_UGT: return lowerVectorCmp<GtCmp>(opLane);
+                case SALAM::Predicate::ICMP_UGE: return lowerVectorCmp<GeCmp>(opLane);
+                case SALAM::Predicate::ICMP_ULT: return lowerVectorCmp<LtCmp>(opLane);
+                case SALAM::Predicate::ICMP_ULE: return lowerVectorCmp<LeCmp>(opLane);
+                case SALAM::Predicate::ICMP_SGT: return lowerVectorCmp<GtCmp>(opSigned);
+                case SALAM::Predicate::ICMP_SGE: return lowerVectorCmp<GeCmp>(opSigned);
+                case SALAM::Predicate::ICMP_SLT: return lowerVectorCmp<LtCmp>(opSigned);
+                case SALAM::Predicate::ICMP_SLE: return lowerVectorCmp<LeCmp>(opSigned);
+                default: return nullptr;
+            }
+        }
+        case llvm::Instruction::FCmp:
+        {
+            auto cmp = static_cast<SALAM::FCmp *>(inst);
+            LaneType opLane = laneType(opReg, false);
+            if ((opLane != F32) && (opLane != F64)) return nullptr;
+            switch (cmp->getPredicate()) {
+                case SALAM::Predicate::FCMP_FALSE: return lowerVectorCmp<FalseCmp>(opLane);
+                case SALAM::Predicate::FCMP_OEQ: return lowerVectorCmp<OEqCmp>(opLane);
+                case SALAM::Predicate::FCMP_OGT: return lowerVectorCmp<OGtCmp>(opLane);
+                case SALAM::Predicate::FCMP_OGE: return lowerVectorCmp<OGeCmp>(opLane);
+                case SALAM::Predicate::FCMP_OLT: return lowerVectorCmp<OLtCmp>(opLane);
+                case SALAM::Predicate::FCMP_OLE: return lowerVectorCmp<OLeCmp>(opLane);
+                case SALAM::Predicate::FCMP_ONE: return lowerVectorCmp<ONeCmp>(opLane);
+                case SALAM::Predicate::FCMP_ORD: return lowerVectorCmp<OrdCmp>(opLane);
+                case SALAM::Predicate::FCMP_UNO: return lowerVectorCmp<UnoCmp>(opLane);
+                case SALAM::Predicate::FCMP_UEQ: return lowerVectorCmp<UEqCmp>(opLane);
+                case SALAM::Predicate::FCMP_UGT: return lowerVectorCmp<UGtCmp>(opLane);
+                case SALAM::Predicate::FCMP_UGE: return lowerVectorCmp<UGeCmp>(opLane);
+                case SALAM::Predicate::FCMP_ULT: return lowerVectorCmp<ULtCmp>(opLane);
+                case SALAM::Predicate::FCMP_ULE: return lowerVectorCmp<ULeCmp>(opLane);
+                case SALAM::Predicate::FCMP_UNE: return lowerVectorCmp<UNeCmp>(opLane);
+                case SALAM::Predicate::FCMP_TRUE: return lowerVectorCmp<TrueCmp>(opLane);
+                default: return nullptr;
+            }
+        }
+        case llvm::Instruction::Trunc:
+            if (bits == 1) return lowerVectorTruncToBool(laneType(opReg, false));
+            // Fall through
+        case llvm::Instruction::ZExt:
+        case llvm::Instruction::PtrToInt:
+        case llvm::Instruction::IntToPtr:
+        case llvm::Instruction::FPTrunc:
+        case llvm::Instruction::FPExt:
+        case llvm::Instruction::UIToFP:
+            return lowerVectorConvert(laneType(opReg, false), lane);
+        case llvm::Instruction::FPToUI:
+            return boolLanes ? nullptr : lowerVectorConvert(laneType(opReg, false), lane);
+        case llvm::Instruction::FPToSI:
+            return boolLanes ? nullptr : lowerVectorConvert(laneType(opReg, false), signedLane);
+        case llvm::Instruction::SExt:
+        case llvm::Instruction::SIToFP:
+            if (opBits == 1) return lowerVectorBoolSExt(result->isFP() ? lane : signedLane);
+            return lowerVectorConvert(laneType(opReg, true), result->isFP() ? lane : signedLane);
+        default:
+            return nullptr;
+    }
+}
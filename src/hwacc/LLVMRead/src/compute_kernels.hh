@@ -0,0 +1,31 @@
+#ifndef __SALAM_COMPUTE_KERNELS_HH__
+#define __SALAM_COMPUTE_KERNELS_HH__
+//------------------------------------------//
+#include "operand.hh"
+#include "registers.hh"
+//------------------------------------------//
+
+namespace SALAM
+{
+class Instruction;
+
+/*****************************************************************************
+* A ComputeKernel is the compute() of one static instruction specialized on
+* its opcode, bit width and floating point precision. Kernels receive the
+* operand array and the return register directly, so executing a dynamic
+* instance is a single indirect call with no type or size checks.
+*****************************************************************************/
+typedef void (*ComputeKernel)(SALAM::Operand *operands, SALAM::Register *result);
+
+// Resolve the kernel of a static instruction once the static graph has been
+// initialized. Returns nullptr when the instruction has to run its compute().
+ComputeKernel lowerComputeKernel(SALAM::Instruction *inst);
+
+// Vector instructions that operate lane by lane (arithmetic, comparisons,
+// casts and select) have no compute() and must be lowered to a vector kernel.
+bool isLaneWise(SALAM::Instruction *inst);
+// Returns nullptr when the lane types of the instruction are not supported.
+ComputeKernel lowerVectorKernel(SALAM::Instruction *inst);
+} // End SALAM Namespace
+
+#endif //__SALAM_COMPUTE_KERNELS_HH__
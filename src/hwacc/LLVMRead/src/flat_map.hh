@@ -0,0 +1,158 @@
+#ifndef __SALAM_FLAT_MAP_HH__
+#define __SALAM_FLAT_MAP_HH__
+//------------------------------------------//
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//------------------------------------------//
+
+namespace SALAM
+{
+/*****************************************************************************
+* FlatMap is an open-addressing hash map with linear probing for the small
+* integer and pointer keys used by the runtime queues. Entries live in one
+* contiguous slot array, so lookups touch one or two cache lines instead of
+* walking tree nodes. Erased slots become tombstones and are only reclaimed
+* when the table is rebuilt on insertion, which keeps iterators valid across
+* erase() and allows the `it = map.erase(it)` loops used with std::map.
+* Iteration order is unspecified.
+*****************************************************************************/
+template <class Key, class T>
+class FlatMap
+{
+    public:
+        typedef std::pair<Key, T> value_type;
+
+    private:
+        enum SlotState : uint8_t { Empty, Full, Deleted };
+
+        std::vector<value_type> slots;
+        std::vector<uint8_t> states;
+        size_t count = 0;
+        size_t tombstones = 0;
+
+        static uint64_t hashKey(const Key &key) {
+            uint64_t bits;
+            if constexpr (std::is_pointer<Key>::value) {
+                bits = reinterpret_cast<uintptr_t>(key);
+            } else {
+                bits = static_cast<uint64_t>(key);
+            }
+            // Fibonacci hashing spreads sequential UIDs and aligned pointers,
+            // fold the high bits back down since the table is indexed by mask
+            bits *= 0x9E3779B97F4A7C15ULL;
+            return bits ^ (bits >> 32);
+        }
+
+        size_t mask() const { return slots.size() - 1; }
+
+        size_t findSlot(const Key &key) const {
+            if (slots.empty()) return slots.size();
+            for (size_t i = hashKey(key) & mask(); ; i = (i + 1) & mask()) {
+                if (states[i] == Empty) return slots.size();
+                if ((states[i] == Full) && (slots[i].first == key)) return i;
+            }
+        }
+
+        void rehash(size_t capacity) {
+            std::vector<value_type> oldSlots(capacity);
+            std::vector<uint8_t> oldStates(capacity, Empty);
+            oldSlots.swap(slots);
+            oldStates.swap(states);
+            tombstones = 0;
+            for (size_t i = 0; i < oldSlots.size(); i++) {
+                if (oldStates[i] != Full) continue;
+                size_t j = hashKey(oldSlots[i].first) & mask();
+                while (states[j] == Full) j = (j + 1) & mask();
+                slots[j] = std::move(oldSlots[i]);
+                states[j] = Full;
+            }
+        }
+
+    public:
+        class iterator
+        {
+            friend class FlatMap;
+            private:
+                FlatMap *map;
+                size_t index;
+                void skip() {
+                    while ((index < map->slots.size()) &&
+                           (map->states[index] != Full)) index++;
+                }
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef typename FlatMap::value_type value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef value_type * pointer;
+                typedef value_type & reference;
+
+                iterator(FlatMap *_map, size_t _index) :
+                    map(_map), index(_index) { skip(); }
+                reference operator*() const { return map->slots[index]; }
+                pointer operator->() const { return &(map->slots[index]); }
+                iterator &operator++() { index++; skip(); return *this; }
+                iterator operator++(int) { iterator it = *this; ++(*this); return it; }
+                bool operator==(const iterator &other) const { return index == other.index; }
+                bool operator!=(const iterator &other) const { return index != other.index; }
+        };
+
+        FlatMap() = default;
+        ~FlatMap() = default;
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, slots.size()); }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        iterator find(const Key &key) { return iterator(this, findSlot(key)); }
+        bool contains(const Key &key) const { return findSlot(key) != slots.size(); }
+
+        // Like std::map::insert, an existing entry is left untouched
+        std::pair<iterator, bool> insert(const value_type &entry) {
+            size_t existing = findSlot(entry.first);
+            if (existing != slots.size()) return {iterator(this, existing), false};
+            // Keep the table at most half full, counting tombstones
+            if (2 * (count + tombstones + 1) > slots.size()) {
+                size_t capacity = slots.empty() ? 16 : slots.size();
+                while (4 * (count + 1) > capacity) capacity <<= 1;
+                rehash(capacity);
+            }
+            size_t i = hashKey(entry.first) & mask();
+            while (states[i] == Full) i = (i + 1) & mask();
+            if (states[i] == Deleted) tombstones--;
+            slots[i] = entry;
+            states[i] = Full;
+            count++;
+            return {iterator(this, i), true};
+        }
+
+        iterator erase(iterator it) {
+            // Release the value right away, it may be holding a reference
+            it->second = T();
+            states[it.index] = Deleted;
+            count--;
+            tombstones++;
+            return ++it;
+        }
+
+        size_t erase(const Key &key) {
+            size_t i = findSlot(key);
+            if (i == slots.size()) return 0;
+            erase(iterator(this, i));
+            return 1;
+        }
+
+        void clear() {
+            slots.clear();
+            states.clear();
+            count = 0;
+            tombstones = 0;
+        }
+};
+} // End SALAM Namespace
+
+#endif //__SALAM_FLAT_MAP_HH__
@@ -0,0 +1,124 @@
+//------------------------------------------//
+#include "graph_cache.hh"
+//------------------------------------------//
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+//------------------------------------------//
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+
+const char graphCacheMagic[8] = {'S', 'A', 'L', 'A', 'M', 'G', 'C', '\0'};
+// Bump whenever the entry layout or the cached analyses change
+const uint32_t graphCacheVersion = 1;
+
+struct GraphCacheHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t llvmVersion;
+    uint64_t irHash;
+    uint64_t numLatches;
+    uint64_t bitcodeSize;
+};
+
+} // anonymous namespace
+
+SALAM::GraphCache::GraphCache(const std::string &dir, const std::string &irFile)
+{
+    if (dir.empty()) return;
+    auto ir = llvm::MemoryBuffer::getFile(irFile);
+    if (!ir) return;
+    irHash = llvm::xxHash64((*ir)->getBuffer());
+
+    std::stringstream name;
+    name << llvm::sys::path::stem(irFile).str() << "." << std::hex << irHash << ".sgc";
+    llvm::SmallString<256> entry(dir);
+    llvm::sys::path::append(entry, name.str());
+    cachePath = entry.str().str();
+}
+
+std::unique_ptr<llvm::Module>
+SALAM::GraphCache::load(llvm::LLVMContext &context,
+                        std::vector<uint64_t> &latches)
+{
+    if (!enabled()) return nullptr;
+    // Entries are large enough for the buffer to be memory-mapped
+    auto buffer = llvm::MemoryBuffer::getFile(cachePath);
+    if (!buffer) return nullptr;
+    llvm::StringRef data = (*buffer)->getBuffer();
+
+    GraphCacheHeader header;
+    if (data.size() < sizeof(header)) return nullptr;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, graphCacheMagic, sizeof(graphCacheMagic)) ||
+        (header.version != graphCacheVersion) ||
+        (header.llvmVersion != LLVM_VERSION_MAJOR) ||
+        (header.irHash != irHash)) return nullptr;
+    size_t latchBytes = header.numLatches * sizeof(uint64_t);
+    if (data.size() != sizeof(header) + latchBytes + header.bitcodeSize) return nullptr;
+
+    latches.resize(header.numLatches);
+    std::memcpy(latches.data(), data.data() + sizeof(header), latchBytes);
+
+    llvm::MemoryBufferRef bitcode(data.substr(sizeof(header) + latchBytes), cachePath);
+    auto module = llvm::parseBitcodeFile(bitcode, context);
+    if (!module) {
+        llvm::consumeError(module.takeError());
+        latches.clear();
+        return nullptr;
+    }
+    return std::move(*module);
+}
+
+bool
+SALAM::GraphCache::store(const llvm::Module &module,
+                         const std::vector<uint64_t> &latches)
+{
+    if (!enabled()) return false;
+    llvm::SmallVector<char, 0> bitcode;
+    llvm::raw_svector_ostream bitcodeStream(bitcode);
+    llvm::WriteBitcodeToFile(module, bitcodeStream);
+
+    GraphCacheHeader header;
+    std::memcpy(header.magic, graphCacheMagic, sizeof(graphCacheMagic));
+    header.version = graphCacheVersion;
+    header.llvmVersion = LLVM_VERSION_MAJOR;
+    header.irHash = irHash;
+    header.numLatches = latches.size();
+    header.bitcodeSize = bitcode.size();
+
+    if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(cachePath)))
+        return false;
+    int fd;
+    llvm::SmallString<256> tmpPath;
+    if (llvm::sys::fs::createUniqueFile(cachePath + ".%%%%%%.tmp", fd, tmpPath))
+        return false;
+    {
+        llvm::raw_fd_ostream out(fd, true);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(latches.data()),
+                  latches.size() * sizeof(uint64_t));
+        out.write(bitcode.data(), bitcode.size());
+        out.close();
+        if (out.has_error()) {
+            out.clear_error();
+            llvm::sys::fs::remove(tmpPath);
+            return false;
+        }
+    }
+    if (llvm::sys::fs::rename(tmpPath, cachePath)) {
+        llvm::sys::fs::remove(tmpPath);
+        return false;
+    }
+    return true;
+}
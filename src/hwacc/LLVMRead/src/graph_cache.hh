@@ -0,0 +1,48 @@
+#ifndef __SALAM_GRAPH_CACHE_HH__
+#define __SALAM_GRAPH_CACHE_HH__
+//------------------------------------------//
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+//------------------------------------------//
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+//------------------------------------------//
+
+namespace SALAM
+{
+/*****************************************************************************
+* GraphCache keeps a compact binary form of the parsed IR next to the static
+* analysis results, so repeated simulations of the same kernel skip parsing
+* the textual .ll file and running LoopInfo on every function.
+*
+* An entry is keyed by the hash of the IR file contents and the LLVM version.
+* It holds the value IDs of the loop latching branches followed by the module
+* bitcode, and is memory-mapped on load. Hardware configuration (cycle counts,
+* functional units, kernels) is applied while the SALAM graph is rebuilt from
+* the module, so one entry serves a whole design space sweep.
+*****************************************************************************/
+class GraphCache
+{
+    private:
+        std::string cachePath;
+        uint64_t irHash = 0;
+
+    public:
+        // An empty directory disables the cache
+        GraphCache(const std::string &dir, const std::string &irFile);
+        ~GraphCache() = default;
+        bool enabled() const { return !cachePath.empty(); }
+        const std::string &path() const { return cachePath; }
+        // Returns nullptr when there is no valid entry for the IR file
+        std::unique_ptr<llvm::Module> load(llvm::LLVMContext &context,
+                                           std::vector<uint64_t> &latches);
+        // Entries are written to a temporary file and renamed into place, so
+        // concurrent simulations never observe a partial entry
+        bool store(const llvm::Module &module,
+                   const std::vector<uint64_t> &latches);
+};
+} // End SALAM Namespace
+
+#endif //__SALAM_GRAPH_CACHE_HH__
@@ -0,0 +1,67 @@
+#ifndef __SALAM_INFLIGHT_INDEX_HH__
+#define __SALAM_INFLIGHT_INDEX_HH__
+//------------------------------------------//
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+//------------------------------------------//
+
+namespace SALAM
+{
+/*****************************************************************************
+* InFlightIndex tracks the dynamic instances of each static instruction that
+* are still in flight in an ActiveFunction, i.e. sitting in the reservation,
+* compute, read or write queues. Instances are recorded in scheduling order,
+* so the latest instance of a static UID is the one a newly scheduled
+* instruction has to link against. Lookups replace the reverse scan of the
+* reservation queue and are independent of the reservation depth.
+*****************************************************************************/
+template <class InstPtr>
+class InFlightIndex
+{
+    private:
+        typedef std::vector<InstPtr> instanceListTy;
+        std::unordered_map<uint64_t, instanceListTy> instances;
+        size_t inFlight = 0;
+
+    public:
+        InFlightIndex() = default;
+        ~InFlightIndex() = default;
+
+        // Record a newly scheduled instance
+        void insert(const InstPtr &inst) {
+            instances[inst->getUID()].push_back(inst);
+            inFlight++;
+        }
+
+        // Drop an instance once it has left every runtime queue
+        void remove(const InstPtr &inst) {
+            auto it = instances.find(inst->getUID());
+            if (it == instances.end()) return;
+            instanceListTy &list = it->second;
+            // Instances mostly retire oldest first, but a newer instance
+            // may overtake an older one that is still waiting on operands
+            for (auto list_it = list.begin(); list_it != list.end(); ++list_it) {
+                if (*list_it == inst) {
+                    list.erase(list_it);
+                    inFlight--;
+                    return;
+                }
+            }
+        }
+
+        // Latest in-flight instance of the static instruction, or nullptr
+        InstPtr latest(uint64_t uid) const {
+            auto it = instances.find(uid);
+            if ((it == instances.end()) || it->second.empty()) return nullptr;
+            return it->second.back();
+        }
+
+        size_t size() const { return inFlight; }
+        bool empty() const { return inFlight == 0; }
+        void clear() { instances.clear(); inFlight = 0; }
+};
+} // End SALAM Namespace
+
+#endif //__SALAM_INFLIGHT_INDEX_HH__
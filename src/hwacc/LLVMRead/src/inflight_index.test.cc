@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "hwacc/LLVMRead/src/inflight_index.hh"
+
+/*
+ * Correctness checks for InFlightIndex and a microbenchmark comparing it to
+ * the reverse scan of the reservation queue that findDynamicDeps used to do.
+ * The benchmark schedules a synthetic, deeply unrolled basic block and
+ * reports the host time spent linking dependencies per scheduled instruction.
+ */
+
+namespace
+{
+
+struct MockInst
+{
+    uint64_t uid;
+    std::vector<uint64_t> deps;
+    std::vector<std::shared_ptr<MockInst>> links;
+    uint64_t getUID() const { return uid; }
+};
+
+typedef std::shared_ptr<MockInst> MockInstPtr;
+
+// A basic block with `width` independent chains unrolled `depth` times.
+// Each instruction depends on the previous instruction of its chain, on an
+// instruction of the neighbouring chain and on a function argument that is
+// never in flight, mimicking an unrolled loop body.
+std::vector<MockInstPtr>
+unrolledBB(uint64_t width, uint64_t depth)
+{
+    std::vector<MockInstPtr> bb;
+    for (uint64_t d = 0; d < depth; d++) {
+        for (uint64_t w = 0; w < width; w++) {
+            auto inst = std::make_shared<MockInst>();
+            inst->uid = d * width + w;
+            inst->deps.push_back(width * depth);
+            if (d > 0) {
+                inst->deps.push_back((d - 1) * width + w);
+                inst->deps.push_back((d - 1) * width + ((w + 1) % width));
+            }
+            bb.push_back(inst);
+        }
+    }
+    return bb;
+}
+
+MockInstPtr
+cloneInst(const MockInstPtr &inst)
+{
+    auto clone = std::make_shared<MockInst>();
+    clone->uid = inst->uid;
+    clone->deps = inst->deps;
+    return clone;
+}
+
+// Original algorithm: reverse scan the reservation queue
+void
+scanLink(std::list<MockInstPtr> &reservation, const MockInstPtr &inst)
+{
+    std::vector<uint64_t> dep_uids = inst->deps;
+    auto queue_iter = reservation.rbegin();
+    while ((queue_iter != reservation.rend()) && !dep_uids.empty()) {
+        auto queued_inst = *queue_iter;
+        for (auto dep_it = dep_uids.begin(); dep_it != dep_uids.end();) {
+            if (queued_inst->getUID() == *dep_it) {
+                inst->links.push_back(queued_inst);
+                dep_it = dep_uids.erase(dep_it);
+            } else {
+                dep_it++;
+            }
+        }
+        queue_iter++;
+    }
+}
+
+void
+indexLink(SALAM::InFlightIndex<MockInstPtr> &index, const MockInstPtr &inst)
+{
+    for (auto dep : inst->deps) {
+        auto queued_inst = index.latest(dep);
+        if (queued_inst) inst->links.push_back(queued_inst);
+    }
+}
+
+} // anonymous namespace
+
+TEST(InFlightIndex, LatestInstance)
+{
+    SALAM::InFlightIndex<MockInstPtr> index;
+    auto a = std::make_shared<MockInst>();
+    a->uid = 7;
+    auto b = cloneInst(a);
+
+    EXPECT_EQ(index.latest(7), nullptr);
+    index.insert(a);
+    index.insert(b);
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_EQ(index.latest(7), b);
+
+    // The newer instance retiring first exposes the older one again
+    index.remove(b);
+    EXPECT_EQ(index.latest(7), a);
+    index.remove(a);
+    EXPECT_EQ(index.latest(7), nullptr);
+    EXPECT_TRUE(index.empty());
+
+    // Removing an instance that is not tracked is a no-op
+    index.remove(a);
+    EXPECT_TRUE(index.empty());
+}
+
+TEST(InFlightIndex, MatchesReservationScan)
+{
+    auto bb = unrolledBB(8, 64);
+    std::list<MockInstPtr> reservation;
+    SALAM::InFlightIndex<MockInstPtr> index;
+
+    // Schedule the block three times so older instances are in flight
+    for (int iter = 0; iter < 3; iter++) {
+        for (auto &inst : bb) {
+            auto scanned = cloneInst(inst);
+            auto indexed = cloneInst(inst);
+            scanLink(reservation, scanned);
+            indexLink(index, indexed);
+            ASSERT_EQ(scanned->links.size(), indexed->links.size());
+            for (auto &link : indexed->links) {
+                bool found = false;
+                for (auto &other : scanned->links)
+                    found |= (link == other);
+                EXPECT_TRUE(found);
+            }
+            reservation.push_back(indexed);
+            index.insert(indexed);
+        }
+    }
+}
+
+TEST(InFlightIndex, SchedulingMicrobenchmark)
+{
+    const uint64_t width = 16;
+    const uint64_t iterations = 4;
+    for (uint64_t depth : {16, 64, 256}) {
+        auto bb = unrolledBB(width, depth);
+        const uint64_t scheduled = bb.size() * iterations;
+
+        std::list<MockInstPtr> reservation;
+        auto scanStart = std::chrono::high_resolution_clock::now();
+        for (uint64_t iter = 0; iter < iterations; iter++) {
+            for (auto &inst : bb) {
+                auto clone = cloneInst(inst);
+                scanLink(reservation, clone);
+                reservation.push_back(clone);
+            }
+        }
+        auto scanStop = std::chrono::high_resolution_clock::now();
+
+        SALAM::InFlightIndex<MockInstPtr> index;
+        auto indexStart = std::chrono::high_resolution_clock::now();
+        for (uint64_t iter = 0; iter < iterations; iter++) {
+            for (auto &inst : bb) {
+                auto clone = cloneInst(inst);
+                indexLink(index, clone);
+                index.insert(clone);
+            }
+        }
+        auto indexStop = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double, std::nano> scanTime = scanStop - scanStart;
+        std::chrono::duration<double, std::nano> indexTime = indexStop - indexStart;
+        std::cout << "Reservation Depth: " << scheduled
+                  << "   Scan: " << scanTime.count() / scheduled << " ns/inst"
+                  << "   Indexed: " << indexTime.count() / scheduled << " ns/inst"
+                  << std::endl;
+        EXPECT_EQ(index.size(), scheduled);
+    }
+}
@@ -122,9 +122,15 @@ SALAM::Instruction::signalUsers()
 void
 SALAM::Instruction::removeDynamicDependency(uint64_t opuid)
 {
-    auto end = dynamicDependencies.end();
-    auto it = dynamicDependencies.find(opuid);
-    if (it != end) dynamicDependencies.erase(it);
+    for (auto it = dynamicDependencies.begin(); it != dynamicDependencies.end(); ++it) {
+        if ((*it)->getUID() == opuid) {
+            // Order does not matter, swap with the last entry and pop
+            std::swap(*it, dynamicDependencies.back());
+            dynamicDependencies.pop_back();
+            if (dynamicDependencies.empty() && wakeup) wakeup();
+            return;
+        }
+    }
 }
 
 bool
@@ -148,21 +154,17 @@ bool
 SALAM::Instruction::launch()
 {
     if (hasFunctionalUnit()) {
-        if(!hw_interface->availableFunctionalUnit(getFunctionalUnit())) {
-            return false;
-            std::cout << "Waiting on next available FU\n"; 
-        } else {
-            
-        }
+        // The scheduler only launches once a unit is available
+        hw_interface->useFunctionalUnit(getFunctionalUnit(), getCycleCount());
     }
     launched = true;
     if (getCycleCount() == 0) { // Instruction ready to be committed
         if (dbg) DPRINTFS(Runtime, owner, "||  0 Cycle Instruction\n");
-        compute();
+        execute();
         commit();
     } else {
         currentCycle++;
-        compute();
+        execute();
     }
     if (dbg) DPRINTFS(Runtime, owner, "||==Return: %s\n", isCommitted() ? "true" : "false");
     if (dbg) DPRINTFS(Runtime, owner, "||==launch================\n");
@@ -178,14 +180,8 @@ SALAM::Instruction::commit()
         committed = true;
         if (dbg) DPRINTFS(Runtime, owner, "||==Return: %s\n", committed ? "true" : "false");
         if (dbg) DPRINTFS(Runtime, owner, "||==commit================\n");
-        //std::cout << "\n\n\nTest 3 - FU[" << getFunctionalUnit() << "]\n\n\n";
-        if (hasFunctionalUnit()) {
-            //std::cout << "\n\n\nTest 2\n\n\n";
-            hw_interface->clearFunctionalUnit(getFunctionalUnit());
-           // hw_interface->functional_units->
-        } else {
-            // 
-        }
+        // Functional units are released by HWInterface once their
+        // occupancy has elapsed
         return true;
     } else {
         if (dbg) DPRINTFS(Runtime, owner, "||  Remaining Cycles: %i\n", getCycleCount() - getCurrentCycle());
@@ -201,7 +197,7 @@ SALAM::Instruction::setOperandValue(uint64_t opuid)
 {
     uint64_t count = 0;
     for (auto it = operands.begin(); it != operands.end(); ++it) {
-        auto op = *it;
+        auto &op = *it;
         if (op.getUID() == opuid) {
             if (dbg) DPRINTFS(Runtime, owner, "|| Storing Value in Op[%i]\n", count++);
             op.updateOperandRegister();
@@ -217,6 +213,9 @@ SALAM::Instruction::reset() {
     launched = false;
     committed = false;
     currentCycle = 0;
+    dynamicDependencies.clear();
+    dynamicUsers.clear();
+    wakeup = nullptr;
     if (dbg) DPRINTFS(Runtime, owner, "||==reset=================\n");
 }
 
@@ -234,12 +233,20 @@ SALAM::Instruction::runtimeInitialize() {
     //std::deque<uint64_t> dep_uids;
     std::vector<uint64_t> dep_uids;
 
-    for (auto it = staticDependencies.begin(); it != staticDependencies.end(); ++it) {
-        std::shared_ptr<SALAM::Value> static_dependency = *it;
+    // Instances recycled by the InstructionPool keep the operands that were
+    // built for their static dependencies, so only the values are refreshed
+    bool reuseOperands = (operands.size() == staticDependencies.size());
+    if (!reuseOperands) {
+        operands.clear();
+        operands.reserve(staticDependencies.size());
+    }
+
+    for (size_t i = 0; i < staticDependencies.size(); i++) {
+        std::shared_ptr<SALAM::Value> static_dependency = staticDependencies.at(i);
         auto dep_uid = static_dependency->getUID();
-        operands.push_back(SALAM::Operand(static_dependency));
+        if (!reuseOperands) operands.emplace_back(static_dependency);
         if ((static_dependency->isConstant()) || (static_dependency->isArgument())) {
-            operands.back().updateOperandRegister();
+            operands.at(i).updateOperandRegister();
         } else {
             dep_uids.push_back(dep_uid);
         }
@@ -1981,26 +1988,28 @@ Store::createMemoryRequest() {
 
     MemoryRequest * req;
 
-    auto dataRegister = operands.at(0).getOpRegister();
+    auto &dataRegister = operands.at(0).getOpRegister();
     // Copy data from the register
-    if (dataRegister->isPtr()) {
-        uint64_t regData = dataRegister->getPtrData();
+    if (dataRegister.isVector()) {
+        req = new MemoryRequest(memAddr, dataRegister.getVectorData(), reqLen);
+    } else if (dataRegister.isPtr()) {
+        uint64_t regData = dataRegister.getPtrData();
         req = new MemoryRequest(memAddr, (uint8_t *)&regData, reqLen);
     } else {
     #if USE_LLVM_AP_VALUES
         llvm::APInt regAPData;
-        if (dataRegister->isInt()) {
-            regAPData = (dataRegister->getIntData());
+        if (dataRegister.isInt()) {
+            regAPData = (dataRegister.getIntData());
         } else {
-            regAPData = dataRegister->getFloatData().bitcastToAPInt();
+            regAPData = dataRegister.getFloatData().bitcastToAPInt();
         }
         req = new MemoryRequest(memAddr, regAPData.getRawData(), reqLen);
     #else
         uint64_t regData;
-        if (dataRegister->isInt()) {
-            regData = dataRegister->getIntData();
+        if (dataRegister.isInt()) {
+            regData = dataRegister.getIntData();
         } else {
-            regData = dataRegister->getFloatData();
+            regData = dataRegister.getFloatData();
         }
         req = new MemoryRequest(memAddr, (uint8_t *)&regData, reqLen);
     #endif
@@ -2840,13 +2849,10 @@ BitCast::initialize(llvm::Value * irval,
 
 void
 BitCast::compute() {
-#if USE_LLVM_AP_VALUES
-    auto opdata = operands.front().getPtrRegValue();
+    // Scalar casts keep the bits, pointer casts the address. Casts from or
+    // to vectors always run the vector kernel.
+    auto opdata = operands.front().getOpRegister().getRawData();
     setRegisterValue(opdata);
-#else
-    auto opdata = operands.front().getPtrRegValue();
-    setRegisterValue(opdata);
-#endif
 }
 
 // SALAM-ICmp // ------------------------------------------------------------//
@@ -3232,6 +3238,8 @@ Phi::runtimeInitialize() {
     if (it != phiArgs.end()) static_dependency = it->second;
     else assert(0 && "Previous BasicBlock not found in PHI args");
 
+    // The incoming value depends on the predecessor, so never reuse operands
+    operands.clear();
     auto dep_uid = static_dependency->getUID();
     operands.push_back(SALAM::Operand(static_dependency));
     if ((static_dependency->isConstant()) || (static_dependency->isArgument())) {
@@ -3374,13 +3382,165 @@ Select::compute() {
 #if USE_LLVM_AP_VALUES
     auto resultReg = (cond.getIntRegValue().isOneValue()) ? trueVal.getOpRegister() : falseVal.getOpRegister();
 #else
-    auto resultReg = (cond.getUIntRegValue() == 1) ? trueVal.getOpRegister() : falseVal.getOpRegister();
+    auto &resultReg = (cond.getUIntRegValue() == 1) ? trueVal.getOpRegister() : falseVal.getOpRegister();
     if (dbg) DPRINTFS(RuntimeCompute, owner, "|| Selecting %s condition\n", (cond.getUIntRegValue() == 1) ? "TRUE" : "FALSE");
     if (dbg) DPRINTFS(RuntimeCompute, owner, "|| %s = %s\n", ir_stub, (cond.getUIntRegValue() == 1) ? trueVal.getIRStub() : falseVal.getIRStub());
 #endif
     setRegisterValue(resultReg);
 }
 
+// SALAM-ExtractElement // --------------------------------------------------//
+void // Debugging Interface
+ExtractElement::dumper() {
+
+}
+
+std::shared_ptr<SALAM::Instruction>
+createExtractElementInst(uint64_t id, gem5::SimObject * owner, bool dbg,
+              uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu) {
+    return std::make_shared<SALAM::ExtractElement>(id, owner, dbg, OpCode, cycles, fu);
+}
+
+ExtractElement::ExtractElement(uint64_t id, gem5::SimObject * owner, bool dbg,
+         uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu) :
+         Instruction(id, owner, dbg, OpCode, cycles,fu)
+{
+    std::vector<uint64_t> base_params;
+    base_params.push_back(id);
+    base_params.push_back(OpCode);
+    base_params.push_back(cycles);
+    conditions.push_back(base_params);
+}
+
+void
+ExtractElement::initialize(llvm::Value * irval,
+                irvmap * irmap,
+                SALAM::valueListTy * valueList) {
+    SALAM::Instruction::initialize(irval, irmap, valueList);
+    // ****** //
+}
+
+void
+ExtractElement::compute() {
+    if (dbg) DPRINTFS(RuntimeCompute, owner, "|| Computing %s\n", ir_string);
+    auto &vec = operands.at(0).getOpRegister();
+    uint64_t lane = operands.at(1).getUIntRegValue();
+    // An out of range index yields poison, read it as zero
+    uint64_t result = (lane < vec.getLanes()) ? vec.getLane(lane) : 0;
+    if (dbg) DPRINTFS(RuntimeCompute, owner, "|| %s = %s[%d]\n", ir_stub, operands.at(0).getIRStub(), lane);
+    setRegisterValue(result);
+}
+
+// SALAM-InsertElement // ---------------------------------------------------//
+void // Debugging Interface
+InsertElement::dumper() {
+
+}
+
+std::shared_ptr<SALAM::Instruction>
+createInsertElementInst(uint64_t id, gem5::SimObject * owner, bool dbg,
+              uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu) {
+    return std::make_shared<SALAM::InsertElement>(id, owner, dbg, OpCode, cycles, fu);
+}
+
+InsertElement::InsertElement(uint64_t id, gem5::SimObject * owner, bool dbg,
+         uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu) :
+         Instruction(id, owner, dbg, OpCode, cycles,fu)
+{
+    std::vector<uint64_t> base_params;
+    base_params.push_back(id);
+    base_params.push_back(OpCode);
+    base_params.push_back(cycles);
+    conditions.push_back(base_params);
+}
+
+void
+InsertElement::initialize(llvm::Value * irval,
+                irvmap * irmap,
+                SALAM::valueListTy * valueList) {
+    SALAM::Instruction::initialize(irval, irmap, valueList);
+    // ****** //
+}
+
+void
+InsertElement::compute() {
+    if (dbg) DPRINTFS(RuntimeCompute, owner, "|| Computing %s\n", ir_string);
+    auto &vec = operands.at(0).getOpRegister();
+    auto &elem = operands.at(1).getOpRegister();
+    uint64_t lane = operands.at(2).getUIntRegValue();
+    uint8_t *result = returnReg->getVectorBuffer();
+    std::memcpy(result, vec.getVectorData(), getSizeInBytes());
+    if (lane < lanes) {
+        uint64_t data = elem.getRawData();
+        std::memcpy(result + lane * returnReg->getLaneBytes(), &data, returnReg->getLaneBytes());
+    }
+    if (dbg) DPRINTFS(RuntimeCompute, owner, "|| %s = %s\n", ir_stub, returnReg->dataString());
+}
+
+// SALAM-ShuffleVector // ---------------------------------------------------//
+void // Debugging Interface
+ShuffleVector::dumper() {
+
+}
+
+std::shared_ptr<SALAM::Instruction>
+createShuffleVectorInst(uint64_t id, gem5::SimObject * owner, bool dbg,
+              uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu) {
+    return std::make_shared<SALAM::ShuffleVector>(id, owner, dbg, OpCode, cycles, fu);
+}
+
+ShuffleVector::ShuffleVector(uint64_t id, gem5::SimObject * owner, bool dbg,
+         uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu) :
+         Instruction(id, owner, dbg, OpCode, cycles,fu)
+{
+    std::vector<uint64_t> base_params;
+    base_params.push_back(id);
+    base_params.push_back(OpCode);
+    base_params.push_back(cycles);
+    conditions.push_back(base_params);
+}
+
+void
+ShuffleVector::initialize(llvm::Value * irval,
+                irvmap * irmap,
+                SALAM::valueListTy * valueList) {
+    SALAM::Instruction::initialize(irval, irmap, valueList);
+    llvm::ShuffleVectorInst * inst = llvm::dyn_cast<llvm::ShuffleVectorInst>(irval);
+    assert(inst);
+    llvm::SmallVector<int, 16> shuffleMask;
+    inst->getShuffleMask(shuffleMask);
+    mask.assign(shuffleMask.begin(), shuffleMask.end());
+}
+
+void
+ShuffleVector::compute() {
+    if (dbg) DPRINTFS(RuntimeCompute, owner, "|| Computing %s\n", ir_string);
+    auto &lhs = operands.at(0).getOpRegister();
+    auto &rhs = operands.at(1).getOpRegister();
+    int srcLanes = lhs.getLanes();
+    size_t laneBytes = returnReg->getLaneBytes();
+    uint8_t *result = returnReg->getVectorBuffer();
+    for (size_t i = 0; i < mask.size(); i++) {
+        int src = mask[i];
+        uint64_t data = 0;
+        if (src >= 0) data = (src < srcLanes) ? lhs.getLane(src) : rhs.getLane(src - srcLanes);
+        std::memcpy(result + i * laneBytes, &data, laneBytes);
+    }
+    if (dbg) DPRINTFS(RuntimeCompute, owner, "|| %s = %s\n", ir_stub, returnReg->dataString());
+}
+
 } // namespace SALAM
 
 //---------------------------------------------------------------------------//
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __HWACC_LLVM_INSTRUCTION_HH__
 
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <llvm/IR/Value.h>
 #include <llvm/IR/Instruction.h>
@@ -11,6 +12,7 @@
 #include "debug_flags.hh"
 #include "value.hh"
 #include "mem_request.hh"
+#include "compute_kernels.hh"
 #include "../../HWModeling/src/hw_interface.hh"
 
 namespace SALAM {
@@ -25,13 +27,26 @@ class BasicBlock; // Required Declaration
 class Instruction : public Value
 {
     private:
-        std::map<uint64_t, std::shared_ptr<SALAM::Instruction>> dynamicDependencies;
+        // Few dependencies are outstanding at once, so a flat vector
+        // searched by UID beats a node-based map
+        std::vector<std::shared_ptr<SALAM::Instruction>> dynamicDependencies;
         std::vector<std::shared_ptr<SALAM::Instruction>> dynamicUsers;
         uint64_t llvmOpCode;
         uint64_t cycleCount;
         uint64_t currentCycle;
         uint64_t functional_unit = 0;
-        HWInterface* hw_interface;
+        HWInterface* hw_interface = nullptr;
+        // Invoked when the last dynamic dependency is removed
+        std::function<void()> wakeup;
+        // Specialized compute(), resolved when the static graph is built
+        ComputeKernel kernel = nullptr;
+        // Lane-wise vector instructions have no compute() to fall back on
+        bool laneWise = false;
+
+        void execute() {
+            if (kernel && (laneWise || !dbg)) kernel(operands.data(), returnReg);
+            else compute();
+        }
 
     protected:
         valueListTy staticDependencies;
@@ -64,20 +79,31 @@ class Instruction : public Value
         virtual uint64_t getCycleCount() { return cycleCount; }
         virtual uint64_t getOpode() { return llvmOpCode; }
         uint64_t getCurrentCycle() { return currentCycle; }
+        // Skip the remaining compute cycles so the next commit() succeeds
+        void fastForward() { currentCycle = getCycleCount(); }
+        void setWakeup(std::function<void()> callback) { wakeup = callback; }
         virtual valueListTy getStaticDependencies() const { return staticDependencies; }
-        std::map<uint64_t, std::shared_ptr<SALAM::Instruction>> getDynamicDependencies() const { return dynamicDependencies; }
+        std::map<uint64_t, std::shared_ptr<SALAM::Instruction>> getDynamicDependencies() const {
+            std::map<uint64_t, std::shared_ptr<SALAM::Instruction>> deps;
+            for (auto &dep : dynamicDependencies) deps.insert({dep->getUID(), dep});
+            return deps;
+        }
         std::shared_ptr<SALAM::Value> getStaticDependencies(int i) const { return staticDependencies.at(i); }
-        std::shared_ptr<SALAM::Value> getDynamicDependencies(int i) const { return dynamicDependencies.at(i); }
+        std::shared_ptr<SALAM::Value> getDynamicDependencies(int i) const {
+            for (auto &dep : dynamicDependencies) if (dep->getUID() == (uint64_t)i) return dep;
+            return nullptr;
+        }
         virtual std::vector<uint64_t> runtimeInitialize();
         void removeDynamicDependency(uint64_t opuid);
         void addRuntimeDependency(std::shared_ptr<SALAM::Instruction> dep) {
-            dynamicDependencies.insert({dep->getUID(),dep});
+            for (auto &existing : dynamicDependencies)
+                if (existing->getUID() == dep->getUID()) return;
+            dynamicDependencies.push_back(dep);
         }
         void addRuntimeUser(std::shared_ptr<SALAM::Instruction> dep) { dynamicUsers.push_back(dep); }
         void signalUsers();
         bool isCommitted() { return committed; }
-        //bool hasFunctionalUnit() { return (functional_unit != 0); }
-        bool hasFunctionalUnit() { return false; }
+        bool hasFunctionalUnit() { return (functional_unit != 0) && hw_interface; }
         bool debug() { return dbg; }
         void linkOperands(const SALAM::Operand &newOp);
         std::vector<SALAM::Operand> * getOperands() { return &operands; }
@@ -100,7 +126,10 @@ class Instruction : public Value
         virtual bool isInstruction() { return true; }
         virtual bool isLoadingInternal() { return false; }
         virtual bool isLatchingBrExiting() { return false; }
-        // virtual void linkFunctionalUnit(HWInterface * hw_interface);
+        void linkFunctionalUnit(HWInterface * hw) { hw_interface = hw; }
+        void setComputeKernel(ComputeKernel k) { kernel = k; }
+        void setVectorKernel(ComputeKernel k) { kernel = k; laneWise = true; }
+        bool hasComputeKernel() { return kernel != nullptr; }
         std::shared_ptr<SALAM::Instruction> clone() const { return std::static_pointer_cast<SALAM::Instruction>(createClone()); }
         virtual std::shared_ptr<SALAM::Value> createClone() const override { return std::shared_ptr<SALAM::Instruction>(new SALAM::Instruction(*this)); }
         virtual MemoryRequest * createMemoryRequest() { return nullptr; }
@@ -1398,6 +1427,7 @@ class ICmp : public Instruction {
                         irvmap * irmap,
                         SALAM::valueListTy * valueList);
         uint64_t getCycleCount() { return conditions.at(0).at(2); }
+        uint64_t getPredicate() { return predicate; }
         void compute();
         void dump() { if (dbgr->enabled()) { dumper(); inst_dbg->dumper(static_cast<SALAM::Instruction*>(this));}}
         void dumper();
@@ -1432,6 +1462,7 @@ class FCmp : public Instruction {
                         irvmap * irmap,
                         SALAM::valueListTy * valueList);
         uint64_t getCycleCount() { return conditions.at(0).at(2); }
+        uint64_t getPredicate() { return predicate; }
         void compute();
         void dump() { if (dbgr->enabled()) { dumper(); inst_dbg->dumper(static_cast<SALAM::Instruction*>(this));}}
         void dumper();
@@ -1565,6 +1596,104 @@ createSelectInst(uint64_t id, gem5::SimObject * owner, bool dbg,
               uint64_t OpCode,
               uint64_t cycles,
               uint64_t fu);
+// SALAM-ExtractElement // --------------------------------------------------//
+
+class ExtractElement : public Instruction {
+    private:
+        std::vector< std::vector<uint64_t> > conditions;
+        // conditions.at[0] == base params
+        SALAM::Debugger *dbgr;
+        uint64_t currentCycle;
+
+    protected:
+    public:
+        ExtractElement (uint64_t id, gem5::SimObject * owner, bool dbg,
+            uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu);
+        ~ExtractElement() = default;
+        void initialize (llvm::Value * irval,
+                        irvmap * irmap,
+                        SALAM::valueListTy * valueList);
+        uint64_t getCycleCount() { return conditions.at(0).at(2); }
+        void compute();
+        void dump() { if (dbgr->enabled()) { dumper(); inst_dbg->dumper(static_cast<SALAM::Instruction*>(this));}}
+        void dumper();
+        std::shared_ptr<SALAM::ExtractElement> clone() const { return std::static_pointer_cast<SALAM::ExtractElement>(createClone()); }
+        virtual std::shared_ptr<SALAM::Value> createClone() const override { return std::shared_ptr<SALAM::ExtractElement>(new SALAM::ExtractElement(*this)); }
+};
+
+std::shared_ptr<SALAM::Instruction>
+createExtractElementInst(uint64_t id, gem5::SimObject * owner, bool dbg,
+              uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu);
+// SALAM-InsertElement // ---------------------------------------------------//
+
+class InsertElement : public Instruction {
+    private:
+        std::vector< std::vector<uint64_t> > conditions;
+        // conditions.at[0] == base params
+        SALAM::Debugger *dbgr;
+        uint64_t currentCycle;
+
+    protected:
+    public:
+        InsertElement (uint64_t id, gem5::SimObject * owner, bool dbg,
+            uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu);
+        ~InsertElement() = default;
+        void initialize (llvm::Value * irval,
+                        irvmap * irmap,
+                        SALAM::valueListTy * valueList);
+        uint64_t getCycleCount() { return conditions.at(0).at(2); }
+        void compute();
+        void dump() { if (dbgr->enabled()) { dumper(); inst_dbg->dumper(static_cast<SALAM::Instruction*>(this));}}
+        void dumper();
+        std::shared_ptr<SALAM::InsertElement> clone() const { return std::static_pointer_cast<SALAM::InsertElement>(createClone()); }
+        virtual std::shared_ptr<SALAM::Value> createClone() const override { return std::shared_ptr<SALAM::InsertElement>(new SALAM::InsertElement(*this)); }
+};
+
+std::shared_ptr<SALAM::Instruction>
+createInsertElementInst(uint64_t id, gem5::SimObject * owner, bool dbg,
+              uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu);
+// SALAM-ShuffleVector // ---------------------------------------------------//
+
+class ShuffleVector : public Instruction {
+    private:
+        std::vector< std::vector<uint64_t> > conditions;
+        // conditions.at[0] == base params
+        // Source lane of each result lane, -1 for undefined lanes
+        std::vector<int> mask;
+        SALAM::Debugger *dbgr;
+        uint64_t currentCycle;
+
+    protected:
+    public:
+        ShuffleVector (uint64_t id, gem5::SimObject * owner, bool dbg,
+            uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu);
+        ~ShuffleVector() = default;
+        void initialize (llvm::Value * irval,
+                        irvmap * irmap,
+                        SALAM::valueListTy * valueList);
+        uint64_t getCycleCount() { return conditions.at(0).at(2); }
+        void compute();
+        void dump() { if (dbgr->enabled()) { dumper(); inst_dbg->dumper(static_cast<SALAM::Instruction*>(this));}}
+        void dumper();
+        std::shared_ptr<SALAM::ShuffleVector> clone() const { return std::static_pointer_cast<SALAM::ShuffleVector>(createClone()); }
+        virtual std::shared_ptr<SALAM::Value> createClone() const override { return std::shared_ptr<SALAM::ShuffleVector>(new SALAM::ShuffleVector(*this)); }
+};
+
+std::shared_ptr<SALAM::Instruction>
+createShuffleVectorInst(uint64_t id, gem5::SimObject * owner, bool dbg,
+              uint64_t OpCode,
+              uint64_t cycles,
+              uint64_t fu);
 //---------------------------------------------------------------------------//
 //--------- End Instruction Classes -----------------------------------------//
 //---------------------------------------------------------------------------//
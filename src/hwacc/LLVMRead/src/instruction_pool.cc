@@ -0,0 +1,35 @@
+//------------------------------------------//
+#include "instruction_pool.hh"
+//------------------------------------------//
+
+std::shared_ptr<SALAM::Instruction>
+SALAM::InstructionPool::acquire(const std::shared_ptr<SALAM::Instruction> &staticInst)
+{
+    auto it = freeLists.find(staticInst->getUID());
+    if (it != freeLists.end()) {
+        freeListTy &freeList = it->second;
+        while (!freeList.empty()) {
+            std::shared_ptr<SALAM::Instruction> inst = std::move(freeList.back());
+            freeList.pop_back();
+            // The pool must be the only owner before an instance is reused
+            if (inst.use_count() == 1) {
+                inst->reset();
+                reuses++;
+                return inst;
+            }
+            discards++;
+        }
+    }
+    allocations++;
+    return staticInst->clone();
+}
+
+void
+SALAM::InstructionPool::release(const std::shared_ptr<SALAM::Instruction> &inst)
+{
+    // Drop the links to other dynamic instances now so that they do not
+    // keep each other referenced while sitting in the pool
+    inst->reset();
+    freeLists[inst->getUID()].push_back(inst);
+    releases++;
+}
@@ -0,0 +1,46 @@
+#ifndef __SALAM_INSTRUCTION_POOL_HH__
+#define __SALAM_INSTRUCTION_POOL_HH__
+//------------------------------------------//
+#include "instruction.hh"
+//------------------------------------------//
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+//------------------------------------------//
+
+namespace SALAM
+{
+/*****************************************************************************
+* InstructionPool recycles the dynamic instances the runtime engine clones
+* from static instructions. Instances are handed back to the pool when they
+* retire from the scheduler queues, and are reset in place and reused for the
+* next dynamic instance of the same static instruction. An instance that is
+* still referenced elsewhere when it is requested again (e.g. a Call held by
+* its callee) is dropped from the pool rather than reused.
+*****************************************************************************/
+class InstructionPool
+{
+    private:
+        typedef std::vector<std::shared_ptr<SALAM::Instruction>> freeListTy;
+        std::unordered_map<uint64_t, freeListTy> freeLists;
+        uint64_t allocations = 0;
+        uint64_t reuses = 0;
+        uint64_t releases = 0;
+        uint64_t discards = 0;
+
+    public:
+        InstructionPool() = default;
+        ~InstructionPool() = default;
+        std::shared_ptr<SALAM::Instruction>
+            acquire(const std::shared_ptr<SALAM::Instruction> &staticInst);
+        void release(const std::shared_ptr<SALAM::Instruction> &inst);
+        void clear() { freeLists.clear(); }
+        uint64_t getAllocations() const { return allocations; }
+        uint64_t getReuses() const { return reuses; }
+        uint64_t getReleases() const { return releases; }
+        uint64_t getDiscards() const { return discards; }
+};
+} // End SALAM Namespace
+
+#endif //__SALAM_INSTRUCTION_POOL_HH__
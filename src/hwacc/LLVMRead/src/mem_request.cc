@@ -1,9 +1,54 @@
 //------------------------------------------//
 #include "mem_request.hh"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
+#include <vector>
 //------------------------------------------//
 
+namespace
+{
+
+// Storage of retired requests, reused by the next allocation
+std::vector<void *> &
+requestPool()
+{
+    static thread_local std::vector<void *> pool;
+    return pool;
+}
+
+} // anonymous namespace
+
+void *
+MemoryRequest::operator new(size_t size) {
+    auto &pool = requestPool();
+    if ((size != sizeof(MemoryRequest)) || pool.empty())
+        return ::operator new(size);
+    void *ptr = pool.back();
+    pool.pop_back();
+    return ptr;
+}
+
+void
+MemoryRequest::operator delete(void * ptr, size_t size) {
+    if (size != sizeof(MemoryRequest)) {
+        ::operator delete(ptr);
+        return;
+    }
+    requestPool().push_back(ptr);
+}
+
+void
+MemoryRequest::allocateBuffer(size_t len) {
+    if (len <= inlineBytes) {
+        buffer = inlineBuffer;
+        readsDone = inlineDone;
+    } else {
+        buffer = new uint8_t[len * (1 + sizeof(bool))];
+        readsDone = reinterpret_cast<bool *>(buffer + len);
+    }
+}
+
 MemoryRequest::MemoryRequest(Addr add, size_t len) {
     address = add;
     length = len;
@@ -19,13 +64,9 @@ MemoryRequest::MemoryRequest(Addr add, size_t len) {
     totalLength = length;
     readDone = 0;
 
-    buffer = new uint8_t[length];
-    readsDone = new bool[length];
+    allocateBuffer(length);
     std::memset(buffer, 0, length);
-
-    for (int i = 0; i < length; i++) {
-        readsDone[i] = false;
-    }
+    std::fill(readsDone, readsDone + length, false);
     pkt = NULL;
 }
 
@@ -48,8 +89,7 @@ MemoryRequest::MemoryRequest(Addr add, const void *data, size_t len) {
     readDone = length;
     writeDone = 0;
 
-    buffer = new uint8_t[length];
-    readsDone = new bool[length];
+    allocateBuffer(length);
     std::memcpy(buffer, data, length);
     // for (int i = 0; i < length; i++) {
     //     buffer[i] = *(data + i);
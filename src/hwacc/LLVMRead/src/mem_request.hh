@@ -28,16 +28,27 @@ class MemoryRequest {
     uint8_t *buffer;
     bool *readsDone;
 
+    // Accesses up to a cache line keep their data inline, larger ones use a
+    // single heap block holding the data followed by the readsDone flags.
+    // Packets point straight into the buffer, so it must outlive them.
+    static constexpr size_t inlineBytes = 64;
+    uint8_t inlineBuffer[inlineBytes];
+    bool inlineDone[inlineBytes];
+    void allocateBuffer(size_t len);
+
     PacketPtr pkt;
     RequestPort * port;
   public:
     MemoryRequest(Addr add, size_t len);
     MemoryRequest(Addr add, const void *data, size_t len);
     ~MemoryRequest() {
-        delete[] readsDone;
-        delete[] buffer;
+        if (buffer != inlineBuffer) delete[] buffer;
         // if (pkt) delete pkt;
     }
+    // Requests are created and retired for every accelerator memory access,
+    // so their storage is recycled through a free list
+    static void * operator new(size_t size);
+    static void operator delete(void * ptr, size_t size);
     void setCarrierPort(RequestPort * _port) { port = _port; }
     RequestPort * getCarrierPort() { return port; }
     uint8_t * getBuffer() { return buffer; }
@@ -18,6 +18,24 @@ SALAM::Constant::initialize(llvm::Value * irval,
     llvm::ConstantData * cd = llvm::dyn_cast<llvm::ConstantData>(irval);
     llvm::ConstantExpr * ce = llvm::dyn_cast<llvm::ConstantExpr>(irval);
     llvm::Type *irtype = irval->getType();
+    if (irtype->isVectorTy()) {
+        // Vector constants are built lane by lane from their elements
+        llvm::Constant * vc = llvm::dyn_cast<llvm::Constant>(irval);
+        assert(vc);
+        addVectorRegister(irtype, false);
+        for (uint64_t i = 0; i < lanes; i++) {
+            llvm::Constant * elem = vc->getAggregateElement(i);
+            uint64_t bits = 0;
+            if (llvm::ConstantInt * ci = llvm::dyn_cast_or_null<llvm::ConstantInt>(elem)) {
+                bits = ci->getValue().getLimitedValue();
+            } else if (llvm::ConstantFP * cf = llvm::dyn_cast_or_null<llvm::ConstantFP>(elem)) {
+                bits = cf->getValueAPF().bitcastToAPInt().getLimitedValue();
+            }
+            // Undef, poison and null lanes read as zero
+            returnReg->setLane(i, bits);
+        }
+        return;
+    }
     if (cd) {
         // The constant is a llvm::ConstantData.
         // Get it's value and store it in constValue
@@ -348,8 +366,7 @@ SALAM::Operand::Operand_Debugger::dumper(Operand * op)
 SALAM::Operand::Operand(const SALAM::Operand &copy_val):
            SALAM::Value(copy_val)
 {
-    lockedValue = copy_val.lockedValue;
-    set = copy_val.set;
+    copyLockedValue(copy_val);
 }
 
 // copy constructor from base
@@ -370,28 +387,55 @@ SALAM::Operand&
 SALAM::Operand::operator = (SALAM::Operand &copy_val)
 {
     uid = copy_val.uid;
-      returnReg = copy_val.returnReg;
+    returnReg = copy_val.returnReg;
+    ownedReg = copy_val.ownedReg;
     valueTy = copy_val.valueTy;
     size = copy_val.size;
+    lanes = copy_val.lanes;
+    copyLockedValue(copy_val);
+    return *this;
+}
+
+void
+SALAM::Operand::copyLockedValue(const SALAM::Operand &copy_val)
+{
     lockedValue = copy_val.lockedValue;
     set = copy_val.set;
-    return *this;
+    if (lockedValue.isVector()) {
+        size_t bytes = lockedValue.getVectorBytes();
+        lockedLanes.reset(new uint8_t[bytes]);
+        std::memcpy(lockedLanes.get(), copy_val.lockedLanes.get(), bytes);
+        lockedValue.attachLanes(lockedLanes.get());
+    } else {
+        lockedLanes.reset();
+    }
 }
 
 void
 SALAM::Operand::initOperandReg()
 {
     bool istracked = false;
-    if (returnReg->isPtr()) {
+    if (!returnReg) {
+        if (dbg) DPRINTFS(Runtime, owner, "Invalid register type. Dumping Operand details\n");
+        dump();
+        assert(0); // Type is invalid for a register
+    } else if (returnReg->isVector()) {
+        if (dbg) DPRINTFS(Runtime, owner, "Operand Vector Register Initialized\n");
+        lockedValue = SALAM::Register(returnReg->getType(),
+                                      returnReg->getLanes(),
+                                      returnReg->getLaneBytes(),
+                                      istracked);
+        lockedLanes.reset(new uint8_t[lockedValue.getVectorBytes()]());
+        lockedValue.attachLanes(lockedLanes.get());
+    } else if (returnReg->isPtr()) {
         if (dbg) DPRINTFS(Runtime, owner, "Operand Ptr Register Initialized\n");
-        lockedValue = std::make_shared<PointerRegister>(istracked);
+        lockedValue = SALAM::PointerRegister(istracked);
     } else if (returnReg->isInt()) {
         if (dbg) DPRINTFS(Runtime, owner, "Operand Int Register Initialized\n");
-        lockedValue = std::make_shared<APIntRegister>(size, istracked);
+        lockedValue = SALAM::APIntRegister(size, istracked);
     } else if (returnReg->isFP()) {
         if (dbg) DPRINTFS(Runtime, owner, "Operand FP Register Initialized\n");
-        lockedValue =
-            std::make_shared<APFloatRegister>(valueTy, istracked);
+        lockedValue = SALAM::APFloatRegister(valueTy, istracked);
     } else {
         if (dbg) DPRINTFS(Runtime, owner, "Invalid register type. Dumping Operand details\n");
         dump();
@@ -407,13 +451,15 @@ SALAM::Operand::initialize(llvm::Value * irval, SALAM::irvmap * irmap)
 
 void
 SALAM::Operand::updateOperandRegister() {
-    assert(lockedValue);
-    if (lockedValue->isPtr()) {
-        lockedValue->writePtrData(returnReg->getPtrData(true),
-                                  getSizeInBytes());
-    } else if (lockedValue->isInt()) {
-        lockedValue->writeIntData(returnReg->getIntData(true));
-    } else if (lockedValue->isFP()) {
-        lockedValue->writeFloatData(returnReg->getFloatData(true));
+    if (lockedValue.isVector()) {
+        lockedValue.writeVectorData(returnReg->getVectorData(true),
+                                    getSizeInBytes());
+    } else if (lockedValue.isPtr()) {
+        lockedValue.writePtrData(returnReg->getPtrData(true),
+                                 getSizeInBytes());
+    } else if (lockedValue.isInt()) {
+        lockedValue.writeIntData(returnReg->getIntData(true));
+    } else if (lockedValue.isFP()) {
+        lockedValue.writeFloatData(returnReg->getFloatData(true));
     }
 }
@@ -19,12 +19,17 @@ namespace SALAM
 {
 
 
-class Operand: public Value
+class Operand final : public Value
 {
     private:
-        std::shared_ptr<SALAM::Register> lockedValue;
+        // The operand value is latched by value, reads do not chase a pointer
+        SALAM::Register lockedValue;
+        // Lanes latched by a vector operand, scalar operands leave it empty
+        std::unique_ptr<uint8_t[]> lockedLanes;
         bool set = false;
 
+        void copyLockedValue(const Operand &copy_val);
+
     protected:
         class Operand_Debugger: public Debugger
         {
@@ -48,23 +53,17 @@ class Operand: public Value
         virtual void initialize(llvm::Value * irval, irvmap * irmap) override;
         void updateOperandRegister();
 
-        virtual uint64_t getPtrRegValue() { return lockedValue->getPtrData(); }
-    #if USE_LLVM_AP_VALUES
-        virtual llvm::APFloat getFloatRegValue() { return lockedValue->getFloatData(); }
-        virtual llvm::APSInt getIntRegValue() { return lockedValue->getIntData(); }
-        virtual bool hasIntVal() { return lockedValue->isInt(); }
-        virtual bool hasPtrVal() { return lockedValue->isPtr(); }
-    #else
-        virtual uint64_t getFloatRegValue() { return lockedValue->getFloatData(); }
-        virtual float getFloatFromReg() { return lockedValue->getFloat(); }
-        virtual double getDoubleFromReg() { return lockedValue->getDouble(); }
-        virtual uint64_t getIntRegValue() { return lockedValue->getIntData(); }
-        virtual uint64_t getUIntRegValue() { return lockedValue->getUnsignedInt(); }
-        virtual int64_t getSIntRegValue() { return lockedValue->getSignedInt(size); }
-        virtual bool hasIntVal() { return lockedValue->isInt(); }
-        virtual bool hasPtrVal() { return lockedValue->isPtr(); }
-    #endif
-        std::shared_ptr<SALAM::Register> getOpRegister() { return lockedValue; }
+        // Operand is final, so reads through an Operand are resolved statically
+        virtual uint64_t getPtrRegValue() override { return lockedValue.getPtrData(); }
+        virtual uint64_t getFloatRegValue() override { return lockedValue.getFloatData(); }
+        virtual float getFloatFromReg() override { return lockedValue.getFloat(); }
+        virtual double getDoubleFromReg() override { return lockedValue.getDouble(); }
+        virtual uint64_t getIntRegValue() override { return lockedValue.getIntData(); }
+        virtual uint64_t getUIntRegValue() override { return lockedValue.getUnsignedInt(); }
+        virtual int64_t getSIntRegValue() override { return lockedValue.getSignedInt(size); }
+        bool hasIntVal() { return lockedValue.isInt(); }
+        bool hasPtrVal() { return lockedValue.isPtr(); }
+        SALAM::Register &getOpRegister() { return lockedValue; }
 };
 
 class Constant: public Value {
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "hwacc/LLVMRead/src/compute_kernels.hh"
+#include "hwacc/LLVMRead/src/instruction.hh"
+#include "hwacc/LLVMRead/src/operand.hh"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+
+/*
+ * A dependent instruction must compute with the value of its producer, both
+ * when the producer signals it on commit and when the producer has already
+ * committed by the time findDynamicDeps resolves the dependency. The chain is
+ * checked with the compute() of the instructions and with compute kernels.
+ */
+
+// The instructions of the test have no functional unit, so the HWInterface
+// they would report to is never used and not linked in
+void
+HWInterface::useFunctionalUnit(uint64_t functional_unit, uint64_t latency)
+{
+}
+
+namespace
+{
+
+const char *chainIR =
+    "define i32 @chain(i32 %a) {\n"
+    "  %x = add i32 %a, 7\n"
+    "  %y = add i32 %x, 5\n"
+    "  ret i32 %y\n"
+    "}\n";
+
+class OperandForwarding : public ::testing::Test
+{
+  protected:
+    llvm::LLVMContext context;
+    std::unique_ptr<llvm::Module> module;
+    SALAM::irvmap irmap;
+    SALAM::valueListTy values;
+    std::shared_ptr<SALAM::Argument> arg;
+    std::shared_ptr<SALAM::Instruction> producer;
+    std::shared_ptr<SALAM::Instruction> consumer;
+
+    void
+    SetUp() override
+    {
+        llvm::SMDiagnostic err;
+        module = llvm::parseAssemblyString(chainIR, err, context);
+        ASSERT_TRUE(module);
+        llvm::Function *func = module->getFunction("chain");
+        auto irArg = func->getArg(0);
+        auto irInst = func->getEntryBlock().begin();
+        llvm::Instruction *irX = &*irInst++;
+        llvm::Instruction *irY = &*irInst;
+
+        arg = std::make_shared<SALAM::Argument>(1, nullptr, false);
+        producer = SALAM::createAddInst(2, nullptr, false,
+                                        llvm::Instruction::Add, 0, 0);
+        consumer = SALAM::createAddInst(3, nullptr, false,
+                                        llvm::Instruction::Add, 0, 0);
+        values = {arg, producer, consumer};
+        irmap.insert(SALAM::irvmaptype(irArg, arg));
+        irmap.insert(SALAM::irvmaptype(irX, producer));
+        irmap.insert(SALAM::irvmaptype(irY, consumer));
+        arg->initialize(irArg, &irmap);
+        producer->initialize(irX, &irmap, &values);
+        consumer->initialize(irY, &irmap, &values);
+    }
+
+    void
+    lowerKernels()
+    {
+        for (auto inst : {producer, consumer}) {
+            inst->setComputeKernel(SALAM::lowerComputeKernel(inst.get()));
+            ASSERT_TRUE(inst->hasComputeKernel());
+        }
+    }
+
+    // The producer is still in flight, it latches its result into the
+    // consumer operand when it commits
+    uint64_t
+    runSignaled(std::shared_ptr<SALAM::Instruction> x,
+                std::shared_ptr<SALAM::Instruction> y, uint64_t a)
+    {
+        arg->setRegisterValue(a);
+        EXPECT_TRUE(x->runtimeInitialize().empty());
+        auto deps = y->runtimeInitialize();
+        EXPECT_EQ(deps.size(), 1);
+        y->addRuntimeDependency(x);
+        x->addRuntimeUser(y);
+        EXPECT_TRUE(x->launch());
+        EXPECT_EQ(y->getDependencyCount(), 0);
+        EXPECT_TRUE(y->launch());
+        return y->getReg()->getUnsignedInt();
+    }
+
+    // The producer committed before the consumer was scheduled, so the
+    // consumer reads the producer register when its dependency resolves
+    uint64_t
+    runResolved(std::shared_ptr<SALAM::Instruction> x,
+                std::shared_ptr<SALAM::Instruction> y, uint64_t a)
+    {
+        arg->setRegisterValue(a);
+        EXPECT_TRUE(x->runtimeInitialize().empty());
+        EXPECT_TRUE(x->launch());
+        auto deps = y->runtimeInitialize();
+        EXPECT_EQ(deps.size(), 1);
+        for (auto resolved : deps) y->setOperandValue(resolved);
+        EXPECT_TRUE(y->launch());
+        return y->getReg()->getUnsignedInt();
+    }
+};
+
+TEST_F(OperandForwarding, SignaledOnCommit)
+{
+    EXPECT_EQ(runSignaled(producer->clone(), consumer->clone(), 30), 42);
+}
+
+TEST_F(OperandForwarding, ResolvedInFindDynamicDeps)
+{
+    EXPECT_EQ(runResolved(producer->clone(), consumer->clone(), 30), 42);
+}
+
+TEST_F(OperandForwarding, SignaledOnCommitWithKernels)
+{
+    lowerKernels();
+    EXPECT_EQ(runSignaled(producer->clone(), consumer->clone(), 30), 42);
+}
+
+TEST_F(OperandForwarding, ResolvedInFindDynamicDepsWithKernels)
+{
+    lowerKernels();
+    EXPECT_EQ(runResolved(producer->clone(), consumer->clone(), 30), 42);
+}
+
+// Recycled instances keep their operands, the next run must not see the
+// value latched by the previous one
+TEST_F(OperandForwarding, RecycledInstances)
+{
+    auto x = producer->clone();
+    auto y = consumer->clone();
+    EXPECT_EQ(runSignaled(x, y, 30), 42);
+    x->reset();
+    y->reset();
+    EXPECT_EQ(runResolved(x, y, 100), 112);
+    x->reset();
+    y->reset();
+    lowerKernels();
+    x = producer->clone();
+    y = consumer->clone();
+    EXPECT_EQ(runSignaled(x, y, 1), 13);
+    x->reset();
+    y->reset();
+    EXPECT_EQ(runResolved(x, y, 2), 14);
+}
+
+} // anonymous namespace
@@ -1,368 +1,159 @@
 //------------------------------------------//
 #include "registers.hh"
 //------------------------------------------//
-
-SALAM::Register::Register(bool trk,
-                          bool nul) :
-                          tracked(trk),
-                          isNULL(nul)
-{
-}
-
-SALAM::Register::~Register()
-{
-}
-
-SALAM::Register::Register_Debugger::Register_Debugger()
-{
-}
-
-void
-SALAM::Register::Register_Debugger::dumper(SALAM::Register *reg)
-{
-}
-
+#include <sstream>
+#include <ios>
 
 SALAM::APFloatRegister::APFloatRegister(llvm::Type * T,
                                         bool tracked) :
-                                        Register(tracked)
+                                        APFloatRegister(T->getTypeID(),
+                                        tracked)
 {
-    #if USE_LLVM_AP_VALUES
-    switch (T->getTypeID()) {
-        case llvm::Type::FloatTyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEsingle());
-            break;
-        }
-        case llvm::Type::DoubleTyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEdouble());
-            break;
-        }
-        case llvm::Type::HalfTyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEhalf());
-            break;
-        }
-        case llvm::Type::X86_FP80TyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::x87DoubleExtended());
-            break;
-        }
-        case llvm::Type::FP128TyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEquad());
-            break;
-        }
-        case llvm::Type::PPC_FP128TyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::PPCDoubleDouble());
-            break;
-        }
-        default:
-            assert(0 && "Specified Floating Point type is not supported");
-    }
-    #else
-    switch (T->getTypeID()) {
-        case llvm::Type::FloatTyID:
-        {
-            data = 0;
-            break;
-        }
-        case llvm::Type::DoubleTyID:
-        {
-            data = 0;
-            break;
-        }
-        default:
-            assert(0 && "Specified Floating Point type is not supported");
-    }
-    #endif
 }
 
 SALAM::APFloatRegister::APFloatRegister(llvm::Type::TypeID T,
                                         bool tracked) :
-                                        Register(tracked)
+                                        Register(FloatReg,
+                                        tracked)
 {
-    #if USE_LLVM_AP_VALUES
-    switch (T) {
-        case llvm::Type::FloatTyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEsingle());
-            break;
-        }
-        case llvm::Type::DoubleTyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEdouble());
-            break;
-        }
-        case llvm::Type::HalfTyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEhalf());
-            break;
-        }
-        case llvm::Type::X86_FP80TyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::x87DoubleExtended());
-            break;
-        }
-        case llvm::Type::FP128TyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::IEEEquad());
-            break;
-        }
-        case llvm::Type::PPC_FP128TyID:
-        {
-            data = llvm::APFloat::getZero(llvm::APFloat::PPCDoubleDouble());
-            break;
-        }
-        default:
-            assert(0 && "Specified Floating Point type is not supported");
-    }
-    #else
     switch (T) {
         case llvm::Type::FloatTyID:
-        {
-            data = 0;
-            break;
-        }
         case llvm::Type::DoubleTyID:
-        {
-            data = 0;
             break;
-        }
         default:
             assert(0 && "Specified Floating Point type is not supported");
     }
-    #endif
 }
 
 SALAM::APFloatRegister::APFloatRegister(const llvm::APFloat &RHS) :
-                                        Register(false)
+                                        Register(FloatReg,
+                                        false)
 {
-    #if USE_LLVM_AP_VALUES
-        data = (RHS);
-    #else
-        auto bitcast = RHS.bitcastToAPInt();
-        data = (uint64_t)(bitcast.getLimitedValue());
-        regdata = data;
-    #endif
+    auto bitcast = RHS.bitcastToAPInt();
+    regdata = (uint64_t)(bitcast.getLimitedValue());
 }
 
 SALAM::APIntRegister::APIntRegister(llvm::Type * T,
                                     bool tracked) :
-                                    Register(tracked)
+                                    Register(IntReg,
+                                    tracked)
 {
-    #if USE_LLVM_AP_VALUES
-        llvm::IntegerType * it = llvm::dyn_cast<llvm::IntegerType>(T);
-        assert(it);
-        data = llvm::APSInt::getMinValue(it->getBitWidth(), true);
-    #else
-        data = 0;
-    #endif
 }
 
 SALAM::APIntRegister::APIntRegister(uint64_t bitwidth,
                                     bool tracked) :
-                                    Register(tracked)
+                                    Register(IntReg,
+                                    tracked)
 {
-    #if USE_LLVM_AP_VALUES
-        data = llvm::APSInt::getMinValue(bitwidth), true);
-    #else
-        data = 0;
-    #endif
 }
 
 SALAM::APIntRegister::APIntRegister(const llvm::APInt &RHS) :
-                                    Register(false)
+                                    Register(IntReg,
+                                    false)
 {
-    #if USE_LLVM_AP_VALUES
-        data = RHS;
-    #else
-        data = (uint64_t)(RHS.getLimitedValue());
-        regdata = data;
-    #endif
+    regdata = (uint64_t)(RHS.getLimitedValue());
 }
 
 SALAM::PointerRegister::PointerRegister(bool tracked,
                                         bool isNull) :
-                                        Register(tracked,
-                                        isNull),
-                                        pointer(0)
+                                        Register(PtrReg,
+                                        tracked,
+                                        isNull)
 {
 }
 
 SALAM::PointerRegister::PointerRegister(uint64_t val,
                                         bool tracked,
                                         bool isNull) :
-                                        Register(tracked,
-                                        isNull),
-                                        pointer(val)
+                                        Register(PtrReg,
+                                        tracked,
+                                        isNull)
 {
+    regdata = val;
+}
+
+SALAM::VectorRegister::VectorRegister(RegisterType elementType,
+                                      uint16_t numLanes,
+                                      uint8_t bytesPerLane,
+                                      bool tracked) :
+                                      Register(elementType,
+                                      numLanes,
+                                      bytesPerLane,
+                                      tracked),
+                                      storage(new uint8_t[getVectorBytes()]())
+{
+    attachLanes(storage.get());
 }
 
-#if USE_LLVM_AP_VALUES
-    llvm::APFloat
-    SALAM::APFloatRegister::getFloatData(bool incReads)
-    {
-        if (incReads && tracked) reads++;
-        return data;
-    }
-
-    void
-    SALAM::APFloatRegister::writeFloatData(llvm::APFloat apf, bool incWrites)
-    {
-        if (incWrites && tracked) writes++;
-        data = apf;
-    }
-#else
-    uint64_t
-    SALAM::APFloatRegister::getFloatData(bool incReads)
-    {
-        if (incReads && tracked) reads++;
-        return data;
-    }
-
-    float
-    SALAM::APFloatRegister::getFloat(bool incReads) {
-        if (incReads && tracked) reads++;
-        return *(float *)&data;
-    }
-
-    double
-    SALAM::APFloatRegister::getDouble(bool incReads) {
-        if (incReads && tracked) reads++;
-        return *(double *)&data;
-    }
-
-    void
-    SALAM::APFloatRegister::writeFloatData(uint64_t apf, size_t len, bool incWrites)
-    {
-        if (incWrites && tracked) writes++;
-        std::memcpy(&data, &apf, len);
-        regdata = data;
-    }
-#endif
-
-#if USE_LLVM_AP_VALUES
-    llvm::APSInt
-    SALAM::APIntRegister::getIntData(bool incReads)
-    {
-        if (incReads && tracked) reads++;
-        return data;
-    }
-
-    void
-    SALAM::APIntRegister::writeIntData(llvm::APInt api, bool incWrites)
-    {
-        if (incWrites && tracked) writes++;
-        data = api;
-    }
-#else
-    uint64_t
-    SALAM::APIntRegister::getIntData(bool incReads)
-    {
-        if (incReads && tracked) reads++;
-        return data;
-    }
-
-    uint64_t
-    SALAM::APIntRegister::getUnsignedInt(bool incReads) {
-        if (incReads && tracked) reads++;
-        return data;
-    }
-
-    int64_t
-    SALAM::APIntRegister::getSignedInt(size_t sizeInBits, bool incReads) {
-        if (incReads && tracked) reads++;
-        int64_t tmp;
-        switch (sizeInBits) {
-            case 8:
-            {
-                tmp = (int64_t)((int8_t)(data));
-                break;
-            }
-            case 16:
-            {
-                tmp = (int64_t)((int16_t)(data));
-                break;
-            }
-            case 32:
-            {
-                tmp = (int64_t)((int32_t)(data));
-                break;
-            }
-            case 64:
-            {
-                tmp = (int64_t)(data);
-                break;
-            }
-            default:
-            {
-                assert(0 && "Must use AP values for nonstandard int sizes.");
-                break;
-            }
-        }
-        return tmp;
-    }
-
-    void
-    SALAM::APIntRegister::writeIntData(uint64_t api, size_t len, bool incWrites)
-    {
-        if (incWrites && tracked) writes++;
-        std::memcpy(&data, &api, len);
-        regdata = data;
-    }
-#endif
-uint64_t
-SALAM::PointerRegister::getPtrData(bool incReads)
+static SALAM::Register::RegisterType
+vectorElementType(llvm::Type *T)
 {
-    if (incReads && tracked) reads++;
-    return pointer;
+    llvm::Type *elem = T->getScalarType();
+    if (elem->isPointerTy()) return SALAM::Register::PtrReg;
+    if (elem->isFloatingPointTy()) return SALAM::Register::FloatReg;
+    assert(elem->isIntegerTy() && "Specified vector element type is not supported");
+    return SALAM::Register::IntReg;
 }
 
-void
-SALAM::PointerRegister::writePtrData(uint64_t ptr, size_t len, bool incWrites)
+static uint8_t
+vectorLaneBytes(llvm::Type *T)
 {
-    if (incWrites && tracked) writes++;
-    std::memcpy(&pointer, &ptr, len);
-    regdata = pointer;
+    llvm::Type *elem = T->getScalarType();
+    if (elem->isPointerTy()) return 8;
+    return ((elem->getScalarSizeInBits() - 1) >> 3) + 1;
 }
 
-#include <sstream>
-#include <ios>
-
-std::string
-SALAM::APFloatRegister::dataString() {
-    std::stringstream ss;
-#if USE_LLVM_AP_VALUES
-
-#else
-    float fdata = *(float*)&data;
-    double ddata = *(double*)&data;
-    ss << fdata << "f " << ddata << "d";
-#endif
-    return ss.str();
+SALAM::VectorRegister::VectorRegister(llvm::Type *T,
+                                      bool tracked) :
+                                      VectorRegister(vectorElementType(T),
+                                      vectorLanes(T),
+                                      vectorLaneBytes(T),
+                                      tracked)
+{
 }
 
-std::string
-SALAM::APIntRegister::dataString() {
-    std::stringstream ss;
-#if USE_LLVM_AP_VALUES
-
+uint16_t
+SALAM::vectorLanes(llvm::Type *T)
+{
+#if (LLVM_VERSION_MAJOR <= 10)
+    llvm::VectorType *vt = llvm::dyn_cast<llvm::VectorType>(T);
+    assert(vt && !vt->isScalable() && "Only fixed-width vectors are supported");
 #else
-    ss << "0x" << std::hex << data;
+    llvm::FixedVectorType *vt = llvm::dyn_cast<llvm::FixedVectorType>(T);
+    assert(vt && "Only fixed-width vectors are supported");
 #endif
-    return ss.str();
+    return vt->getNumElements();
 }
 
 std::string
-SALAM::PointerRegister::dataString() {
+SALAM::Register::dataString() {
     std::stringstream ss;
-#if USE_LLVM_AP_VALUES
-
-#else
-    ss << "0x" << std::hex << pointer;
-#endif
+    if (isVector()) {
+        ss << "<";
+        for (size_t i = 0; i < lanes; i++) {
+            if (i) ss << ", ";
+            uint64_t lane = getLane(i);
+            if (isFP() && (laneBytes == 4)) {
+                float fdata;
+                std::memcpy(&fdata, &lane, sizeof(float));
+                ss << fdata;
+            } else if (isFP()) {
+                double ddata;
+                std::memcpy(&ddata, &lane, sizeof(double));
+                ss << ddata;
+            } else {
+                ss << "0x" << std::hex << lane << std::dec;
+            }
+        }
+        ss << ">";
+    } else if (isFP()) {
+        float fdata;
+        double ddata;
+        std::memcpy(&fdata, &regdata, sizeof(float));
+        std::memcpy(&ddata, &regdata, sizeof(double));
+        ss << fdata << "f " << ddata << "d";
+    } else {
+        ss << "0x" << std::hex << regdata;
+    }
     return ss.str();
-}
\ No newline at end of file
+}
@@ -9,8 +9,19 @@
 #include "llvm/ADT/APFloat.h"
 #include <llvm-c/Core.h>
 
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
 #define USE_LLVM_AP_VALUES 0
 
+#if USE_LLVM_AP_VALUES
+#error "Registers hold raw 64-bit slots, LLVM AP values are not supported"
+#endif
+
 namespace SALAM
 {
 /*****************************************************************************
@@ -18,186 +29,286 @@ namespace SALAM
 * Every instruction and function argument has a corresponding register that
 * is tracked for power/area/timing. Additionally Constants have corresponding
 * registers, which are not tracked, since they do not have a timing component.
+*
+* A register is a single 64-bit slot with a type tag and read/write counters.
+* Integer, floating point (bitcast) and pointer data share the slot, so the
+* accessors are plain inline functions and registers can be stored by value,
+* both in the RegisterFile and inside Operands.
+*
+* Vector registers keep their lanes packed at the native element width, so
+* the lanes of a float vector form a plain float array that lane-wise
+* kernels can run over with host SIMD. The type tag is the element type.
+* The lanes are stored outside the register, which only points at them, so
+* scalar registers stay compact. Copies of a vector register share its lanes.
 *****************************************************************************/
 class Register
 {
+    public:
+        enum RegisterType : uint8_t { IntReg, FloatReg, PtrReg };
+
     protected:
-        bool tracked;
-        bool isNULL = false;
-        bool dbg = false;
+        friend class RegisterFile;
+
+        union {
+            uint64_t regdata = 0;
+            // Lane storage of a vector register
+            uint8_t *vecdata;
+        };
         uint64_t reads = 0;
         uint64_t writes = 0;
-        uint64_t regdata;
-
-        class Register_Debugger: public Debugger
-        {
-            public:
-                Register_Debugger();
-                ~Register_Debugger() = default;
-                virtual void dumper(SALAM::Register *reg);
-        };
+        uint16_t lanes = 0;
+        uint8_t laneBytes = 0;
+        RegisterType type;
+        bool tracked;
+        bool isNULL = false;
 
-        Register_Debugger reg_dbg;
+        void countRead(bool incReads) {
+            if (incReads && tracked) reads++;
+        }
+        void write(uint64_t data, size_t len, bool incWrites) {
+            if (incWrites && tracked) writes++;
+            std::memcpy(&regdata, &data, len);
+        }
 
     public:
-        Register(bool trk=true,
-                 bool nul=false);
-        ~Register();
-    #if USE_LLVM_AP_VALUES
-        virtual llvm::APFloat getFloatData(bool incReads=true) {
-            assert(0 && "Attempted to read float data from non-float register");
-            return llvm::APFloat::getNaN(llvm::APFloat::IEEEdouble());
-        }
-        virtual llvm::APSInt getIntData(bool incReads=true) {
-            assert(0 && "Attempted to read integer data from non-integer register");
-            return llvm::APSInt::getMinValue(1,true);
-        }
-    #else
-        virtual uint64_t getFloatData(bool incReads=true) {
-            assert(0 && "Attempted to read float data from non-float register");
-            return 0;
-        }
-        virtual float getFloat(bool incReads=true) {
-            assert(0 && "Attempted to read float data from non-float register");
-            return NAN;
-        }
-        virtual double getDouble(bool incReads=true) {
-            assert(0 && "Attempted to read float data from non-float register");
-            return NAN;
-        }
-        virtual uint64_t getIntData(bool incReads=true) {
-            assert(0 && "Attempted to read integer data from non-integer register");
-            return 0;
-        }
-        virtual uint64_t getUnsignedInt(bool incReads=true) {
-            assert(0 && "Attempted to read integer data from non-integer register");
-            return 0;
-        }
-        virtual int64_t getSignedInt(size_t sizeInBits, bool incReads=true) {
-            assert(0 && "Attempted to read integer data from non-integer register");
-            return 0;
-        }
-    #endif
-        virtual uint64_t getPtrData(bool incReads=true) {
-            assert(0 && "Attempted to read pointer data from non-pointer register");
-            return 0;
-        }
-    #if USE_LLVM_AP_VALUES
-        virtual void writeFloatData(llvm::APFloat apf, bool incWrites=true) {
-            assert(0 && "Attempted to write float data on non-float register");
-        }
-        virtual void writeIntData(llvm::APInt api, bool incWrites=true) {
-            assert(0 && "Attempted to write interger data on non-integer register");
-        }
-    #else
-        virtual void writeFloatData(uint64_t apf, size_t len=8, bool incWrites=true) {
-            assert(0 && "Attempted to write float data on non-float register");
-        }
-        virtual void writeIntData(uint64_t api, size_t len=8, bool incWrites=true) {
-            assert(0 && "Attempted to write interger data on non-integer register");
-        }
-    #endif
-        virtual void writePtrData(uint64_t ptr, size_t len=8, bool incWrites=true) {
-            assert(0 && "Attempted to write pointer data on non-pointer register");
-        }
-        virtual bool isInt() { return false; }
-        virtual bool isFP() { return false; }
-        virtual bool isPtr() { return false; }
+        Register(RegisterType ty=IntReg,
+                 bool trk=true,
+                 bool nul=false) :
+                 type(ty),
+                 tracked(trk),
+                 isNULL(nul) { }
+        // Vector register without lane storage, see attachLanes()
+        Register(RegisterType elementType,
+                 uint16_t numLanes,
+                 uint8_t bytesPerLane,
+                 bool trk) :
+                 vecdata(nullptr),
+                 lanes(numLanes),
+                 laneBytes(bytesPerLane),
+                 type(elementType),
+                 tracked(trk) {
+            assert(numLanes > 0);
+            assert((bytesPerLane == 1) || (bytesPerLane == 2) ||
+                   (bytesPerLane == 4) || (bytesPerLane == 8));
+        }
+        ~Register() = default;
+
+        uint64_t getFloatData(bool incReads=true) {
+            assert(isFP() && "Attempted to read float data from non-float register");
+            countRead(incReads);
+            return regdata;
+        }
+        float getFloat(bool incReads=true) {
+            assert(isFP() && "Attempted to read float data from non-float register");
+            countRead(incReads);
+            float tmp;
+            std::memcpy(&tmp, &regdata, sizeof(float));
+            return tmp;
+        }
+        double getDouble(bool incReads=true) {
+            assert(isFP() && "Attempted to read float data from non-float register");
+            countRead(incReads);
+            double tmp;
+            std::memcpy(&tmp, &regdata, sizeof(double));
+            return tmp;
+        }
+        uint64_t getIntData(bool incReads=true) {
+            assert(isInt() && "Attempted to read integer data from non-integer register");
+            countRead(incReads);
+            return regdata;
+        }
+        uint64_t getUnsignedInt(bool incReads=true) {
+            assert(isInt() && "Attempted to read integer data from non-integer register");
+            countRead(incReads);
+            return regdata;
+        }
+        int64_t getSignedInt(size_t sizeInBits, bool incReads=true) {
+            assert(isInt() && "Attempted to read integer data from non-integer register");
+            countRead(incReads);
+            switch (sizeInBits) {
+                case 8: return (int64_t)((int8_t)(regdata));
+                case 16: return (int64_t)((int16_t)(regdata));
+                case 32: return (int64_t)((int32_t)(regdata));
+                case 64: return (int64_t)(regdata);
+                default:
+                    assert(0 && "Must use AP values for nonstandard int sizes.");
+                    return 0;
+            }
+        }
+        uint64_t getPtrData(bool incReads=true) {
+            assert(isPtr() && "Attempted to read pointer data from non-pointer register");
+            countRead(incReads);
+            return regdata;
+        }
+        void writeFloatData(uint64_t apf, size_t len=8, bool incWrites=true) {
+            assert(isFP() && "Attempted to write float data on non-float register");
+            write(apf, len, incWrites);
+        }
+        void writeIntData(uint64_t api, size_t len=8, bool incWrites=true) {
+            assert(isInt() && "Attempted to write interger data on non-integer register");
+            write(api, len, incWrites);
+        }
+        void writePtrData(uint64_t ptr, size_t len=8, bool incWrites=true) {
+            assert(isPtr() && "Attempted to write pointer data on non-pointer register");
+            write(ptr, len, incWrites);
+        }
+        // Raw bits of a scalar register regardless of its type
+        uint64_t getRawData(bool incReads=true) {
+            countRead(incReads);
+            return regdata;
+        }
+        // Vector lanes, packed at laneBytes each
+        const uint8_t *getVectorData(bool incReads=true) {
+            assert(isVector() && "Attempted to read vector data from scalar register");
+            countRead(incReads);
+            return vecdata;
+        }
+        // Lane buffer for kernels that compute the lanes in place
+        uint8_t *getVectorBuffer(bool incWrites=true) {
+            assert(isVector() && "Attempted to write vector data on scalar register");
+            if (incWrites && tracked) writes++;
+            return vecdata;
+        }
+        void writeVectorData(const uint8_t *data, size_t len, bool incWrites=true) {
+            assert(isVector() && (len <= getVectorBytes()));
+            if (incWrites && tracked) writes++;
+            std::memcpy(vecdata, data, len);
+        }
+        // Point the register at the storage of its lanes
+        void attachLanes(uint8_t *data) {
+            assert(isVector());
+            vecdata = data;
+        }
+        size_t getVectorBytes() const { return lanes * laneBytes; }
+        uint64_t getLane(size_t lane) const {
+            uint64_t tmp = 0;
+            std::memcpy(&tmp, &vecdata[lane * laneBytes], laneBytes);
+            return tmp;
+        }
+        void setLane(size_t lane, uint64_t data) {
+            std::memcpy(&vecdata[lane * laneBytes], &data, laneBytes);
+        }
+        bool isVector() const { return lanes != 0; }
+        uint16_t getLanes() const { return lanes; }
+        uint8_t getLaneBytes() const { return laneBytes; }
+        RegisterType getType() const { return type; }
+        bool isInt() const { return type == IntReg; }
+        bool isFP() const { return type == FloatReg; }
+        bool isPtr() const { return type == PtrReg; }
         bool isTracked() { return tracked; }
         bool isNull() { return isNULL; }
         void setNull(bool flag) { isNULL = flag; }
         void setTracked(bool flag) { tracked = flag; }
-        void dump() { if (dbg) reg_dbg.dumper(this); }
         uint64_t getReads() { return reads; }
         uint64_t getWrites() { return writes; }
-        virtual std::string dataString() = 0;
+        std::string dataString();
 };
 
+// The typed registers only select the tag and initial value of a Register
 class APFloatRegister : public Register
 {
-    private:
-    #if USE_LLVM_AP_VALUES
-        llvm::APFloat data = llvm::APFloat::getZero(llvm::APFloat::IEEEdouble());
-    #else
-        // We use uint64_t to store the bitcast of the FP value.
-        // Compute should be performed after bitcasting back to appropriate type
-        uint64_t data = 0;
-    #endif
     public:
         APFloatRegister(llvm::Type::TypeID T,
                         bool isTracked);
         APFloatRegister(llvm::Type *T,
                         bool isTracked=true);
-        // This constructor is only used for constants.
+        // These constructors are only used for constants.
         APFloatRegister(const llvm::APFloat &RHS);
-        // ~APFloatRegister() { if (data) delete data; }
-    #if USE_LLVM_AP_VALUES
-        virtual llvm::APFloat getFloatData(bool incReads=true) override;
-        virtual void writeFloatData(llvm::APFloat apf, bool incWrites=true) override;
-    #else
-        // This constructor is only used for constants.
-        APFloatRegister(const uint64_t RHS) : Register(false) {
-            data = RHS;
-            regdata = data;    
-        }
-        virtual uint64_t getFloatData(bool incReads=true) override;
-        virtual float getFloat(bool incReads=true) override;
-        virtual double getDouble(bool incReads=true) override;
-        virtual void writeFloatData(uint64_t apf, size_t len=8, bool incWrites=true) override;
-    #endif
-        virtual bool isFP() override { return true; }
-        virtual std::string dataString() override;
+        APFloatRegister(const uint64_t RHS) : Register(FloatReg, false) {
+            regdata = RHS;
+        }
 };
 
 class APIntRegister : public Register
 {
-    private:
-    #if USE_LLVM_AP_VALUES
-        llvm::APSInt data = llvm::APSInt::getMinValue(1,true);
-    #else
-        uint64_t data = 0;
-    #endif
     public:
         APIntRegister(uint64_t bitwidth,
                       bool isTracked);
         APIntRegister(llvm::Type * T,
                       bool isTracked=true);
-        // This constructor is only used for constants.
+        // These constructors are only used for constants.
         APIntRegister(const llvm::APInt &RHS);
-        // ~APIntRegister() { if (data) delete data; }
-    #if USE_LLVM_AP_VALUES
-        virtual llvm::APSInt getIntData(bool incReads=true) override;
-        virtual void writeIntData(llvm::APInt api, bool incWrites=true) override;
-    #else
-        // This constructor is only used for constants.
-        APIntRegister(const uint64_t RHS) : Register(false) {
-            data = RHS;
-            regdata = data;
-        }
-        virtual uint64_t getIntData(bool incReads=true) override;
-        virtual uint64_t getUnsignedInt(bool incReads=true) override;
-        virtual int64_t getSignedInt(size_t sizeInBits, bool incReads=true) override;
-        virtual void writeIntData(uint64_t api, size_t len=8, bool incWrites=true) override;
-    #endif
-        virtual bool isInt() override { return true; }
-        virtual std::string dataString() override;
+        APIntRegister(const uint64_t RHS) : Register(IntReg, false) {
+            regdata = RHS;
+        }
 };
 
 class PointerRegister : public Register
 {
-    private:
-        uint64_t pointer = 0;
     public:
         PointerRegister(bool isTracked=true,
                         bool isNull=false);
         PointerRegister(uint64_t val,
                         bool isTracked=true,
                         bool isNull=false);
-        // ~PointerRegister() { if (pointer) delete pointer; }
-        virtual bool isPtr() override { return true; }
-        virtual uint64_t getPtrData(bool incReads=true) override;
-        virtual void writePtrData(uint64_t ptr, size_t len=8, bool incWrites=true) override;
-        virtual std::string dataString() override;
+};
+
+// Owns the lanes of a vector register until it is bound into a RegisterFile
+class VectorRegister : public Register
+{
+    private:
+        std::unique_ptr<uint8_t[]> storage;
+
+    public:
+        VectorRegister(RegisterType elementType,
+                       uint16_t numLanes,
+                       uint8_t bytesPerLane,
+                       bool isTracked=true);
+        // Shape of a fixed-width LLVM vector type
+        VectorRegister(llvm::Type *T,
+                       bool isTracked=true);
+        VectorRegister(const VectorRegister &) = delete;
+        VectorRegister &operator=(const VectorRegister &) = delete;
+};
+
+// Number of lanes of a fixed-width LLVM vector type
+uint16_t vectorLanes(llvm::Type *T);
+
+/*****************************************************************************
+* RegisterFile packs the return registers of the static graph into a single
+* contiguous array once the graph is constructed. Values point into the
+* file, so the registers of neighbouring instructions share cache lines
+* and the per-register heap allocations are released. The lanes of vector
+* registers are packed into a separate lane arena, 16 byte aligned per
+* register, so they do not widen the scalar slots.
+*****************************************************************************/
+class RegisterFile
+{
+    private:
+        std::vector<Register> slots;
+        std::vector<uint8_t> laneArena;
+
+    public:
+        RegisterFile() = default;
+        ~RegisterFile() = default;
+
+        // Arena bytes taken by the lanes of a register
+        static size_t laneSpace(const Register &reg) {
+            return reg.isVector() ? ((reg.getVectorBytes() + 15) & ~size_t(15)) : 0;
+        }
+        // Slots and lanes are never reallocated, reserve() must be called
+        // once with the total number of registers and their laneSpace()
+        // before any bind()
+        void reserve(size_t count, size_t laneBytes) {
+            assert(slots.empty());
+            slots.reserve(count);
+            laneArena.reserve(laneBytes);
+        }
+        // Copy a register and its lanes into the next slot and return the slot
+        Register *bind(const Register &reg) {
+            assert(slots.size() < slots.capacity());
+            slots.push_back(reg);
+            if (reg.isVector()) {
+                size_t offset = laneArena.size();
+                assert(offset + laneSpace(reg) <= laneArena.capacity());
+                laneArena.resize(offset + laneSpace(reg));
+                std::memcpy(&laneArena[offset], reg.vecdata, reg.getVectorBytes());
+                slots.back().attachLanes(&laneArena[offset]);
+            }
+            return &(slots.back());
+        }
+        Register &operator[](size_t index) { return slots[index]; }
+        size_t size() const { return slots.size(); }
 };
 } // End SALAM Namespace
-#endif
\ No newline at end of file
+#endif
@@ -19,8 +19,10 @@ SALAM::Value::Value(const Value &copy_val)
 {
     uid = copy_val.uid;
     returnReg = copy_val.returnReg;
+    ownedReg = copy_val.ownedReg;
     valueTy = copy_val.valueTy;
     size = copy_val.size;
+    lanes = copy_val.lanes;
     ir_string = copy_val.ir_string;
     ir_stub = copy_val.ir_stub;
     owner = copy_val.owner;
@@ -30,9 +32,11 @@ SALAM::Value::Value(const Value &copy_val)
 SALAM::Value::Value(std::shared_ptr<SALAM::Value> copy_val)
 {
     uid = copy_val->getUID();
-    returnReg = copy_val->getReg();
+    returnReg = copy_val->returnReg;
+    ownedReg = copy_val->ownedReg;
     valueTy = copy_val->getType();
     size = copy_val->getSize();
+    lanes = copy_val->getLanes();
     ir_string = copy_val->getIRString();
     ir_stub = copy_val->getIRStub();
     owner = copy_val->getOwner();
@@ -45,8 +49,10 @@ SALAM::Value::operator = (Value &copy_val)
 {
     uid = copy_val.uid;
     returnReg = copy_val.returnReg;
+    ownedReg = copy_val.ownedReg;
     valueTy = copy_val.valueTy;
     size = copy_val.size;
+    lanes = copy_val.lanes;
     ir_string = copy_val.ir_string;
     ir_stub = copy_val.ir_stub;
     return *this;
@@ -64,11 +70,12 @@ SALAM::Value::Value_Debugger::dumper(SALAM::Value *value)
 void
 SALAM::Value::initialize(llvm::Value * irval, SALAM::irvmap * irmap) {
     llvm::Type *irtype = irval->getType();
-    if (irtype->getTypeID() == llvm::Type::PointerTyID) {
+    if (irtype->getScalarType()->isPointerTy()) {
         size = 64; //We assume a 64-bit memory address space
     } else {
         size = irtype->getScalarSizeInBits();
     }
+    if (irtype->isVectorTy()) lanes = SALAM::vectorLanes(irtype);
     valueTy = irtype->getTypeID();
     // Link Return Register
     if (size>0) addRegister(irtype, true);
@@ -86,15 +93,17 @@ SALAM::Value::initialize(llvm::Value * irval, SALAM::irvmap * irmap) {
 
 void
 SALAM::Value::addRegister(llvm::Type *irtype, bool istracked) {
-    if (irtype->isPointerTy()) {
-        returnReg = std::make_shared<PointerRegister>(istracked);
+    if (irtype->isVectorTy()) {
+        addVectorRegister(irtype, istracked);
+    } else if (irtype->isPointerTy()) {
+        ownRegister(std::make_shared<PointerRegister>(istracked));
     } else if (irtype->isIntegerTy()) {
-        returnReg = std::make_shared<APIntRegister>(irtype, istracked);
+        ownRegister(std::make_shared<APIntRegister>(irtype, istracked));
     } else if (irtype->isFloatingPointTy()) {
-        returnReg = std::make_shared<APFloatRegister>(irtype, istracked);
+        ownRegister(std::make_shared<APFloatRegister>(irtype, istracked));
     } else {
         //assert(0); // Type is invalid for a register
-        returnReg = nullptr;
+        ownRegister(nullptr);
     }
 }
 
@@ -103,19 +112,19 @@ SALAM::Value::addRegister(llvm::Type *irtype, bool istracked) {
     SALAM::Value::addAPIntRegister(const llvm::APInt & val) {
 
         assert(irtype->isIntegerTy());
-        returnReg = std::make_shared<APIntRegister>(val);
+        ownRegister(std::make_shared<APIntRegister>(val));
     }
     void
     SALAM::Value::addAPIntRegister(const llvm::APSInt & val) {
 
         assert(irtype->isIntegerTy());
-        returnReg = std::make_shared<APIntRegister>(val);
+        ownRegister(std::make_shared<APIntRegister>(val));
     }
     void
     SALAM::Value::addAPFloatRegister(const llvm::APFloat & val) {
 
         assert(irtype->isFloatingPointTy());
-        returnReg = std::make_shared<APFloatRegister>(val);
+        ownRegister(std::make_shared<APFloatRegister>(val));
     }
 #else
     void
@@ -127,7 +136,7 @@ SALAM::Value::addRegister(llvm::Type *irtype, bool istracked) {
             "Only 64-bit and smaller values are \
              supported when not using AP values.");
         bitmask = (bitmask - 1) >> (64 - size);
-        returnReg = std::make_shared<APIntRegister>(val & bitmask);
+        ownRegister(std::make_shared<APIntRegister>(val & bitmask));
     }
     void
     SALAM::Value::addAPFloatRegister(const uint64_t & val) {
@@ -139,19 +148,25 @@ SALAM::Value::addRegister(llvm::Type *irtype, bool istracked) {
             "Only 64-bit and smaller values are \
             supported when not using AP values.");
         bitmask = (bitmask - 1) >> (64 - size);
-        returnReg = std::make_shared<APFloatRegister>(val & bitmask);
+        ownRegister(std::make_shared<APFloatRegister>(val & bitmask));
     }
 #endif
 
 void
 SALAM::Value::addPointerRegister(bool istracked, bool isnull) {
     assert(valueTy == llvm::Type::PointerTyID);
-    returnReg = std::make_shared<PointerRegister>(istracked, isnull);
+    ownRegister(std::make_shared<PointerRegister>(istracked, isnull));
 }
+void
+SALAM::Value::addVectorRegister(llvm::Type *irtype, bool istracked) {
+    assert(irtype->isVectorTy());
+    ownRegister(std::make_shared<VectorRegister>(irtype, istracked));
+}
+
 void
 SALAM::Value::addPointerRegister(uint64_t val, bool istracked, bool isnull) {
     assert(valueTy == llvm::Type::PointerTyID);
-    returnReg = std::make_shared<PointerRegister>(val, istracked, isnull);
+    ownRegister(std::make_shared<PointerRegister>(val, istracked, isnull));
 }
 
 #if USE_LLVM_AP_VALUES
@@ -202,6 +217,11 @@ SALAM::Value::setRegisterValue(const uint64_t data) {
 void
 SALAM::Value::setRegisterValue(uint8_t * data) {
     if (dbg) DPRINTFS(Runtime, owner, "| Set Register Data - ");
+    if (returnReg->isVector()) {
+        if (dbg) DPRINTFS(Runtime, owner, "Vector | Lanes = %d\n", lanes);
+        returnReg->writeVectorData(data, getSizeInBytes());
+        return;
+    }
     switch (valueTy) {
     #if USE_LLVM_AP_VALUES
         case llvm::Type::FloatTyID:
@@ -291,13 +311,15 @@ SALAM::Value::setRegisterValue(bool data) {
 }
 
 void
-SALAM::Value::setRegisterValue(std::shared_ptr<SALAM::Register> reg) {
-    if (reg->isPtr()) {
-        setRegisterValue((reg->getPtrData()));
-    } else if (reg->isFP()) {
-        setRegisterValue((reg->getFloatData()));
+SALAM::Value::setRegisterValue(SALAM::Register &reg) {
+    if (reg.isVector()) {
+        returnReg->writeVectorData(reg.getVectorData(), getSizeInBytes());
+    } else if (reg.isPtr()) {
+        setRegisterValue((reg.getPtrData()));
+    } else if (reg.isFP()) {
+        setRegisterValue((reg.getFloatData()));
     } else {
-        setRegisterValue((reg->getIntData()));
+        setRegisterValue((reg.getIntData()));
     }
     if (dbg) DPRINTFS(Runtime, owner, "||==setRegisterValue====\n");
 }
\ No newline at end of file
@@ -33,14 +33,23 @@ class Value
     protected:
         uint64_t uid = 0;
         uint64_t size = 0;
+        // Number of lanes of a vector value, size is the width of one lane
+        uint64_t lanes = 0;
         gem5::SimObject * owner;
         std::string ir_string;
         std::string ir_stub;
         llvm::Type::TypeID valueTy;
-        std::shared_ptr<SALAM::Register> returnReg;
+        // Return register, a slot of the RegisterFile once the graph is packed
+        SALAM::Register *returnReg = nullptr;
+        // Owns the return register until it is bound into the RegisterFile
+        std::shared_ptr<SALAM::Register> ownedReg;
         bool dbg = false;
         bool inst = false;
 
+        void ownRegister(std::shared_ptr<SALAM::Register> reg) {
+            ownedReg = reg;
+            returnReg = reg.get();
+        }
         void addRegister(llvm::Type *irtype, bool isTracked=true);
     #if USE_LLVM_AP_VALUES
         void addAPIntRegister(const llvm::APInt & val);
@@ -52,6 +61,7 @@ class Value
     #endif
         void addPointerRegister(bool isTracked=true,
                                 bool isNull=false);
+        void addVectorRegister(llvm::Type *irtype, bool isTracked=true);
         void addPointerRegister(uint64_t val,
                                 bool isTracked=true,
                                 bool isNull=false);
@@ -82,11 +92,20 @@ class Value
         uint64_t getSizeInBytes() {
             if (size==0)
                 return 0;
+            else if (lanes)
+                return lanes * (((size - 1) >> 3) + 1);
             else
                 return ((size - 1) >> 3) + 1;
         }
+        bool isVector() { return lanes != 0; }
+        uint64_t getLanes() { return lanes; }
         uint64_t getUID() const { return uid; }
-        std::shared_ptr<SALAM::Register> getReg() { return returnReg; }
+        SALAM::Register *getReg() { return returnReg; }
+        // Rebind the return register to its RegisterFile slot
+        void bindRegister(SALAM::Register *reg) {
+            returnReg = reg;
+            ownedReg.reset();
+        }
         llvm::Type::TypeID getType() { return valueTy; }
         std::string getIRString() { return ir_string; }
         std::string getIRStub() { return ir_stub; }
@@ -104,7 +123,7 @@ class Value
         void setRegisterValue(const uint64_t data);
         void setRegisterValue(uint8_t * data);
         void setRegisterValue(bool data);
-        void setRegisterValue(std::shared_ptr<SALAM::Register> reg);
+        void setRegisterValue(SALAM::Register &reg);
 
         // Helper functions for getting the value of the return register directly from the value
         // Using these functions will increment the read counters on tracked registers
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "hwacc/LLVMRead/src/compute_kernels.hh"
+#include "hwacc/LLVMRead/src/instruction.hh"
+#include "hwacc/LLVMRead/src/operand.hh"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+
+/*
+ * Runs the bit casts that loop vectorized IR emits: an element pointer cast
+ * to a vector pointer that addresses a <4 x float> load, and a cast between
+ * vector types whose result feeds a lane-wise instruction.
+ */
+
+// The instructions of the test have no functional unit, so the HWInterface
+// they would report to is never used and not linked in
+void
+HWInterface::useFunctionalUnit(uint64_t functional_unit, uint64_t latency)
+{
+}
+
+namespace
+{
+
+const char *vectorIR =
+    "define <4 x float> @vec(float* %p, <4 x i32> %v) {\n"
+    "  %vp = bitcast float* %p to <4 x float>*\n"
+    "  %x = load <4 x float>, <4 x float>* %vp\n"
+    "  %y = bitcast <4 x i32> %v to <4 x float>\n"
+    "  %z = fadd <4 x float> %x, %y\n"
+    "  ret <4 x float> %z\n"
+    "}\n";
+
+class VectorBitCast : public ::testing::Test
+{
+  protected:
+    llvm::LLVMContext context;
+    std::unique_ptr<llvm::Module> module;
+    SALAM::irvmap irmap;
+    SALAM::valueListTy values;
+    std::shared_ptr<SALAM::Argument> p;
+    std::shared_ptr<SALAM::Argument> v;
+    std::shared_ptr<SALAM::Instruction> vp;
+    std::shared_ptr<SALAM::Instruction> x;
+    std::shared_ptr<SALAM::Instruction> y;
+    std::shared_ptr<SALAM::Instruction> z;
+
+    void
+    SetUp() override
+    {
+        llvm::SMDiagnostic err;
+        module = llvm::parseAssemblyString(vectorIR, err, context);
+        ASSERT_TRUE(module);
+        llvm::Function *func = module->getFunction("vec");
+        std::vector<llvm::Instruction *> irInsts;
+        for (auto &inst : func->getEntryBlock()) irInsts.push_back(&inst);
+
+        using namespace llvm;
+        p = std::make_shared<SALAM::Argument>(1, nullptr, false);
+        v = std::make_shared<SALAM::Argument>(2, nullptr, false);
+        vp = SALAM::createBitCastInst(3, nullptr, false, Instruction::BitCast, 0, 0);
+        x = SALAM::createLoadInst(4, nullptr, false, Instruction::Load, 0, 0);
+        y = SALAM::createBitCastInst(5, nullptr, false, Instruction::BitCast, 0, 0);
+        z = SALAM::createFAddInst(6, nullptr, false, Instruction::FAdd, 0, 0);
+        values = {p, v, vp, x, y, z};
+        irmap.insert(SALAM::irvmaptype(func->getArg(0), p));
+        irmap.insert(SALAM::irvmaptype(func->getArg(1), v));
+        for (size_t i = 0; i < 4; i++)
+            irmap.insert(SALAM::irvmaptype(irInsts[i], values[i + 2]));
+        p->initialize(func->getArg(0), &irmap);
+        v->initialize(func->getArg(1), &irmap);
+        for (size_t i = 0; i < 4; i++) {
+            auto inst = std::static_pointer_cast<SALAM::Instruction>(values[i + 2]);
+            inst->initialize(irInsts[i], &irmap, &values);
+        }
+
+        // Lowered as LLVMInterface does with compute kernels enabled
+        for (auto inst : {vp, x, y, z}) {
+            if (SALAM::isLaneWise(inst.get())) {
+                auto kernel = SALAM::lowerVectorKernel(inst.get());
+                ASSERT_NE(kernel, nullptr) << inst->getIRString();
+                inst->setVectorKernel(kernel);
+            } else {
+                inst->setComputeKernel(SALAM::lowerComputeKernel(inst.get()));
+            }
+        }
+    }
+
+    // Move the registers into a register file as LLVMInterface does
+    void
+    pack(SALAM::RegisterFile &file)
+    {
+        size_t laneBytes = 0;
+        for (auto val : values)
+            laneBytes += SALAM::RegisterFile::laneSpace(*(val->getReg()));
+        file.reserve(values.size(), laneBytes);
+        for (auto val : values) val->bindRegister(file.bind(*(val->getReg())));
+    }
+
+    // Schedule inst once its dependencies have committed
+    void
+    run(std::shared_ptr<SALAM::Instruction> inst)
+    {
+        for (auto dep : inst->runtimeInitialize()) inst->setOperandValue(dep);
+        EXPECT_TRUE(inst->launch());
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(VectorBitCast, VectorToVector)
+{
+    EXPECT_TRUE(SALAM::isLaneWise(y.get()));
+    uint32_t bits[4] = {0x3f800000, 0x40000000, 0xbf800000, 0};
+    v->setRegisterValue(reinterpret_cast<uint8_t *>(bits));
+    run(y);
+
+    float lanes[4];
+    std::memcpy(lanes, y->getReg()->getVectorData(), sizeof(lanes));
+    EXPECT_EQ(lanes[0], 1.0f);
+    EXPECT_EQ(lanes[1], 2.0f);
+    EXPECT_EQ(lanes[2], -1.0f);
+    EXPECT_EQ(lanes[3], 0.0f);
+}
+
+TEST_F(VectorBitCast, PointerFeedsVectorLoad)
+{
+    EXPECT_FALSE(SALAM::isLaneWise(vp.get()));
+    p->setRegisterValue((uint64_t)0x80001040);
+    run(vp);
+    EXPECT_EQ(vp->getReg()->getPtrData(), 0x80001040);
+
+    for (auto dep : x->runtimeInitialize()) x->setOperandValue(dep);
+    std::unique_ptr<MemoryRequest> req(x->createMemoryRequest());
+    ASSERT_TRUE(req);
+    EXPECT_EQ(req->getAddress(), 0x80001040);
+
+    // Complete the load the way LLVMInterface::readCommit does
+    float loaded[4] = {0.5f, 1.5f, 2.5f, 3.5f};
+    std::memcpy(req->getBuffer(), loaded, sizeof(loaded));
+    x->setRegisterValue(req->getBuffer());
+
+    uint32_t bits[4] = {0x3f800000, 0x3f800000, 0x3f800000, 0x3f800000};
+    v->setRegisterValue(reinterpret_cast<uint8_t *>(bits));
+    run(y);
+    run(z);
+
+    float sums[4];
+    std::memcpy(sums, z->getReg()->getVectorData(), sizeof(sums));
+    for (int i = 0; i < 4; i++) EXPECT_EQ(sums[i], loaded[i] + 1.0f);
+}
+
+// Packed vector registers keep their lanes in the lane arena of the file,
+// while the slots stay as small as scalar registers
+TEST_F(VectorBitCast, PackedLanes)
+{
+    EXPECT_LE(sizeof(SALAM::Register), 32u);
+    SALAM::RegisterFile file;
+    pack(file);
+    const uint8_t *arena = file[1].getVectorData(false);
+    for (size_t i = 3; i < file.size(); i++) {
+        if (!file[i].isVector()) continue;
+        EXPECT_EQ(file[i].getVectorData(false) - arena, 16 * (i - 2));
+    }
+
+    // Clones of an instruction write the same slot
+    auto copy = y->clone();
+    EXPECT_EQ(copy->getReg(), y->getReg());
+
+    float loaded[4] = {0.5f, 1.5f, 2.5f, 3.5f};
+    x->setRegisterValue(reinterpret_cast<uint8_t *>(loaded));
+    uint32_t bits[4] = {0x3f800000, 0x40000000, 0xbf800000, 0};
+    v->setRegisterValue(reinterpret_cast<uint8_t *>(bits));
+    run(copy);
+    run(z);
+    float sums[4];
+    std::memcpy(sums, z->getReg()->getVectorData(), sizeof(sums));
+    EXPECT_EQ(sums[0], 1.5f);
+    EXPECT_EQ(sums[1], 3.5f);
+    EXPECT_EQ(sums[2], 1.5f);
+    EXPECT_EQ(sums[3], 3.5f);
+}
@@ -9,10 +9,11 @@ class NoncoherentDma(DmaDevice) :
     cluster_dma = RequestPort("Cluster-side DMA port")
     pio_addr = Param.Addr("Device Address")
     pio_delay = Param.Latency('100ns', "PIO Latency")
-    pio_size = Param.Addr(21, "MMR Size")
+    pio_size = Param.Addr(21, "MMR Size, 52 or more maps the strided transfer registers")
     buffer_size = Param.UInt64(1024, "Read buffer size")
     max_pending = Param.Unsigned(8, "Maximum number of pending DMA reads")
     max_req_size = Param.Unsigned(Parent.cache_line_size, "Maximum size of a DMA request")
     gic = Param.BaseGic(Parent.any, "Gic on which to trigger interrupts")
     int_num = Param.UInt32(200, "Interrupt number that connects to GIC")
     clock_period = Param.Int(10, "Clock period in ns")
+    descriptor_channels = Param.Unsigned(0, "Number of descriptor chain channels, each with its own FIFOs and registers after the MMR transfer registers")
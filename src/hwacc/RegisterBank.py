@@ -8,4 +8,7 @@ class RegisterBank(AbstractMemory):
 
     reg_port = ResponsePort("Responder port for private acclerator accesses")
     load_port = ResponsePort("Responder port for preloading the registers")
-    delta_time = Param.Latency('10ns', "Request to response latency")
\ No newline at end of file
+    delta_time = Param.Latency('10ns', "Request to response latency")
+    cacti = Param.Bool(False, "Estimate the area and energy of the registers with CACTI at init")
+    cacti_word_size = Param.MemorySize('8B', "Register width modeled by CACTI")
+    cacti_cache = Param.String("cacti_cache.txt", "File that memoizes CACTI results across runs, relative to the working directory. Empty keeps results in memory")
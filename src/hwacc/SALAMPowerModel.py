@@ -7,6 +7,8 @@ class SALAMPowerModel(SimObject):
     type = "SALAMPowerModel"
     # gem5-SALAM attached header
     cxx_header = "hwacc/HWModeling/src/salam_power_model.hh"
+    functional_units = Param.FunctionalUnits(Parent.any,
+        "Functional units whose power models make up the datapath")
     ### --- Do Not Modify Below This Line --- ###
     ### Templates
     ### YML Type: functional_unit.power_model
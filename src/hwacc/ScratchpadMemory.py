@@ -2,6 +2,8 @@ from m5.params import *
 from m5.proxy import *
 from m5.objects.AbstractMemory import AbstractMemory
 
+class SPMBankPartition(ScopedEnum): vals = ['cyclic', 'block']
+
 class ScratchpadMemory(AbstractMemory):
     type = 'ScratchpadMemory'
     cxx_header = 'hwacc/scratchpad_memory.hh'
@@ -14,4 +16,13 @@ class ScratchpadMemory(AbstractMemory):
     read_on_invalid = Param.Bool(False, "Enable reads on invalid memory segments when ready mode is used")
     write_on_valid = Param.Bool(True, "Enable writes on valid memory sectors when ready mode is used")
     reset_on_scratchpad_read = Param.Bool(True, "Reset ready bit on private scratchpad memory read")
-    bandwidth = Param.MemoryBandwidth('12GB/s', "Combined read and write bandwidth per port")
\ No newline at end of file
+    bandwidth = Param.MemoryBandwidth('12GB/s', "Combined read and write bandwidth per port")
+    num_banks = Param.UInt32(0, "Number of SPM banks. 0 disables bank conflict modeling")
+    bank_partition = Param.SPMBankPartition('cyclic', "cyclic: interleave addresses across banks. block: split the address range into contiguous banks")
+    bank_interleave = Param.MemorySize('8B', "Bytes mapped to one bank before moving to the next with cyclic partitioning")
+    bank_read_ports = Param.UInt32(1, "Interleave granules each bank reads per bank cycle")
+    bank_write_ports = Param.UInt32(1, "Interleave granules each bank writes per bank cycle")
+    bank_cycle = Param.Latency('10ns', "Bank access period. Accesses beyond the bank ports in a cycle serialize into later cycles")
+    cacti = Param.Bool(False, "Estimate the area and energy of the SPM arrays with CACTI at init")
+    cacti_word_size = Param.MemorySize('4B', "Word width of the SPM arrays modeled by CACTI")
+    cacti_cache = Param.String("cacti_cache.txt", "File that memoizes CACTI results across runs, relative to the working directory. Empty keeps results in memory")
@@ -0,0 +1,101 @@
+# Compares host simulation throughput of two gem5 binaries on legacy benchmarks
+# Host MIPS = dynamic LLVM instructions / active simulation time / 1e6
+# Both are read from the compute unit stats, the active time is sampled by
+# the host profiler of LLVMInterface (host_profile_period). Binaries built
+# before the compute unit stats existed only print a performance report to
+# stdout, which is parsed instead when stats.txt has no compute unit stats.
+# Their active time is the std::chrono runtime of the engine rather than the
+# sampled profile, and a warning is printed when the two binaries differ
+import os
+import re
+import subprocess
+import sys
+from argparse import ArgumentParser
+
+parser = ArgumentParser()
+parser.add_argument("-b", "--baseline", dest="baseline", required=True, help="Baseline gem5 binary")
+parser.add_argument("-c", "--candidate", dest="candidate", required=True, help="Candidate gem5 binary")
+parser.add_argument("-w", "--workloads", dest="workloads", default="legacy/gemm,legacy/fft", help="Comma separated benchmarks under $M5_PATH/benchmarks")
+parser.add_argument("-r", "--runs", dest="runs", type=int, default=3, help="Runs per binary, the best run is reported")
+parser.add_argument("-o", "--outdir", dest="outdir", default="MIPS_OUT", help="Output directory for simulator logs")
+args = parser.parse_args()
+
+m5Path = os.environ.get("M5_PATH")
+if m5Path is None:
+	sys.exit("M5_PATH is not set")
+
+dynamicRe = re.compile(r"^\S+\.dynamicInsts\s+(\d+)", re.MULTILINE)
+activeRe = re.compile(r"^\S+\.hostActiveSeconds\s+(\S+)", re.MULTILINE)
+legacyDynamicRe = re.compile(r"Dynamic Instructions:\s+(\d+)")
+legacyActiveRe = re.compile(r"Simulation Time \(Active\):\s+(\d+)h (\d+)m (\d+)s (\d+)ms")
+
+# Sum over every accelerator in the system and every stats dump
+def parseStats(dump):
+	insts = 0
+	seconds = 0.0
+	for match in dynamicRe.finditer(dump):
+		insts += int(match.group(1))
+	for match in activeRe.finditer(dump):
+		seconds += float(match.group(1))
+	return insts, seconds
+
+# Sum over the performance reports every accelerator printed
+def parseLegacyReport(log):
+	insts = 0
+	seconds = 0.0
+	for match in legacyDynamicRe.finditer(log):
+		insts += int(match.group(1))
+	for match in legacyActiveRe.finditer(log):
+		h, m, s, ms = [int(x) for x in match.groups()]
+		seconds += h*3600 + m*60 + s + ms/1000.0
+	return insts, seconds
+
+def runBench(binary, bench, outdir):
+	kernel = os.path.join(m5Path, "benchmarks", bench, "host", "main.elf")
+	cmd = [binary, "--outdir=" + outdir,
+		"configs/SALAM/fs_hwacc.py",
+		"--mem-size=4GB",
+		"--kernel=" + kernel,
+		"--disk-image=" + os.path.join(m5Path, "baremetal", "common", "fake.iso"),
+		"--machine-type=VExpress_GEM5_V1",
+		"--dtb-file=none", "--bare-metal",
+		"--cpu-type=DerivO3CPU",
+		"--accpath=" + os.path.join(m5Path, "benchmarks"),
+		"--accbench=" + bench,
+		"--caches", "--l2cache", "--acc_cache"]
+	os.makedirs(outdir, exist_ok=True)
+	result = subprocess.run(cmd, cwd=m5Path, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+	with open(os.path.join(outdir, "sim.log"), "w") as log:
+		log.write(result.stdout)
+	source = "stats"
+	insts, seconds = 0, 0.0
+	statsFile = os.path.join(outdir, "stats.txt")
+	if os.path.exists(statsFile):
+		with open(statsFile) as stats:
+			insts, seconds = parseStats(stats.read())
+	if insts == 0 or seconds == 0.0:
+		source = "report"
+		insts, seconds = parseLegacyReport(result.stdout)
+	if insts == 0 or seconds == 0.0:
+		sys.exit("No compute unit stats or performance report found for " + bench + ", see " + outdir)
+	return insts, seconds, source
+
+def bestMIPS(binary, label, bench):
+	best = None
+	for run in range(args.runs):
+		outdir = os.path.join(args.outdir, label, bench, str(run))
+		insts, seconds, source = runBench(binary, bench, outdir)
+		mips = insts / seconds / 1e6
+		if best is None or mips > best[2]:
+			best = (insts, seconds, mips, source)
+	return best
+
+print("%-24s %14s %14s %14s %10s" % ("Benchmark", "Instructions", "Baseline MIPS", "Candidate MIPS", "Speedup"))
+for bench in args.workloads.split(","):
+	base = bestMIPS(args.baseline, "baseline", bench)
+	cand = bestMIPS(args.candidate, "candidate", bench)
+	if base[0] != cand[0]:
+		print("Warning: " + bench + " executed a different number of instructions")
+	if base[3] != cand[3]:
+		print("Warning: " + bench + " active time is read from the " + base[3] + " of the baseline and the " + cand[3] + " of the candidate")
+	print("%-24s %14d %14.3f %14.3f %9.2fx" % (bench, cand[0], base[2], cand[2], cand[2]/base[2]))
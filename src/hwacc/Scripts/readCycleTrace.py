@@ -0,0 +1,62 @@
+# Loads a cycle trace written by HWStatistics with cycle_tracking enabled
+# The format is described in HWModeling/src/cycle_trace.hh
+import struct
+import zlib
+from argparse import ArgumentParser
+
+import numpy as np
+
+MAGIC = b"SALAMCT\0"
+VERSION = 1
+FLAG_COMPRESSED = 0x1
+
+def readCycleTrace(path):
+	"""Returns a dict mapping each column name to an int32 numpy array"""
+	with open(path, "rb") as trace:
+		data = trace.read()
+	if data[:8] != MAGIC:
+		raise ValueError("%s is not a cycle trace" % path)
+	version, flags, chunkRows, numColumns = struct.unpack_from("<4I", data, 8)
+	if version != VERSION:
+		raise ValueError("Unsupported cycle trace version %d" % version)
+	pos = 24
+	names = []
+	for _ in range(numColumns):
+		(length,) = struct.unpack_from("<I", data, pos)
+		names.append(data[pos+4:pos+4+length].decode())
+		pos += 4 + length
+
+	chunks = []
+	while pos + 8 <= len(data):
+		rows, stored = struct.unpack_from("<2I", data, pos)
+		payload = data[pos+8:pos+8+stored]
+		pos += 8 + stored
+		if len(payload) < stored:
+			# Truncated by a simulation that did not exit cleanly
+			break
+		if flags & FLAG_COMPRESSED:
+			payload = zlib.decompress(payload)
+		chunks.append(np.frombuffer(payload, dtype="<i4").reshape(numColumns, rows))
+
+	if chunks:
+		table = np.concatenate(chunks, axis=1)
+	else:
+		table = np.empty((numColumns, 0), dtype="<i4")
+	return dict(zip(names, table))
+
+if __name__ == "__main__":
+	parser = ArgumentParser()
+	parser.add_argument("-f", "--file", dest="myFile", required=True, help="Cycle trace to load")
+	parser.add_argument("-c", "--csv", dest="myCsv", help="Also saves the trace as CSV")
+	args = parser.parse_args()
+
+	columns = readCycleTrace(args.myFile)
+	cycles = len(columns["cycle"]) if "cycle" in columns else 0
+	print("Cycles: %d" % cycles)
+	for name, values in columns.items():
+		if name == "cycle" or not cycles:
+			continue
+		print("  %-24s max %6d  avg %10.4f" % (name, values.max(), values.mean()))
+	if args.myCsv:
+		np.savetxt(args.myCsv, np.column_stack(list(columns.values())), fmt="%d",
+			delimiter=",", header=",".join(columns.keys()), comments="")
@@ -12,9 +12,11 @@ class StreamBuffer(ClockedObject):
     status_in = ResponsePort("Stream buffer status port")
     status_out = ResponsePort("Stream buffer status port")
     buffer_size = Param.UInt64(256, "Stream buffer depth in bytes")
+    tdata_width = Param.Unsigned(0, "TDATA width in bytes, stream accesses must be whole beats. 0 accepts any access size")
+    frame_size = Param.UInt64(0, "Bytes per frame, TLAST is asserted on the last beat of each frame. 0 leaves TLAST to the producer")
     stream_address = Param.Addr("Address for accessing stream data")
     stream_size = Param.Addr("Stream buffer width in bytes")
     status_address = Param.Addr("Address for accessing buffer status")
-    status_size = Param.Addr(4, "Size of the buffer status register")
+    status_size = Param.Addr(8, "Size of the buffer status register, the buffered bytes and the bytes up to the next TLAST")
     stream_latency = Param.Latency('1ns', 'Stream W/R latency')
     bandwidth = Param.MemoryBandwidth('12.6GB/s', "Combined read and write bandwidth")
\ No newline at end of file
@@ -9,6 +9,7 @@ class StreamDma(DmaDevice) :
     pio_addr = Param.Addr("Device Address")
     pio_delay = Param.Latency('100ns', "PIO Latency")
     pio_size = Param.Addr(32, "MMR Size")
+    strided = Param.Bool(False, "Map the strided frame registers, moving the buffer access range to offset 64")
     stream_in = ResponsePort("Stream buffer access port for S2MM")
     stream_out = ResponsePort("Stream buffer access port for MM2S")
     stream_addr = Param.Addr("Stream interface address")
@@ -0,0 +1,19 @@
+from m5.params import *
+from m5.proxy import *
+from m5.objects.ClockedObject import ClockedObject
+
+class StreamSwitch(ClockedObject):
+    type = 'StreamSwitch'
+    cxx_header = 'hwacc/stream_switch.hh'
+    system = Param.System(Parent.any, "System this devices is part of")
+    stream_in = VectorResponsePort("Producer ports, one per switch input")
+    stream_out = VectorResponsePort("Consumer ports, one per switch output")
+    in_address = Param.Addr("Base address of the input windows. Input N spans one stream_size slot per TDEST")
+    out_address = Param.Addr("Base address of the output windows. Output N is stream_size bytes at out_address + N*stream_size")
+    stream_size = Param.Addr(8, "Stream width in bytes of each TDEST slot and output window")
+    tdest_map = VectorParam.Int([], "Output for each TDEST, -1 broadcasts to all outputs. Empty sends TDEST N to output N")
+    broadcast = Param.Bool(False, "Copy every transfer to all outputs regardless of TDEST")
+    in_buffer_size = Param.UInt64(256, "Depth in bytes of each input FIFO")
+    out_buffer_size = Param.UInt64(256, "Depth in bytes of each output FIFO")
+    stream_latency = Param.Latency('1ns', 'Stream W/R latency')
+    bandwidth = Param.MemoryBandwidth('12.6GB/s', "Read and write bandwidth of each port")
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <iomanip>
 
 using namespace std;
@@ -31,7 +32,12 @@ CommInterface::CommInterface(const CommInterfaceParams &p) :
     tickEvent(this),
     cacheLineSize(p.cache_line_size),
     clock_period(p.clock_period),
-    reset_spm(p.reset_spm) {
+    reset_spm(p.reset_spm),
+    commStats(*this) {
+    maxOutstanding = p.max_outstanding;
+    coalesceRequests = p.coalesce_requests;
+    routesValid = false;
+    fatal_if(maxOutstanding == 0, "%s needs at least one MSHR per port\n", name());
     processDelay = 1000 * clock_period;
     FLAG_OFFSET = 0;
     CONFIG_OFFSET = flag_size;
@@ -133,13 +139,14 @@ CommInterface::RegPort::sendPacket(PacketPtr pkt) {
 
 void
 CommInterface::recvPacket(PacketPtr pkt) {
-	if (pkt->isRead()) {
+    if (mshrs.count(pkt)) {
+        retireMSHR(pkt);
+    } else if (pkt->isRead()) {
         MemoryRequest * readReq = findMemRequest(pkt, true);
-        RequestPort * carrier = readReq->getCarrierPort();
-        if (MemSidePort * port = dynamic_cast<MemSidePort *>(carrier)) port->readReq = nullptr;
-        if (SPMPort * port = dynamic_cast<SPMPort *>(carrier)) port->readReq = nullptr;
         if (debug()) DPRINTF(CommInterface, "Done with a read. addr: 0x%x, size: %d\n", pkt->req->getPaddr(), pkt->getSize());
-        pkt->writeData(readReq->buffer + (pkt->req->getPaddr() - readReq->beginAddr));
+        uint8_t *dest = readReq->buffer + (pkt->req->getPaddr() - readReq->beginAddr);
+        // Register reads normally land in the request buffer already
+        if (pkt->getConstPtr<uint8_t>() != dest) pkt->writeData(dest);
         if (debug()) DPRINTF(CommInterface, "Read:%s\n", readReq->printBuffer());
         for (int i = pkt->req->getPaddr() - readReq->beginAddr;
              i < pkt->req->getPaddr() - readReq->beginAddr + pkt->getSize(); i++)\
@@ -166,9 +173,6 @@ CommInterface::recvPacket(PacketPtr pkt) {
         }
     } else if (pkt->isWrite()) {
         MemoryRequest * writeReq = findMemRequest(pkt, false);
-        RequestPort * carrier = writeReq->getCarrierPort();
-        if (MemSidePort * port = dynamic_cast<MemSidePort *>(carrier)) port->writeReq = nullptr;
-        if (SPMPort * port = dynamic_cast<SPMPort *>(carrier)) port->writeReq = nullptr;
         if (debug()) DPRINTF(CommInterface, "Done with a write. addr: 0x%x, size: %d\n", pkt->req->getPaddr(), pkt->getSize());
         writeReq->writeDone += pkt->getSize();
         if (!(writeReq->needToWrite)) {
@@ -213,140 +217,52 @@ CommInterface::checkMMR() {
     }
 }
 
-bool
-CommInterface::inStreamRange(Addr add) {
-    for (auto port : streamPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool
-CommInterface::inSPMRange(Addr add) {
-    for (auto port : spmPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool
-CommInterface::inRegRange(Addr add) {
-    for (auto port : regPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool
-CommInterface::inLocalRange(Addr add) {
-    for (auto port : localPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool
-CommInterface::inGlobalRange(Addr add) {
-    for (auto port : globalPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-CommInterface::MemSidePort *
-CommInterface::getValidLocalPort(Addr add, bool read) {
-    for (auto port : localPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add) && !(port->isStalled())) {
-                if ((read && !(port->readReq)) || (!read && !(port->writeReq))) {
-                    return port;
-                }
-            }
-        }
-    }
-    return nullptr;
-}
-
-CommInterface::MemSidePort *
-CommInterface::getValidGlobalPort(Addr add, bool read) {
-    for (auto port : globalPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add) && !(port->isStalled())) {
-                if ((read && !(port->readReq)) || (!read && !(port->writeReq))) {
-                    return port;
-                }
-            }
-        }
-    }
-    return nullptr;
-}
-
-CommInterface::MemSidePort *
-CommInterface::getValidStreamPort(Addr add, size_t len, bool read) {
-    for (auto port : streamPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add) && !(port->isStalled())) {
-                if (((read && !(port->readReq)) || (!read && !(port->writeReq))) && port->streamValid(len, read)) {
-                    return port;
-                }
-            }
-        }
-    }
-    return nullptr;
-}
-
-CommInterface::SPMPort *
-CommInterface::getValidSPMPort(Addr add, size_t len, bool read) {
-    for (auto port : spmPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add) && !(port->isStalled())) {
-                if (((read && !(port->readReq)) || (!read && !(port->writeReq)))) {
-                    if (port->canAccess(add, len, read))
-                        return port;
-                }
-            }
-        }
-    }
-    return nullptr;
-}
-
-CommInterface::RegPort *
-CommInterface::getValidRegPort(Addr add) {
-    for (auto port : regPorts) {
-        AddrRangeList adl = port->getAddrRanges();
-        for (auto address : adl) {
-            if (address.contains(add)) {
+void
+CommInterface::buildRoutes() {
+    routeTable.clear();
+    for (auto port : regPorts) routeTable.add(RegRoute, port, port->getAddrRanges());
+    for (auto port : streamPorts) routeTable.add(StreamRoute, port, port->getAddrRanges());
+    for (auto port : spmPorts) routeTable.add(SPMRoute, port, port->getAddrRanges());
+    for (auto port : localPorts) routeTable.add(LocalRoute, port, port->getAddrRanges());
+    for (auto port : globalPorts) routeTable.add(GlobalRoute, port, port->getAddrRanges());
+    routeTable.build();
+    routesValid = true;
+    if (debug()) DPRINTF(CommInterface, "Built routing table with %d entries\n", routeTable.size());
+}
+
+const CommInterface::Route *
+CommInterface::findRoute(Addr add) {
+    if (!routesValid) buildRoutes();
+    return routeTable.find(add);
+}
+
+RequestPort *
+CommInterface::getValidPort(const Route &route, Addr add, size_t len, bool read) {
+    for (auto mport : route.ports) {
+        switch (route.kind) {
+          case StreamRoute: {
+            MemSidePort *port = static_cast<MemSidePort *>(mport);
+            // Stream ports keep a single packet in flight to preserve ordering
+            bool idle = read ? !port->readsInFlight : !port->writesInFlight;
+            if (!port->isStalled() && idle && port->streamValid(len, read))
                 return port;
-            }
+            break;
+          }
+          case SPMRoute: {
+            SPMPort *port = static_cast<SPMPort *>(mport);
+            if (!port->isStalled() && port->canIssue(read) && port->canAccess(add, len, read))
+                return port;
+            break;
+          }
+          case LocalRoute:
+          case GlobalRoute: {
+            MemSidePort *port = static_cast<MemSidePort *>(mport);
+            if (!port->isStalled() && port->canIssue(read))
+                return port;
+            break;
+          }
+          default:
+            return mport;
         }
     }
     return nullptr;
@@ -359,41 +275,24 @@ CommInterface::processMemoryRequests() {
         for (auto it=readQueue.begin(); it!=readQueue.end(); ) {
             Addr address = (*it)->currentReadAddr;
             if (debug()) DPRINTF(CommInterfaceQueues, "Request Address: %lx\n", address);
-            RequestPort * mport;
-            if (inStreamRange(address)) {
-                mport = getValidStreamPort(address, (*it)->readLeft, true);
-            } else if (inSPMRange(address)) {
-                mport = getValidSPMPort(address, (*it)->readLeft, true);
-            } else if (inLocalRange(address)) {
-                mport = getValidLocalPort(address, true);
-            } else if (inGlobalRange(address)) {
-                mport = getValidGlobalPort(address, true);
-            } else {
+            const Route *route = findRoute(address);
+            if (!route || (route->kind == RegRoute)) {
                 panic("Address %lx is not reachable by any ports\n", address);
             }
-            if (SPMPort * port = dynamic_cast<SPMPort *>(mport)) {
-                if (debug()) DPRINTF(CommInterfaceQueues, "Found available memory port\n");
-                port->readReq = (*it);
-                port->readReq->setCarrierPort(port);
+            bool stream = (route->kind == StreamRoute);
+            if (!stream && coalesceRequests && coalesceRead(*it)) {
                 it = readQueue.erase(it);
-                if (port->readReq && port->readReq->needToRead) {
-                    if (debug()) DPRINTF(CommInterfaceQueues, "Trying read on available memory port\n");
-                    tryRead(port);
-                    accRdQ.push_back(port->readReq);
-                    // if (!port->readReq->needToRead)
-                    //     port->readReq = NULL;
-                }
-            } else if (MemSidePort * port = dynamic_cast<MemSidePort *>(mport)) {
+                continue;
+            }
+            if (RequestPort * port = getValidPort(*route, address, (*it)->readLeft, true)) {
                 if (debug()) DPRINTF(CommInterfaceQueues, "Found available memory port\n");
-                port->readReq = (*it);
-                port->readReq->setCarrierPort(port);
+                MemoryRequest * readReq = (*it);
+                readReq->setCarrierPort(port);
                 it = readQueue.erase(it);
-                if (port->readReq && port->readReq->needToRead) {
+                if (readReq->needToRead) {
                     if (debug()) DPRINTF(CommInterfaceQueues, "Trying read on available memory port\n");
-                    tryRead(port);
-                    accRdQ.push_back(port->readReq);
-                    // if (!port->readReq->needToRead)
-                    //     port->readReq = NULL;
+                    if (route->kind == SPMRoute) tryRead(static_cast<SPMPort *>(port), readReq);
+                    else tryRead(static_cast<MemSidePort *>(port), readReq);
                 }
             } else {
                 if (debug()) DPRINTF(CommInterfaceQueues, "Found no ports able to read %d bytes from %lx\n", (*it)->length, address);
@@ -404,41 +303,25 @@ CommInterface::processMemoryRequests() {
         for (auto it=writeQueue.begin(); it!=writeQueue.end(); ) {
             Addr address = (*it)->currentWriteAddr;
             if (debug()) DPRINTF(CommInterfaceQueues, "Request Address: %lx\n", address);
-            RequestPort * mport;
-            if (inStreamRange(address)) {
-                mport = getValidStreamPort(address, (*it)->writeLeft, false);
-            } else if (inSPMRange(address)) {
-                mport = getValidSPMPort(address, (*it)->writeLeft, false);
-            } else if (inLocalRange(address)) {
-                mport = getValidLocalPort(address, false);
-            } else if (inGlobalRange(address)) {
-                mport = getValidGlobalPort(address, false);
-            } else {
+            const Route *route = findRoute(address);
+            if (!route || (route->kind == RegRoute)) {
                 panic("Address %lx is not reachable by any ports\n", address);
             }
-            if (SPMPort * port = dynamic_cast<SPMPort*>(mport)) {
+            bool stream = (route->kind == StreamRoute);
+            if (RequestPort * port = getValidPort(*route, address, (*it)->writeLeft, false)) {
                 if (debug()) DPRINTF(CommInterfaceQueues, "Found available memory port\n");
-                port->writeReq = (*it);
-                port->writeReq->setCarrierPort(port);
+                MemoryRequest * writeReq = (*it);
+                writeReq->setCarrierPort(port);
                 it = writeQueue.erase(it);
-                if (port->writeReq && port->writeReq->needToWrite) {
+                if (writeReq->needToWrite) {
                     if (debug()) DPRINTF(CommInterfaceQueues, "Trying write on available memory port\n");
-                    tryWrite(port);
-                    accWrQ.push_back(port->writeReq);
-                    // if (!port->writeReq->needToWrite)
-                    //     port->writeReq = NULL;
-                }
-            } else if (MemSidePort * port = dynamic_cast<MemSidePort*>(mport)) {
-                if (debug()) DPRINTF(CommInterfaceQueues, "Found available memory port\n");
-                port->writeReq = (*it);
-                port->writeReq->setCarrierPort(port);
-                it = writeQueue.erase(it);
-                if (port->writeReq && port->writeReq->needToWrite) {
-                    if (debug()) DPRINTF(CommInterfaceQueues, "Trying write on available memory port\n");
-                    tryWrite(port);
-                    accWrQ.push_back(port->writeReq);
-                    // if (!port->writeReq->needToWrite)
-                    //     port->writeReq = NULL;
+                    if (route->kind == SPMRoute) {
+                        SPMPort *spm = static_cast<SPMPort *>(port);
+                        tryWrite(spm, nextWrite(writeReq, coalesceRequests, it, spm));
+                    } else {
+                        tryWrite(static_cast<MemSidePort *>(port),
+                                 nextWrite(writeReq, coalesceRequests && !stream, it));
+                    }
                 }
             } else {
                 if (debug()) DPRINTF(CommInterfaceQueues, "Found no ports able to write %d bytes to %lx\n", (*it)->length, address);
@@ -464,193 +347,252 @@ CommInterface::tick() {
         processMemoryRequests();
 }
 
-void
-CommInterface::tryRead(MemSidePort * port) {
-    MemoryRequest * readReq = port->readReq;
+unsigned
+CommInterface::chunkSize(Addr add, Tick left) {
+    // Requests are split at cache line boundaries
+    Tick size = cacheLineSize - (add % cacheLineSize);
+    return (left < size) ? left : size;
+}
+
+bool
+CommInterface::coalesceRead(MemoryRequest * readReq) {
+    Addr add = readReq->currentReadAddr;
+    Addr line = lineOf(add);
+    PacketPtr carrier;
+    // Never coalesce across a store to the line issued after the read
+    if (!lines.coalescible(line, carrier)) return false;
+    MSHR &mshr = mshrs.at(carrier);
+    unsigned size = chunkSize(add, readReq->readLeft);
+    if ((add < mshr.addr) || (add + size > mshr.addr + mshr.size)) return false;
+    if (debug()) DPRINTF(CommInterface, "Coalescing read of addr: 0x%016x, %d bytes onto packet for addr: 0x%016x\n",
+        add, size, mshr.addr);
+
+    mshr.targets.push_back({readReq, add, size});
+    readReq->setCarrierPort(mshr.port);
+    readReq->currentReadAddr += size;
+    readReq->readLeft -= size;
+    if (!(readReq->readLeft > 0)) readReq->needToRead = false;
+    commStats.coalescedReads++;
+    return true;
+}
+
+std::vector<CommInterface::MSHR::Target>
+CommInterface::nextWrite(MemoryRequest * writeReq, bool combine,
+                         std::list<MemoryRequest*>::iterator &next, SPMPort * spm) {
+    std::vector<MSHR::Target> targets;
+    Addr lineEnd = lineOf(writeReq->currentWriteAddr) + cacheLineSize;
+    while (writeReq) {
+        Addr add = writeReq->currentWriteAddr;
+        unsigned size = chunkSize(add, writeReq->writeLeft);
+        targets.push_back({writeReq, add, size});
+        writeReq->currentWriteAddr += size;
+        writeReq->writeLeft -= size;
+        if (!(writeReq->writeLeft > 0)) writeReq->needToWrite = false;
+
+        // Combine with a queued store that starts where this one ends
+        add += size;
+        writeReq = nullptr;
+        if (!combine || (add >= lineEnd)) break;
+        for (auto it = writeQueue.begin(); it != writeQueue.end(); ++it) {
+            MemoryRequest * adjacent = *it;
+            if (!adjacent->needToWrite || (adjacent->currentWriteAddr != add)) continue;
+            if (spm && !spm->canAccess(add, chunkSize(add, adjacent->writeLeft), false)) break;
+            if (debug()) DPRINTF(CommInterface, "Combining write to addr: 0x%016x with write to addr: 0x%016x\n",
+                add, targets.front().addr);
+            adjacent->setCarrierPort(targets.front().req->getCarrierPort());
+            if (it == next) next = writeQueue.erase(it);
+            else writeQueue.erase(it);
+            commStats.combinedWrites++;
+            writeReq = adjacent;
+            break;
+        }
+    }
+    return targets;
+}
+
+uint8_t *
+CommInterface::allocLineBuffer() {
+    if (freeLineBuffers.empty()) {
+        lineBuffers.emplace_back(new uint8_t[cacheLineSize]);
+        return lineBuffers.back().get();
+    }
+    uint8_t *data = freeLineBuffers.back();
+    freeLineBuffers.pop_back();
+    return data;
+}
+
+PacketPtr
+CommInterface::createReadPacket(MemoryRequest * readReq, RequestPort * port, bool spm) {
     Request::Flags flags;
-    if (readReq->readLeft <= 0) {
-        if (debug()) DPRINTF(CommInterface, "Something went wrong. Shouldn't try to read if there aren't reads left\n");
-        return;
-    }
-    int size;
-    if (readReq->currentReadAddr % cacheLineSize) {
-        size = cacheLineSize - (readReq->currentReadAddr % cacheLineSize);
-        if (debug()) DPRINTF(CommInterface, "Aligning\n");
-    } else {
-        size = cacheLineSize;
-    }
-    size = readReq->readLeft > (size - 1) ? size : readReq->readLeft;
-    RequestPtr req = make_shared<Request>(readReq->currentReadAddr, size, flags, masterId);
+    Addr add = readReq->currentReadAddr;
+    unsigned size = chunkSize(add, readReq->readLeft);
+    RequestPtr req = make_shared<Request>(add, size, flags, masterId);
     if (debug()) DPRINTF(CommInterface, "Trying to read addr: 0x%016x, %d bytes through port: %s\n",
         req->getPaddr(), size, port->name());
 
     PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
-    pkt->allocate();
-    readReq->pkt = pkt;
-    port->sendPacket(pkt);
+    pkt->dataStatic(readReq->buffer + (add - readReq->beginAddr));
+    mshrs[pkt] = {port, spm, add, size, {{readReq, add, size}}, nullptr};
+    lines.readIssued(lineOf(add), pkt);
 
     readReq->currentReadAddr += size;
-
     readReq->readLeft -= size;
+    if (!(readReq->readLeft > 0)) readReq->needToRead = false;
 
-    if (!(readReq->readLeft > 0)) {
-        readReq->needToRead = false;
-        if (!tickEvent.scheduled()) {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
-        }
-    } else {
-        if (!port->isStalled() && !tickEvent.scheduled())
-        {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
-        }
-    }
+    commStats.readPackets++;
+    commStats.occupancyAtIssue.sample(mshrs.size());
+    commStats.occupancy = mshrs.size();
+    return pkt;
 }
 
-void
-CommInterface::tryWrite(MemSidePort * port) {
-    MemoryRequest * writeReq = port->writeReq;
-    if (writeReq->writeLeft <= 0) {
-        if (debug()) DPRINTF(CommInterface, "Something went wrong. Shouldn't try to write if there aren't writes left\n");
-        return;
-    }
-
-    int size;
-    if (writeReq->currentWriteAddr % cacheLineSize) {
-        size = cacheLineSize - (writeReq->currentWriteAddr % cacheLineSize);
-        if (debug()) DPRINTF(CommInterface, "Aligning\n");
-    } else {
-        size = cacheLineSize;
-    }
-    size = writeReq->writeLeft > size - 1 ? size : writeReq->writeLeft;
+PacketPtr
+CommInterface::createWritePacket(const std::vector<MSHR::Target> &targets, RequestPort * port,
+                                 bool spm) {
+    Addr add = targets.front().addr;
+    unsigned size = 0;
+    for (auto &target : targets) size += target.size;
 
     Request::Flags flags;
-    uint8_t *data = new uint8_t[size];
-    std::memcpy(data, &(writeReq->buffer[writeReq->totalLength-writeReq->writeLeft]), size);
-    RequestPtr req = make_shared<Request>(writeReq->currentWriteAddr, size, flags, masterId);
-    req->setExtraData((uint64_t)data);
-
+    uint8_t *data = nullptr;
+    uint8_t *pkt_data = targets.front().req->buffer + (add - targets.front().req->address);
+    if (targets.size() > 1) {
+        data = allocLineBuffer();
+        for (auto &target : targets) {
+            std::memcpy(data + (target.addr - add),
+                        target.req->buffer + (target.addr - target.req->address), target.size);
+        }
+        pkt_data = data;
+    }
+    RequestPtr req = make_shared<Request>(add, size, flags, masterId);
 
-    if (debug()) DPRINTF(CommInterface, "totalLength: %d, writeLeft: %d\n", writeReq->totalLength, writeReq->writeLeft);
     if (debug()) DPRINTF(CommInterface, "Trying to write to addr: 0x%016x, %d bytes, data 0x%08x through port: %s\n",
-        writeReq->currentWriteAddr, size,
-        *((uint64_t*)(&(writeReq->buffer[writeReq->totalLength-writeReq->writeLeft]))),
-        port->name());
+        add, size, *((uint32_t*)pkt_data), port->name());
 
     PacketPtr pkt = new Packet(req, MemCmd::WriteReq);
-    uint8_t *pkt_data = (uint8_t *)req->getExtraData();
-    pkt->dataDynamic(pkt_data);
-    writeReq->pkt = pkt;
-    port->sendPacket(pkt);
+    pkt->dataStatic(pkt_data);
+    mshrs[pkt] = {port, spm, add, size, targets, data};
+    lines.writeIssued(lineOf(add));
 
-    writeReq->currentWriteAddr += size;
-    writeReq->writeLeft -= size;
+    commStats.writePackets++;
+    commStats.occupancyAtIssue.sample(mshrs.size());
+    commStats.occupancy = mshrs.size();
+    return pkt;
+}
 
-    if (!(writeReq->writeLeft > 0)) {
-        writeReq->needToWrite = false;
-        if (!tickEvent.scheduled()) {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
+void
+CommInterface::retireMSHR(PacketPtr pkt) {
+    auto mit = mshrs.find(pkt);
+    MSHR mshr = std::move(mit->second);
+    mshrs.erase(mit);
+    commStats.occupancy = mshrs.size();
+    if (mshr.spm) static_cast<SPMPort *>(mshr.port)->retire(pkt->isRead());
+    else static_cast<MemSidePort *>(mshr.port)->retire(pkt->isRead());
+
+    if (pkt->isRead()) {
+        lines.readRetired(lineOf(mshr.addr), pkt);
+        if (debug()) DPRINTF(CommInterface, "Done with a read. addr: 0x%x, size: %d, targets: %d\n",
+            mshr.addr, mshr.size, mshr.targets.size());
+        // The packet data lives in the first target's buffer, so every
+        // target is filled before any request is committed and freed
+        for (auto &target : mshr.targets) {
+            MemoryRequest * readReq = target.req;
+            Addr offset = target.addr - readReq->beginAddr;
+            const uint8_t *src = pkt->getConstPtr<uint8_t>() + (target.addr - mshr.addr);
+            if (src != readReq->buffer + offset)
+                std::memcpy(readReq->buffer + offset, src, target.size);
+            for (Addr i = offset; i < offset + target.size; i++) readReq->readsDone[i] = true;
+        }
+        for (auto &target : mshr.targets) {
+            MemoryRequest * readReq = target.req;
+
+            // mark readDone as only the contiguous region
+            while (readReq->readDone < readReq->totalLength && readReq->readsDone[readReq->readDone])
+            {
+                readReq->readDone++;
+            }
+
+            if (!readReq->needToRead) {
+                if (debug()) DPRINTF(CommInterface, "Done reading \n");
+                cu->readCommit(readReq);
+                delete readReq;
+            } else {
+                readQueue.push_front(readReq);
+            }
         }
-    } else if (!port->isStalled() && !tickEvent.scheduled()) {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
+    } else if (pkt->isWrite()) {
+        lines.writeRetired(lineOf(mshr.addr));
+        if (mshr.data) freeLineBuffers.push_back(mshr.data);
+        if (debug()) DPRINTF(CommInterface, "Done with a write. addr: 0x%x, size: %d, targets: %d\n",
+            mshr.addr, mshr.size, mshr.targets.size());
+        for (auto &target : mshr.targets) {
+            MemoryRequest * writeReq = target.req;
+            writeReq->writeDone += target.size;
+            if (!(writeReq->needToWrite)) {
+                if (debug()) DPRINTF(CommInterface, "Done writing\n");
+                cu->writeCommit(writeReq);
+                delete writeReq;
+            } else {
+                writeQueue.push_front(writeReq);
+            }
+        }
+    } else {
+        panic("Something went very wrong!");
     }
 }
 
 void
-CommInterface::tryRead(SPMPort * port) {
-    MemoryRequest * readReq = port->readReq;
-    Request::Flags flags;
+CommInterface::tryRead(MemSidePort * port, MemoryRequest * readReq) {
     if (readReq->readLeft <= 0) {
         if (debug()) DPRINTF(CommInterface, "Something went wrong. Shouldn't try to read if there aren't reads left\n");
         return;
     }
-    int size;
-    if (readReq->currentReadAddr % cacheLineSize) {
-        size = cacheLineSize - (readReq->currentReadAddr % cacheLineSize);
-        if (debug()) DPRINTF(CommInterface, "Aligning\n");
-    } else {
-        size = cacheLineSize;
-    }
-    size = readReq->readLeft > (size - 1) ? size : readReq->readLeft;
-    RequestPtr req = make_shared<Request>(readReq->currentReadAddr, size, flags, masterId);
-    if (debug()) DPRINTF(CommInterface, "Trying to read addr: 0x%016x, %d bytes through port: %s\n",
-        req->getPaddr(), size, port->name());
-
-    PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
-    pkt->allocate();
-    readReq->pkt = pkt;
+    PacketPtr pkt = createReadPacket(readReq, port, false);
+    port->readsInFlight++;
     port->sendPacket(pkt);
 
-    readReq->currentReadAddr += size;
+    if (!tickEvent.scheduled() && (!readReq->needToRead || !port->isStalled())) {
+        schedule(tickEvent, curTick() + processDelay);
+        //schedule(tickEvent, nextCycle());
+    }
+}
 
-    readReq->readLeft -= size;
+void
+CommInterface::tryWrite(MemSidePort * port, const std::vector<MSHR::Target> &targets) {
+    PacketPtr pkt = createWritePacket(targets, port, false);
+    port->writesInFlight++;
+    port->sendPacket(pkt);
 
-    if (!(readReq->readLeft > 0)) {
-        readReq->needToRead = false;
-        if (!tickEvent.scheduled()) {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
-        }
-    } else {
-        if (!port->isStalled() && !tickEvent.scheduled())
-        {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
-        }
+    if (!tickEvent.scheduled() && (!targets.back().req->needToWrite || !port->isStalled())) {
+        schedule(tickEvent, curTick() + processDelay);
+        //schedule(tickEvent, nextCycle());
     }
 }
 
 void
-CommInterface::tryWrite(SPMPort * port) {
-    MemoryRequest * writeReq = port->writeReq;
-    if (writeReq->writeLeft <= 0) {
-        if (debug()) DPRINTF(CommInterface, "Something went wrong. Shouldn't try to write if there aren't writes left\n");
+CommInterface::tryRead(SPMPort * port, MemoryRequest * readReq) {
+    if (readReq->readLeft <= 0) {
+        if (debug()) DPRINTF(CommInterface, "Something went wrong. Shouldn't try to read if there aren't reads left\n");
         return;
     }
+    PacketPtr pkt = createReadPacket(readReq, port, true);
+    port->readsInFlight++;
+    port->sendPacket(pkt);
 
-    int size;
-    if (writeReq->currentWriteAddr % cacheLineSize) {
-        size = cacheLineSize - (writeReq->currentWriteAddr % cacheLineSize);
-        if (debug()) DPRINTF(CommInterface, "Aligning\n");
-    } else {
-        size = cacheLineSize;
+    if (!tickEvent.scheduled() && (!readReq->needToRead || !port->isStalled())) {
+        schedule(tickEvent, curTick() + processDelay);
+        //schedule(tickEvent, nextCycle());
     }
-    size = writeReq->writeLeft > size - 1 ? size : writeReq->writeLeft;
-
-    Request::Flags flags;
-    uint8_t *data = new uint8_t[size];
-    std::memcpy(data, &(writeReq->buffer[writeReq->totalLength-writeReq->writeLeft]), size);
-    RequestPtr req = make_shared<Request>(writeReq->currentWriteAddr, size, flags, masterId);
-    req->setExtraData((uint64_t)data);
-
-
-    if (debug()) DPRINTF(CommInterface, "totalLength: %d, writeLeft: %d\n", writeReq->totalLength, writeReq->writeLeft);
-    if (debug()) DPRINTF(CommInterface, "Trying to write to addr: 0x%016x, %d bytes, data 0x%08x through port: %s\n",
-        writeReq->currentWriteAddr, size,
-        *((uint64_t*)(&(writeReq->buffer[writeReq->totalLength-writeReq->writeLeft]))),
-        port->name());
+}
 
-    PacketPtr pkt = new Packet(req, MemCmd::WriteReq);
-    uint8_t *pkt_data = (uint8_t *)req->getExtraData();
-    pkt->dataDynamic(pkt_data);
-    writeReq->pkt = pkt;
+void
+CommInterface::tryWrite(SPMPort * port, const std::vector<MSHR::Target> &targets) {
+    PacketPtr pkt = createWritePacket(targets, port, true);
+    port->writesInFlight++;
     port->sendPacket(pkt);
 
-    writeReq->currentWriteAddr += size;
-    writeReq->writeLeft -= size;
-
-    if (!(writeReq->writeLeft > 0)) {
-        writeReq->needToWrite = false;
-        if (!tickEvent.scheduled()) {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
-        }
-    } else if (!port->isStalled() && !tickEvent.scheduled()) {
-            schedule(tickEvent, curTick() + processDelay);
-            //schedule(tickEvent, nextCycle());
+    if (!tickEvent.scheduled() && (!targets.back().req->needToWrite || !port->isStalled())) {
+        schedule(tickEvent, curTick() + processDelay);
+        //schedule(tickEvent, nextCycle());
     }
 }
 
@@ -668,7 +610,7 @@ CommInterface::tryRead(RegPort * port) {
         req->getPaddr(), size, port->name());
 
     PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
-    pkt->allocate();
+    pkt->dataStatic(readReq->buffer + (readReq->currentReadAddr - readReq->beginAddr));
     readReq->pkt = pkt;
     readReq->currentReadAddr += size;
     readReq->readLeft -= size;
@@ -693,10 +635,7 @@ CommInterface::tryWrite(RegPort * port) {
     int size = writeReq->writeLeft;
 
     Request::Flags flags;
-    uint8_t *data = new uint8_t[size];
-    std::memcpy(data, &(writeReq->buffer[writeReq->totalLength-writeReq->writeLeft]), size);
     RequestPtr req = make_shared<Request>(writeReq->currentWriteAddr, size, flags, masterId);
-    req->setExtraData((uint64_t)data);
 
 
     if (debug()) DPRINTF(CommInterface, "totalLength: %d, writeLeft: %d\n", writeReq->totalLength, writeReq->writeLeft);
@@ -706,8 +645,7 @@ CommInterface::tryWrite(RegPort * port) {
         port->name());
 
     PacketPtr pkt = new Packet(req, MemCmd::WriteReq);
-    uint8_t *pkt_data = (uint8_t *)req->getExtraData();
-    pkt->dataDynamic(pkt_data);
+    pkt->dataStatic(&(writeReq->buffer[writeReq->totalLength-writeReq->writeLeft]));
     writeReq->pkt = pkt;
     writeReq->currentWriteAddr += size;
     writeReq->writeLeft -= size;
@@ -723,10 +661,11 @@ CommInterface::tryWrite(RegPort * port) {
 
 void
 CommInterface::enqueueRead(MemoryRequest * req) {
-    if (inRegRange(req->getAddress())) {
+    const Route *route = findRoute(req->getAddress());
+    if (route && (route->kind == RegRoute)) {
         // We want to immediately handle register requests
         // and bypass memory queues
-        auto regport = getValidRegPort(req->getAddress());
+        auto regport = static_cast<RegPort *>(route->ports.front());
         accRdQ.push_back(req); // Add it to active read queue
         regport->setReadReq(req);
         req->setCarrierPort(regport);
@@ -748,10 +687,11 @@ CommInterface::enqueueRead(MemoryRequest * req) {
 
 void
 CommInterface::enqueueWrite(MemoryRequest * req) {
-    if (inRegRange(req->getAddress())) {
+    const Route *route = findRoute(req->getAddress());
+    if (route && (route->kind == RegRoute)) {
         // We want to immediately handle register requests
         // and bypass memory queues
-        auto regport = getValidRegPort(req->getAddress());
+        auto regport = static_cast<RegPort *>(route->ports.front());
         accWrQ.push_back(req); // Add it to active write queue
         regport->setWriteReq(req);
         req->setCarrierPort(regport);
@@ -978,5 +918,43 @@ CommInterface::clearMemRequest(MemoryRequest * req, bool isRead) {
     }
 }
 
+CommInterface::CommStats::CommStats(CommInterface &_comm)
+    : statistics::Group(&_comm, "mshrs"), comm(_comm),
+    ADD_STAT(readPackets, statistics::units::Count::get(),
+             "Number of read packets issued by memory and SPM ports"),
+    ADD_STAT(writePackets, statistics::units::Count::get(),
+             "Number of write packets issued by memory and SPM ports"),
+    ADD_STAT(coalescedReads, statistics::units::Count::get(),
+             "Number of reads served by a packet already in flight"),
+    ADD_STAT(combinedWrites, statistics::units::Count::get(),
+             "Number of writes merged into the packet of an adjacent write"),
+    ADD_STAT(coalescingRate, statistics::units::Ratio::get(),
+             "Fraction of reads served by a packet already in flight",
+             coalescedReads / (readPackets + coalescedReads)),
+    ADD_STAT(combiningRate, statistics::units::Ratio::get(),
+             "Fraction of writes merged into the packet of an adjacent write",
+             combinedWrites / (writePackets + combinedWrites)),
+    ADD_STAT(occupancy, statistics::units::Count::get(),
+             "Average number of packets in flight"),
+    ADD_STAT(occupancyAtIssue, statistics::units::Count::get(),
+             "Number of packets in flight when a packet is issued")
+{
+}
+
+void
+CommInterface::CommStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    unsigned ports = comm.localPorts.size() + comm.globalPorts.size() +
+                     comm.streamPorts.size() + comm.spmPorts.size();
+    unsigned maxInFlight = std::max(1u, 2 * ports * comm.maxOutstanding);
+    occupancyAtIssue.init(1, maxInFlight, 1).flags(nozero);
+}
+
 void
-CommInterface::startup() {}
\ No newline at end of file
+CommInterface::startup() {
+    buildRoutes();
+}
\ No newline at end of file
@@ -2,16 +2,21 @@
 #define __HWACC_COMM_INTERFACE_HH__
 
 #include "params/CommInterface.hh"
+#include "base/statistics.hh"
 #include "dev/io_device.hh"
 #include "dev/arm/base_gic.hh"
 #include "hwacc/compute_unit.hh"
+#include "hwacc/line_tracker.hh"
+#include "hwacc/port_route_table.hh"
 #include "hwacc/LLVMRead/src/mem_request.hh"
 #include "hwacc/stream_port.hh"
 #include "hwacc/scratchpad_memory.hh"
 #include "hwacc/LLVMRead/src/debug_flags.hh"
 
 #include <list>
+#include <memory>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 
 class CommInterface : public BasicPioDevice
@@ -43,8 +48,9 @@ class CommInterface : public BasicPioDevice
       private:
         CommInterface *owner;
         std::queue<PacketPtr> outstandingPkts;
-        MemoryRequest *readReq;
-        MemoryRequest *writeReq;
+        // Packets in flight, bounded by the owner's MSHRs per port
+        unsigned readsInFlight;
+        unsigned writesInFlight;
         bool readActive;
         bool writeActive;
 
@@ -53,18 +59,21 @@ class CommInterface : public BasicPioDevice
           StreamRequestPort(name, owner, id), owner(owner) {
           readActive = false;
           writeActive = false;
-          readReq = NULL;
-          writeReq = NULL;
+          readsInFlight = 0;
+          writesInFlight = 0;
+        }
+        bool canIssue(bool read) {
+          return (read ? readsInFlight : writesInFlight) < owner->maxOutstanding;
+        }
+        void retire(bool read) {
+          if (read) readsInFlight--;
+          else writesInFlight--;
         }
-        MemoryRequest * getReadReq() { return readReq; }
-        MemoryRequest * getWriteReq() { return writeReq; }
-        void setReadReq(MemoryRequest * req = nullptr) { readReq = req; }
-        void setWriteReq(MemoryRequest * req = nullptr) { writeReq = req; }
 
       protected:
         virtual bool recvTimingResp(PacketPtr pkt);
         virtual void recvReqRetry();
-        virtual void recvRangeChange() { };
+        virtual void recvRangeChange() { owner->routesValid = false; };
         virtual Tick recvAtomic(PacketPtr pkt) {return 0;}
         virtual void recvFunctional(PacketPtr pkt) { };
         void setStalled(PacketPtr pkt)
@@ -86,8 +95,9 @@ class CommInterface : public BasicPioDevice
       private:
         CommInterface *owner;
         std::queue<PacketPtr> outstandingPkts;
-        MemoryRequest *readReq;
-        MemoryRequest *writeReq;
+        // Packets in flight, bounded by the owner's MSHRs per port
+        unsigned readsInFlight;
+        unsigned writesInFlight;
         bool readActive;
         bool writeActive;
 
@@ -96,18 +106,21 @@ class CommInterface : public BasicPioDevice
           ScratchpadRequestPort(name, owner, id), owner(owner) {
           readActive = false;
           writeActive = false;
-          readReq = NULL;
-          writeReq = NULL;
+          readsInFlight = 0;
+          writesInFlight = 0;
+        }
+        bool canIssue(bool read) {
+          return (read ? readsInFlight : writesInFlight) < owner->maxOutstanding;
+        }
+        void retire(bool read) {
+          if (read) readsInFlight--;
+          else writesInFlight--;
         }
-        MemoryRequest * getReadReq() { return readReq; }
-        MemoryRequest * getWriteReq() { return writeReq; }
-        void setReadReq(MemoryRequest * req = nullptr) { readReq = req; }
-        void setWriteReq(MemoryRequest * req = nullptr) { writeReq = req; }
 
       protected:
         virtual bool recvTimingResp(PacketPtr pkt);
         virtual void recvReqRetry();
-        virtual void recvRangeChange() { };
+        virtual void recvRangeChange() { owner->routesValid = false; };
         virtual Tick recvAtomic(PacketPtr pkt) {return 0;}
         virtual void recvFunctional(PacketPtr pkt) { };
         void setStalled(PacketPtr pkt)
@@ -138,7 +151,7 @@ class CommInterface : public BasicPioDevice
       protected:
         virtual bool recvTimingResp(PacketPtr pkt);
         virtual void recvReqRetry();
-        virtual void recvRangeChange() { };
+        virtual void recvRangeChange() { owner->routesValid = false; };
         virtual Tick recvAtomic(PacketPtr pkt) {return 0;}
         virtual void recvFunctional(PacketPtr pkt) { };
         void sendPacket(PacketPtr pkt);
@@ -159,9 +172,84 @@ class CommInterface : public BasicPioDevice
 
     std::list<MemoryRequest*> readQueue;
     std::list<MemoryRequest*> writeQueue;
+    // Requests in flight on register ports
     std::list<MemoryRequest*> accRdQ;
     std::list<MemoryRequest*> accWrQ;
 
+    // Port kinds in routing priority order
+    enum PortKind { RegRoute, StreamRoute, SPMRoute, LocalRoute, GlobalRoute };
+    typedef PortRouteTable<RequestPort>::Route Route;
+    PortRouteTable<RequestPort> routeTable;
+    bool routesValid;
+    void buildRoutes();
+    const Route * findRoute(Addr add);
+    RequestPort * getValidPort(const Route &route, Addr add, size_t len, bool read);
+
+    /**
+     * Miss status holding register of a memory or SPM port. Each in-flight
+     * packet is tracked together with the request segments it serves, so
+     * loads to a line that is already being read can coalesce onto it and
+     * adjacent queued stores can share one packet.
+     */
+    struct MSHR
+    {
+        struct Target
+        {
+            MemoryRequest *req;
+            Addr addr;
+            unsigned size;
+        };
+        RequestPort *port;
+        bool spm;
+        Addr addr;
+        unsigned size;
+        std::vector<Target> targets;
+        // Pooled line buffer of a combined write, nullptr otherwise
+        uint8_t *data;
+    };
+    std::unordered_map<PacketPtr, MSHR> mshrs;
+    // In-flight packets per line, for coalescing loads
+    LineTracker<PacketPtr> lines;
+    unsigned maxOutstanding;
+    bool coalesceRequests;
+
+    // Packets carry data in place in the MemoryRequest buffers. Only combined
+    // writes, which gather several buffers, need a line buffer of their own.
+    std::vector<std::unique_ptr<uint8_t[]>> lineBuffers;
+    std::vector<uint8_t *> freeLineBuffers;
+    uint8_t * allocLineBuffer();
+
+    Addr lineOf(Addr add) { return add - (add % cacheLineSize); }
+    unsigned chunkSize(Addr add, Tick left);
+    bool coalesceRead(MemoryRequest * req);
+    std::vector<MSHR::Target> nextWrite(MemoryRequest * req, bool combine,
+                                        std::list<MemoryRequest*>::iterator &next,
+                                        SPMPort * spm=nullptr);
+    PacketPtr createReadPacket(MemoryRequest * req, RequestPort * port, bool spm);
+    PacketPtr createWritePacket(const std::vector<MSHR::Target> &targets,
+                                RequestPort * port, bool spm);
+    void retireMSHR(PacketPtr pkt);
+
+    struct CommStats : public statistics::Group
+    {
+        CommStats(CommInterface &comm);
+
+        void regStats() override;
+
+        const CommInterface &comm;
+
+        statistics::Scalar readPackets;
+        statistics::Scalar writePackets;
+        statistics::Scalar coalescedReads;
+        statistics::Scalar combinedWrites;
+        statistics::Formula coalescingRate;
+        statistics::Formula combiningRate;
+        /** Time average of the in-flight packets of all ports */
+        statistics::Average occupancy;
+        /** In-flight packets of all ports when a packet is issued */
+        statistics::Distribution occupancyAtIssue;
+    };
+
     int requestsInQueues;
 
     std::vector<MemSidePort*> localPorts;
@@ -197,16 +285,6 @@ class CommInterface : public BasicPioDevice
     bool allPortsStalled() {
         return localPortsStalled() && globalPortsStalled() && streamPortsStalled() && spmPortsStalled();
     }
-    bool inStreamRange(Addr add);
-    bool inSPMRange(Addr add);
-    bool inRegRange(Addr add);
-    bool inLocalRange(Addr add);
-    bool inGlobalRange(Addr add);
-    MemSidePort * getValidLocalPort(Addr add, bool read);
-    MemSidePort * getValidGlobalPort(Addr add, bool read);
-    MemSidePort * getValidStreamPort(Addr add, size_t len, bool read);
-    SPMPort *     getValidSPMPort(Addr add, size_t len, bool read);
-    RegPort *     getValidRegPort(Addr add);
 
     CommInterface *comm;
     RequestorID masterId;
@@ -221,11 +299,11 @@ class CommInterface : public BasicPioDevice
     bool computationNeeded;
     bool int_flag;
 
-    void tryRead(MemSidePort * port);
-    void tryWrite(MemSidePort * port);
+    void tryRead(MemSidePort * port, MemoryRequest * readReq);
+    void tryWrite(MemSidePort * port, const std::vector<MSHR::Target> &targets);
 
-    void tryRead(SPMPort * port);
-    void tryWrite(SPMPort * port);
+    void tryRead(SPMPort * port, MemoryRequest * readReq);
+    void tryWrite(SPMPort * port, const std::vector<MSHR::Target> &targets);
 
     void tryRead(RegPort * port);
     void tryWrite(RegPort * port);
@@ -242,6 +320,8 @@ class CommInterface : public BasicPioDevice
 
     ComputeUnit *cu;
 
+    CommStats commStats;
+
   public:
     PARAMS(CommInterface);
 
@@ -8,8 +8,7 @@ DmaWriteFifo::DmaWriteFifo(DmaPort &_port, size_t size,
                          Request::Flags flags)
     : maxReqSize(max_req_size), fifoSize(size),
       reqFlags(flags), port(_port),
-      buffer(size),
-      nextAddr(0), endAddr(0)
+      buffer(size)
 {
     freeRequests.resize(max_pending);
     for (auto &e : freeRequests)
@@ -39,16 +38,28 @@ DmaWriteFifo::serialize(CheckpointOut &cp) const
     assert(pendingRequests.empty());
 
     SERIALIZE_CONTAINER(buffer);
-    SERIALIZE_SCALAR(endAddr);
-    SERIALIZE_SCALAR(nextAddr);
+    paramOut(cp, "blockStart", block.start);
+    paramOut(cp, "blockRowSize", block.rowSize);
+    paramOut(cp, "blockRows", block.rows);
+    paramOut(cp, "blockRowStride", block.rowStride);
+    paramOut(cp, "blockPlanes", block.planes);
+    paramOut(cp, "blockPlaneStride", block.planeStride);
+    paramOut(cp, "blockRow", block.row);
+    paramOut(cp, "blockOffset", block.offset);
 }
 
 void
 DmaWriteFifo::unserialize(CheckpointIn &cp)
 {
     UNSERIALIZE_CONTAINER(buffer);
-    UNSERIALIZE_SCALAR(endAddr);
-    UNSERIALIZE_SCALAR(nextAddr);
+    paramIn(cp, "blockStart", block.start);
+    paramIn(cp, "blockRowSize", block.rowSize);
+    paramIn(cp, "blockRows", block.rows);
+    paramIn(cp, "blockRowStride", block.rowStride);
+    paramIn(cp, "blockPlanes", block.planes);
+    paramIn(cp, "blockPlaneStride", block.planeStride);
+    paramIn(cp, "blockRow", block.row);
+    paramIn(cp, "blockOffset", block.offset);
 }
 
 bool
@@ -82,20 +93,26 @@ DmaWriteFifo::fill(uint8_t *src, size_t len)
 
 void
 DmaWriteFifo::startEmpty(Addr start, size_t size)
+{
+    startEmpty(StridedBlock(start, size));
+}
+
+void
+DmaWriteFifo::startEmpty(const StridedBlock &blk)
 {
     assert(atEndOfBlock());
 
-    nextAddr = start;
-    endAddr = start + size;
+    block = blk;
     resumeEmpty();
 }
 
 void
 DmaWriteFifo::stopEmpty()
 {
-    // Prevent new DMA requests by setting the next address to the end
-    // address. Pending requests will still complete.
-    nextAddr = endAddr;
+    // Prevent new DMA requests by moving past the last row of the
+    // block. Pending requests will still complete.
+    block.row = block.totalRows();
+    block.offset = 0;
 
     // Flag in-flight accesses as canceled. This prevents their data
     // from being written to the FIFO.
@@ -125,21 +142,22 @@ DmaWriteFifo::resumeEmpty()
 void
 DmaWriteFifo::resumeEmptyFunctional()
 {
-    const size_t fifo_space = buffer.capacity() - buffer.size();
-    const size_t kvm_watermark = port.sys->cacheLineSize();
-    if (fifo_space >= kvm_watermark || buffer.capacity() < kvm_watermark) {
-        const size_t block_remaining = endAddr - nextAddr;
-        const size_t xfer_size = std::min(fifo_space, block_remaining);
-        std::vector<uint8_t> tmp_buffer(xfer_size);
+    assert(pendingRequests.empty());
+    std::vector<uint8_t> tmp_buffer(maxReqSize);
+
+    // Write out whatever the FIFO holds, one row segment at a time
+    while (!atEndOfBlock()) {
+        const size_t xfer_size = block.nextSize(maxReqSize);
+        if (buffer.size() < xfer_size)
+            break;
 
-        assert(pendingRequests.empty());
         DPRINTF(DMA, "KVM Bypassing startAddr=%#x xfer_size=%#x " \
-                "fifo_space=%#x block_remaining=%#x\n",
-                nextAddr, xfer_size, fifo_space, block_remaining);
+                "fifo_size=%#x\n", block.nextAddr(), xfer_size, buffer.size());
 
-        port.sys->physProxy.readBlob(nextAddr, tmp_buffer.data(), xfer_size);
-        buffer.write(tmp_buffer.begin(), xfer_size);
-        nextAddr += xfer_size;
+        buffer.read(tmp_buffer.data(), xfer_size);
+        port.sys->physProxy.writeBlob(block.nextAddr(), tmp_buffer.data(),
+                                      xfer_size);
+        block.advance(xfer_size);
     }
 }
 
@@ -151,7 +169,7 @@ DmaWriteFifo::resumeEmptyTiming()
         size_pending += e->requestSize();
 
     while (!freeRequests.empty() && !atEndOfBlock()) {
-        const size_t req_size(std::min(maxReqSize, endAddr - nextAddr));
+        const size_t req_size(block.nextSize(maxReqSize));
         if ((int64_t)(buffer.size() - size_pending - req_size) < 0)
             break;
 
@@ -161,9 +179,9 @@ DmaWriteFifo::resumeEmptyTiming()
 
         event->reset(req_size);
         buffer.read(event->data(), req_size);
-        port.dmaAction(MemCmd::WriteReq, nextAddr, req_size, event.get(),
-                       event->data(), 0, reqFlags);
-        nextAddr += req_size;
+        port.dmaAction(MemCmd::WriteReq, block.nextAddr(), req_size,
+                       event.get(), event->data(), 0, reqFlags);
+        block.advance(req_size);
         size_pending += req_size;
 
         pendingRequests.emplace_back(std::move(event));
@@ -180,6 +198,9 @@ DmaWriteFifo::dmaDone()
 
     if (old_active && !isActive())
         onIdle();
+
+    if (onResponse)
+        onResponse();
 }
 
 void
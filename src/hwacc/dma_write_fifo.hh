@@ -3,8 +3,11 @@
 //------------------------------------------//
 #include "hwacc/LLVMRead/src/debug_flags.hh"
 #include "dev/dma_device.hh"
+#include "hwacc/strided_block.hh"
 //------------------------------------------//
 
+#include <functional>
+
 using namespace gem5;
 
 class DmaWriteFifo : public Drainable, public Serializable
@@ -85,11 +88,17 @@ class DmaWriteFifo : public Drainable, public Serializable
      * engine unless the last request from the active block has been
      * sent (i.e., atEndOfBlock() is true).
      *
-     * @param start Physical address to copy from.
+     * @param start Physical address to copy to.
      * @param size Size of the block to copy.
      */
     void startEmpty(Addr start, size_t size);
 
+    /**
+     * Start emptying the FIFO into a strided block. Requests never
+     * cross the end of a row or a max_req_size boundary.
+     */
+    void startEmpty(const StridedBlock &blk);
+
     /**
      * Stop the DMA engine.
      *
@@ -105,7 +114,7 @@ class DmaWriteFifo : public Drainable, public Serializable
      * block?
      */
     bool atEndOfBlock() const {
-        return nextAddr == endAddr;
+        return block.done();
     }
 
     /**
@@ -116,6 +125,12 @@ class DmaWriteFifo : public Drainable, public Serializable
         return !(pendingRequests.empty() && atEndOfBlock());
     }
 
+    /**
+     * Run wakeup after each DMA response has been handled, so an
+     * engine can sleep until the FIFO has drained.
+     */
+    void setWakeup(std::function<void()> wakeup) { onResponse = wakeup; }
+
     /** @} */
   protected: // Callbacks
     /**
@@ -203,8 +218,9 @@ class DmaWriteFifo : public Drainable, public Serializable
   private: // Internal state
     Fifo<uint8_t> buffer;
 
-    Addr nextAddr;
-    Addr endAddr;
+    StridedBlock block;
+
+    std::function<void()> onResponse;
 
     std::deque<DmaDoneEventUPtr> pendingRequests;
     std::deque<DmaDoneEventUPtr> freeRequests;
@@ -0,0 +1,64 @@
+#ifndef __HWACC_LINE_TRACKER_HH__
+#define __HWACC_LINE_TRACKER_HH__
+
+#include "base/types.hh"
+
+#include <unordered_map>
+
+/**
+ * Tracks the in-flight packets of each cache line for load coalescing. A
+ * load may only join the latest read packet of its line if no store to the
+ * line was issued after that read. Stores issued after the read remove it,
+ * even once they have completed, since the read may still return the data
+ * from before the store. Loads also never join a read while a store to the
+ * line is in flight.
+ */
+template <class Packet>
+class LineTracker
+{
+  private:
+    // Latest read packet of each line that no store has been issued after
+    std::unordered_map<gem5::Addr, Packet> reads;
+    // In-flight write packets per line
+    std::unordered_map<gem5::Addr, unsigned> writes;
+
+  public:
+    void
+    readIssued(gem5::Addr line, Packet pkt)
+    {
+        reads[line] = pkt;
+    }
+
+    void
+    readRetired(gem5::Addr line, Packet pkt)
+    {
+        auto it = reads.find(line);
+        if ((it != reads.end()) && (it->second == pkt)) reads.erase(it);
+    }
+
+    void
+    writeIssued(gem5::Addr line)
+    {
+        reads.erase(line);
+        writes[line]++;
+    }
+
+    void
+    writeRetired(gem5::Addr line)
+    {
+        auto it = writes.find(line);
+        if (--(it->second) == 0) writes.erase(it);
+    }
+
+    /** The read packet a load of the line may join, if any */
+    bool
+    coalescible(gem5::Addr line, Packet &pkt) const
+    {
+        auto it = reads.find(line);
+        if ((it == reads.end()) || writes.count(line)) return false;
+        pkt = it->second;
+        return true;
+    }
+};
+
+#endif //__HWACC_LINE_TRACKER_HH__
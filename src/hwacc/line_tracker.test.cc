@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "hwacc/line_tracker.hh"
+
+/*
+ * Replays load/store sequences the way CommInterface issues and retires
+ * packets, over a memory whose writes complete before earlier reads.
+ */
+
+namespace
+{
+
+const gem5::Addr line = 0x1000;
+
+struct Packet
+{
+    bool write;
+    gem5::Tick done;
+};
+
+// Memory with separate read and write latencies. Reads return the value of
+// the line when they are issued, as the memory reads it then.
+struct Memory
+{
+    gem5::Tick readLatency;
+    gem5::Tick writeLatency;
+    gem5::Tick now = 0;
+    int value = 0;
+    LineTracker<Packet *> lines;
+    std::map<Packet *, int> readData;
+    std::vector<Packet *> inFlight;
+    std::vector<std::unique_ptr<Packet>> packets;
+
+    Packet *
+    issue(bool write, gem5::Tick latency)
+    {
+        packets.emplace_back(new Packet{write, now + latency});
+        inFlight.push_back(packets.back().get());
+        return inFlight.back();
+    }
+
+    Packet *
+    read()
+    {
+        Packet *pkt = issue(false, readLatency);
+        readData[pkt] = value;
+        lines.readIssued(line, pkt);
+        return pkt;
+    }
+
+    Packet *
+    write(int data)
+    {
+        Packet *pkt = issue(true, writeLatency);
+        value = data;
+        lines.writeIssued(line);
+        return pkt;
+    }
+
+    // Retire every packet done by tick
+    void
+    advance(gem5::Tick tick)
+    {
+        now = tick;
+        for (auto it = inFlight.begin(); it != inFlight.end();) {
+            Packet *pkt = *it;
+            if (pkt->done > now) {
+                ++it;
+                continue;
+            }
+            if (pkt->write) lines.writeRetired(line);
+            else lines.readRetired(line, pkt);
+            it = inFlight.erase(it);
+        }
+    }
+
+    // Value a load issued now returns, joining an in-flight read if allowed
+    int
+    load()
+    {
+        Packet *carrier;
+        if (lines.coalescible(line, carrier)) return readData.at(carrier);
+        return value;
+    }
+};
+
+} // anonymous namespace
+
+TEST(LineTracker, LoadJoinsRead)
+{
+    Memory mem{4, 1};
+    mem.value = 7;
+    Packet *pkt = mem.read();
+    Packet *carrier;
+    ASSERT_TRUE(mem.lines.coalescible(line, carrier));
+    EXPECT_EQ(carrier, pkt);
+    EXPECT_EQ(mem.load(), 7);
+    mem.advance(4);
+    EXPECT_FALSE(mem.lines.coalescible(line, carrier));
+}
+
+TEST(LineTracker, NoJoinWhileStoreInFlight)
+{
+    Memory mem{4, 4};
+    mem.read();
+    mem.write(3);
+    Packet *carrier;
+    EXPECT_FALSE(mem.lines.coalescible(line, carrier));
+}
+
+// The store completes before the read issued ahead of it, and the load that
+// depends on the store must not join that read
+TEST(LineTracker, StoreThenLoadWithFasterWrites)
+{
+    Memory mem{4, 1};
+    mem.value = 1;
+    mem.read();
+    mem.advance(1);
+    mem.write(2);
+    mem.advance(2);
+    EXPECT_EQ(mem.inFlight.size(), 1u);
+    EXPECT_EQ(mem.load(), 2);
+
+    // A read issued after the store may be joined again
+    Packet *pkt = mem.read();
+    Packet *carrier;
+    ASSERT_TRUE(mem.lines.coalescible(line, carrier));
+    EXPECT_EQ(carrier, pkt);
+    EXPECT_EQ(mem.load(), 2);
+}
@@ -5,14 +5,119 @@ LLVMInterface::LLVMInterface(const LLVMInterfaceParams &p):
     ComputeUnit(p),
     filename(p.in_file),
     topName(p.top_name),
+    graphCacheDir(p.graph_cache),
     scheduling_threshold(p.sched_threshold),
     clock_period(p.clock_period),
-    lockstep(p.lockstep_mode) {
+    lockstep(p.lockstep_mode),
+    ready_list_scheduling(p.ready_list_scheduling),
+    quiescence(p.quiescence),
+    compute_kernels(p.compute_kernels),
+    simd_lanes(p.simd_lanes),
+    tickTimer(p.host_profile_period),
+    queueTimer(p.host_profile_period),
+    schedulingTimer(p.host_profile_period),
+    computeTimer(p.host_profile_period),
+    hwTimer(p.host_profile_period),
+    stats(*this) {
     // if (DTRACE(Trace)) DPRINTF(Runtime, "Trace: %s \n", __PRETTY_FUNCTION__);
     clock_period = clock_period * 1000;
     dbg = comm->debug();
 }
 
+LLVMInterface::ComputeStats::ComputeStats(LLVMInterface &_unit)
+    : statistics::Group(&_unit), unit(_unit),
+    ADD_STAT(cycles, statistics::units::Cycle::get(),
+             "Number of cycles the datapath ran"),
+    ADD_STAT(stallCycles, statistics::units::Cycle::get(),
+             "Number of cycles no instruction made progress"),
+    ADD_STAT(quiescedCycles, statistics::units::Cycle::get(),
+             "Number of stall cycles skipped while quiesced"),
+    ADD_STAT(loadStallCycles, statistics::units::Cycle::get(),
+             "Number of stall cycles with only loads in flight"),
+    ADD_STAT(storeStallCycles, statistics::units::Cycle::get(),
+             "Number of stall cycles with only stores in flight"),
+    ADD_STAT(loadStoreStallCycles, statistics::units::Cycle::get(),
+             "Number of stall cycles with loads and stores in flight"),
+    ADD_STAT(computeStallCycles, statistics::units::Cycle::get(),
+             "Number of stall cycles with no memory access in flight"),
+    ADD_STAT(activeCycles, statistics::units::Cycle::get(),
+             "Number of cycles at least one instruction made progress",
+             cycles - stallCycles),
+    ADD_STAT(rawStalls, statistics::units::Count::get(),
+             "Number of load issues held back by an in-flight store to the "
+             "same address"),
+    ADD_STAT(fuStalls, statistics::units::Count::get(),
+             "Number of issues held back by a busy functional unit"),
+    ADD_STAT(issueStalls, statistics::units::Count::get(),
+             "Number of issues held back because every issue port of the "
+             "cycle was used"),
+    ADD_STAT(opcodes, statistics::units::Count::get(),
+             "Number of dynamic instructions of each opcode"),
+    ADD_STAT(dynamicInsts, statistics::units::Count::get(),
+             "Number of dynamic instructions", sum(opcodes)),
+    ADD_STAT(instPoolAllocations, statistics::units::Count::get(),
+             "Number of dynamic instructions allocated by the instruction pools"),
+    ADD_STAT(instPoolReuses, statistics::units::Count::get(),
+             "Number of dynamic instructions recycled by the instruction pools"),
+    ADD_STAT(instPoolDiscards, statistics::units::Count::get(),
+             "Number of dynamic instructions the instruction pools discarded"),
+    ADD_STAT(registerBits, statistics::units::Bit::get(),
+             "Number of register bits"),
+    ADD_STAT(registerReads, statistics::units::Count::get(),
+             "Number of register reads"),
+    ADD_STAT(registerWrites, statistics::units::Count::get(),
+             "Number of register writes"),
+    ADD_STAT(registerBitAccesses, statistics::units::Bit::get(),
+             "Number of register bits read or written"),
+    ADD_STAT(hostSetupSeconds, statistics::units::Second::get(),
+             "Host time spent building the static graph"),
+    ADD_STAT(hostActiveSeconds, statistics::units::Second::get(),
+             "Host time spent in the runtime engine"),
+    ADD_STAT(hostQueueSeconds, statistics::units::Second::get(),
+             "Host time spent processing the runtime queues"),
+    ADD_STAT(hostSchedulingSeconds, statistics::units::Second::get(),
+             "Host time spent scheduling basic blocks"),
+    ADD_STAT(hostComputeSeconds, statistics::units::Second::get(),
+             "Host time spent launching compute instructions"),
+    ADD_STAT(hostStatsSeconds, statistics::units::Second::get(),
+             "Host time spent on cycle tracking"),
+    ADD_STAT(hostMIPS, statistics::units::Unspecified::get(),
+             "Dynamic instructions simulated per host second of the runtime "
+             "engine, in millions", dynamicInsts / hostActiveSeconds / 1e6)
+{
+}
+
+void
+LLVMInterface::ComputeStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    std::vector<FunctionalUnitBase *> units;
+    for (auto fu : unit.hw->functional_units->functional_unit_list) {
+        uint32_t enum_value = fu->get_enum_value();
+        if (enum_value >= fuIndex.size()) fuIndex.resize(enum_value + 1, -1);
+        fuIndex[enum_value] = units.size();
+        units.push_back(fu);
+    }
+    fuStalls.init(std::max<size_t>(1, units.size())).flags(total | nozero);
+    for (size_t i = 0; i < units.size(); i++)
+        fuStalls.subname(i, units[i]->get_alias());
+
+    opcodes.init(llvm::Instruction::OtherOpsEnd).flags(total | nozero);
+    for (unsigned op = 1; op < llvm::Instruction::OtherOpsEnd; op++)
+        opcodes.subname(op, llvm::Instruction::getOpcodeName(op));
+    quiescedCycles.flags(nozero);
+    hostSetupSeconds.flags(nozero);
+    hostActiveSeconds.flags(nozero);
+    hostQueueSeconds.flags(nozero);
+    hostSchedulingSeconds.flags(nozero);
+    hostComputeSeconds.flags(nozero);
+    hostStatsSeconds.flags(nozero);
+    hostMIPS.flags(nozero | nonan);
+}
+
 std::shared_ptr<SALAM::Value> createClone(const std::shared_ptr<SALAM::Value>& b)
 {
     // if (DTRACE(Trace)) DPRINTF(Runtime, "Trace: %s \n", __PRETTY_FUNCTION__);
@@ -23,13 +128,14 @@ std::shared_ptr<SALAM::Value> createClone(const std::shared_ptr<SALAM::Value>& b
 void
 LLVMInterface::ActiveFunction::scheduleBB(std::shared_ptr<SALAM::BasicBlock> bb)
 {
-    auto schedulingStart = std::chrono::high_resolution_clock::now();
+    owner->schedulingTimer.start();
     if (dbg) DPRINTFS(Runtime, owner, "|---[Schedule BB - UID:%i ]\n", bb->getUID());
     bool needToScheduleBranch = false;
     std::shared_ptr<SALAM::BasicBlock> nextBB;
-    auto instruction_list = *(bb->Instructions());
-    for (auto inst : instruction_list) {
-        std::shared_ptr<SALAM::Instruction> clone_inst = inst->clone();
+    auto &instruction_list = *(bb->Instructions());
+    for (auto &inst : instruction_list) {
+        std::shared_ptr<SALAM::Instruction> clone_inst = pool->acquire(inst);
+        owner->stats.opcodes[clone_inst->getOpode()]++;
         if (dbg) DPRINTFS(Runtime, owner,  "\t\t Instruction Cloned [UID: %d] \n", inst->getUID());
         if (clone_inst->isBr()) {
             if (dbg) DPRINTFS(Runtime, owner,  "\t\t Branch Instruction Found\n");
@@ -39,9 +145,13 @@ LLVMInterface::ActiveFunction::scheduleBB(std::shared_ptr<SALAM::BasicBlock> bb)
                 nextBB = branch->getTarget();
                 if (dbg) DPRINTFS(RuntimeCompute, owner, "\t\t Branching to %s from %s\n", nextBB->getIRStub(), bb->getIRStub());
                 needToScheduleBranch = true;
+                branch.reset();
+                pool->release(clone_inst);
             } else {
                 findDynamicDeps(clone_inst);
                 reservation.push_back(clone_inst);
+                inFlight.insert(clone_inst);
+                if (readyListScheduling) trackReady(clone_inst);
             }
         } else {
             if (clone_inst->isPhi()) {
@@ -51,35 +161,31 @@ LLVMInterface::ActiveFunction::scheduleBB(std::shared_ptr<SALAM::BasicBlock> bb)
             }
             findDynamicDeps(clone_inst);
             reservation.push_back(clone_inst);
+            inFlight.insert(clone_inst);
+            if (readyListScheduling) trackReady(clone_inst);
         }
     }
     previousBB = bb;
-    auto schedulingStop = std::chrono::high_resolution_clock::now();
-    owner->addSchedulingTime(schedulingStop - schedulingStart);
+    owner->stats.hostSchedulingSeconds += owner->schedulingTimer.stop();
     if (needToScheduleBranch) scheduleBB(nextBB);
 }
 
 void
 LLVMInterface::ActiveFunction::processQueues()
 {
-    auto queueStart = std::chrono::high_resolution_clock::now();
+    owner->queueTimer.start();
 
     if (owner->hw->hw_statistics->use_cycle_tracking()) {
-        auto hwStart = std::chrono::high_resolution_clock::now();
+        owner->hwTimer.start();
         hw_cycle_stats.reset();
-        owner->hw->hw_statistics->updateHWStatsCycleStart();
-        
+
         // Update Params
         hw_cycle_stats.cycle = owner->cycle;
         hw_cycle_stats.resInFlight = reservation.size();
         hw_cycle_stats.loadInFlight = readQueue.size();
         hw_cycle_stats.storeInFlight = writeQueue.size();
         hw_cycle_stats.compInFlight = computeQueue.size();
-        
-        
-        //
-        auto hwStop = std::chrono::high_resolution_clock::now();
-        owner->addHWTime(hwStop-hwStart);
+        owner->stats.hostStatsSeconds += owner->hwTimer.stop();
     }
 
     if (dbg) {
@@ -88,20 +194,26 @@ LLVMInterface::ActiveFunction::processQueues()
              reservation.size(), computeQueue.size(), readQueue.size(), writeQueue.size());
     }
     // First pass, computeQueue is empty
-    for (auto queue_iter = computeQueue.begin(); queue_iter != computeQueue.end();) {
-        if (dbg) DPRINTFS(Runtime, owner,  "\n\t\t %s \n\t\t %s%s%s%d%s \n",
-        " |-[Compute Queue]--------------",
-        " | Instruction: ", llvm::Instruction::getOpcodeName((queue_iter->second)->getOpode()),
-        " | UID[", (queue_iter->first), "]"
-        );
-
-        if((queue_iter->second)->commit()) {
-            (queue_iter->second)->reset();
-            queue_iter = computeQueue.erase(queue_iter);
-            hw_cycle_stats.compCommited++;
-        } else {
-            ++queue_iter;
-            hw_cycle_stats.compFUStall++;
+    if (readyListScheduling) {
+        commitComputeWheel();
+    } else {
+        for (auto queue_iter = computeQueue.begin(); queue_iter != computeQueue.end();) {
+            if (dbg) DPRINTFS(Runtime, owner,  "\n\t\t %s \n\t\t %s%s%s%d%s \n",
+            " |-[Compute Queue]--------------",
+            " | Instruction: ", llvm::Instruction::getOpcodeName((queue_iter->second)->getOpode()),
+            " | UID[", (queue_iter->first), "]"
+            );
+
+            if((queue_iter->second)->commit()) {
+                // Calls stay owned by their callee until it returns
+                retire(queue_iter->second, !(queue_iter->second)->isCall());
+                queue_iter = computeQueue.erase(queue_iter);
+                hw_cycle_stats.compCommited++;
+                owner->progress = true;
+            } else {
+                ++queue_iter;
+                hw_cycle_stats.compFUStall++;
+            }
         }
     }
     if (canReturn()) {
@@ -118,119 +230,209 @@ LLVMInterface::ActiveFunction::processQueues()
             caller->commit();
         }
         returned = true;
+        owner->progress = true;
+        recordCycleStats();
+        owner->stats.hostQueueSeconds += owner->queueTimer.stop();
         return;
     } else if (lockstepReady()) {
-        // TODO: Look into for_each here
-        for (auto queue_iter = reservation.begin(); queue_iter != reservation.end();) {
-            if (owner->debug())
-                if (dbg) DPRINTFS(Runtime, owner,  "Debug Breakpoint");
-            auto inst = *queue_iter;
-            if (dbg) DPRINTFS(Runtime, owner,  "\n\t\t %s \n\t\t %s%s%s%d%s \n",
-                " |-[Reserve Queue]--------------",
-                " | Instruction: ", llvm::Instruction::getOpcodeName((inst)->getOpode()),
-                " | UID[", (inst)->getUID(), "]"
-                );
-            if ((inst)->isReturn() == false) {
-                if ((inst)->isTerminator() && reservation.size() >= scheduling_threshold) {
-                    ++queue_iter;
-                } else if (((inst)->ready()) && !uidActive((inst)->getUID())) {
-                    if ((inst)->isLoad()) {
-                        // RAW protection to ensure a writeback finishes before reading that location
-                        if (inst->isLoadingInternal()) {
-                            launchRead(inst);
-                            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((*queue_iter)->getOpode()), (*queue_iter)->getUID());
-                            queue_iter = reservation.erase(queue_iter);
-                            hw_cycle_stats.loadInternal++;
-                        } else if (!writeActive(inst->getPtrOperandValue(0))) {
-                            launchRead(inst);
-                            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((*queue_iter)->getOpode()), (*queue_iter)->getUID());
-                            queue_iter = reservation.erase(queue_iter);
-                            hw_cycle_stats.loadAcitve++;
-                        } else {
-                            auto activeWrite = getActiveWrite(inst->getPtrOperandValue(0));
-                            inst->addRuntimeDependency(activeWrite);
-                            activeWrite->addRuntimeUser(inst);
-                            ++queue_iter;
-                            hw_cycle_stats.loadRawStall++;
-                        }
-                    } else if ((inst)->isStore()) {
-                        // WAR Protection to insure reading finishes before a write
-                        // if (!readActive(inst->getPtrOperandValue(1))) {
-                        launchWrite(inst);
-                        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((*queue_iter)->getOpode()), (*queue_iter)->getUID());
-                        queue_iter = reservation.erase(queue_iter);
-                        hw_cycle_stats.storeActive++;
-                        // } else {
-                        //     auto activeRead = getActiveRead(inst->getPtrOperandValue(1));
-                        //     inst->addRuntimeDependency(activeRead);
-                        //     activeRead->addRuntimeUser(inst);
-                        //     ++queue_iter;
-                        // }
-                    } else if ((inst)->isLatchingBrExiting() && ((reservation.size() > 1) || !queuesClear())) {
-                        ++queue_iter;
-                    } else if ((inst)->isTerminator()) {
-                        (inst)->launch();
-                        auto nextBB = inst->getTarget();
-                        if (dbg) DPRINTFS(RuntimeCompute, owner, "\t\t Branching to %s from %s\n",
-                            nextBB->getIRStub(), previousBB->getIRStub());
-                        scheduleBB(nextBB);
-                        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  | Branch Scheduled: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
-                        (inst)->commit();
-                        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((*queue_iter)->getOpode()), (*queue_iter)->getUID());
-                        queue_iter = reservation.erase(queue_iter);
-                    } else if ((*queue_iter)->isCall()) {
-                        auto callInst = std::dynamic_pointer_cast<SALAM::Call>(inst);
-                        assert(callInst);
-                        auto calleeValue = callInst->getCalleeValue();
-                        auto callee = std::dynamic_pointer_cast<SALAM::Function>(calleeValue);
-                        assert(callee);
-                        if (callee->canLaunch()) {
-                            owner->launchFunction(callee, callInst);
-                            computeQueue.insert({(inst)->getUID(), inst});
-                            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((*queue_iter)->getOpode()), (*queue_iter)->getUID());
-                            queue_iter = reservation.erase(queue_iter);
-                        } else {
-                            ++queue_iter;
-                        }
-                    } else {
-                        auto computeStart = std::chrono::high_resolution_clock::now();
-                        if (!(inst)->launch()) {
-                            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  | Added to Compute Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
-                            computeQueue.insert({(inst)->getUID(), inst});
-                            hw_cycle_stats.compLaunched++;
-                        }
-                        auto computeStop = std::chrono::high_resolution_clock::now();
-                        owner->addComputeTime(computeStop-computeStart);
-                        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((*queue_iter)->getOpode()), (*queue_iter)->getUID());
-                        queue_iter = reservation.erase(queue_iter);
-                        hw_cycle_stats.compActive++;
-                    }
+        if (readyListScheduling) {
+            // Only instructions without outstanding dependencies are visited,
+            // in the order they were scheduled. Instructions woken up during
+            // this pass are visited in the same pass if they were scheduled
+            // after the current one, exactly as the full scan would
+            for (auto ready_iter = readyList.begin(); ready_iter != readyList.end();) {
+                auto queue_iter = ready_iter->second;
+                auto inst = *queue_iter;
+                if (!(inst)->ready()) {
+                    // Stalled on a new dependency, the wakeup will re-insert it
+                    ready_iter = readyList.erase(ready_iter);
+                } else if (issue(inst)) {
+                    inst->setWakeup(nullptr);
+                    reservation.erase(queue_iter);
+                    ready_iter = readyList.erase(ready_iter);
+                    owner->progress = true;
+                } else {
+                    ++ready_iter;
+                }
+            }
+        } else {
+            // TODO: Look into for_each here
+            for (auto queue_iter = reservation.begin(); queue_iter != reservation.end();) {
+                if (owner->debug())
+                    if (dbg) DPRINTFS(Runtime, owner,  "Debug Breakpoint");
+                if (issue(*queue_iter)) {
+                    queue_iter = reservation.erase(queue_iter);
+                    owner->progress = true;
                 } else {
                     ++queue_iter;
                 }
-            } else {
-                ++queue_iter;
             }
         }
     }
 
-    if (owner->hw->hw_statistics->use_cycle_tracking()) {
-        auto hwStart = std::chrono::high_resolution_clock::now();
-        for (auto fu : hw->functional_units->functional_unit_list) {
-            std::cout << fu->get_alias() << " - " << fu->get_in_use() << "\n";
-        }
+    recordCycleStats();
+    owner->stats.hostQueueSeconds += owner->queueTimer.stop();
+}
+
+
 
+void
+LLVMInterface::ActiveFunction::recordCycleStats()
+{
+    if (owner->hw->hw_statistics->use_cycle_tracking()) {
+        owner->hwTimer.start();
+        owner->hw->hw_statistics->updateHWStatsCycleEnd(hw_cycle_stats);
+        owner->stats.hostStatsSeconds += owner->hwTimer.stop();
+    }
+}
 
+bool
+LLVMInterface::ActiveFunction::issue(std::shared_ptr<SALAM::Instruction> inst)
+{
+    // Returns true once the instruction has left the reservation queue
+    if (dbg) DPRINTFS(Runtime, owner,  "\n\t\t %s \n\t\t %s%s%s%d%s \n",
+        " |-[Reserve Queue]--------------",
+        " | Instruction: ", llvm::Instruction::getOpcodeName((inst)->getOpode()),
+        " | UID[", (inst)->getUID(), "]"
+        );
+    if ((inst)->isReturn()) return false;
+    if ((inst)->isTerminator() && reservation.size() >= scheduling_threshold) return false;
+    if (!(inst)->ready() || uidActive((inst)->getUID())) return false;
+
+    if ((inst)->isLoad()) {
+        // RAW protection to ensure a writeback finishes before reading that location
+        if (inst->isLoadingInternal()) {
+            launchRead(inst);
+            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+            retire(inst);
+            hw_cycle_stats.loadInternal++;
+            return true;
+        } else if (!writeActive(inst->getPtrOperandValue(0))) {
+            launchRead(inst);
+            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+            hw_cycle_stats.loadAcitve++;
+            return true;
+        } else {
+            auto activeWrite = getActiveWrite(inst->getPtrOperandValue(0));
+            inst->addRuntimeDependency(activeWrite);
+            activeWrite->addRuntimeUser(inst);
+            hw_cycle_stats.loadRawStall++;
+            owner->stats.rawStalls++;
+            return false;
+        }
+    } else if ((inst)->isStore()) {
+        // WAR Protection to insure reading finishes before a write
+        // if (!readActive(inst->getPtrOperandValue(1))) {
+        launchWrite(inst);
+        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+        hw_cycle_stats.storeActive++;
+        return true;
+        // } else {
+        //     auto activeRead = getActiveRead(inst->getPtrOperandValue(1));
+        //     inst->addRuntimeDependency(activeRead);
+        //     activeRead->addRuntimeUser(inst);
+        //     return false;
+        // }
+    } else if ((inst)->isLatchingBrExiting() && ((reservation.size() > 1) || !queuesClear())) {
+        return false;
+    } else if ((inst)->isTerminator()) {
+        if (!functionalUnitAvailable(inst)) return false;
+        (inst)->launch();
+        auto nextBB = inst->getTarget();
+        if (dbg) DPRINTFS(RuntimeCompute, owner, "\t\t Branching to %s from %s\n",
+            nextBB->getIRStub(), previousBB->getIRStub());
+        scheduleBB(nextBB);
+        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  | Branch Scheduled: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+        (inst)->commit();
+        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+        retire(inst);
+        return true;
+    } else if ((inst)->isCall()) {
+        auto callInst = std::dynamic_pointer_cast<SALAM::Call>(inst);
+        assert(callInst);
+        auto calleeValue = callInst->getCalleeValue();
+        auto callee = std::dynamic_pointer_cast<SALAM::Function>(calleeValue);
+        assert(callee);
+        if (callee->canLaunch()) {
+            owner->launchFunction(callee, callInst);
+            trackCompute(inst);
+            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+            return true;
+        }
+        return false;
+    } else {
+        if (!functionalUnitAvailable(inst)) return false;
+        owner->computeTimer.start();
+        bool committed = (inst)->launch();
+        if (!committed) {
+            if (dbg) DPRINTFS(Runtime, owner,  "\t\t  | Added to Compute Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+            trackCompute(inst);
+            hw_cycle_stats.compLaunched++;
+        }
+        owner->stats.hostComputeSeconds += owner->computeTimer.stop();
+        if (dbg) DPRINTFS(Runtime, owner,  "\t\t  |-Erase From Queue: %s - UID[%i]\n", llvm::Instruction::getOpcodeName((inst)->getOpode()), (inst)->getUID());
+        if (committed) retire(inst);
+        hw_cycle_stats.compActive++;
+        return true;
+    }
+}
 
-        owner->hw->hw_statistics->updateHWStatsCycleEnd(owner->cycle);
-        auto hwStop = std::chrono::high_resolution_clock::now();
-        owner->addHWTime(hwStop-hwStart);
+void
+LLVMInterface::ActiveFunction::trackCompute(std::shared_ptr<SALAM::Instruction> inst)
+{
+    computeQueue.insert({(inst)->getUID(), inst});
+    if (readyListScheduling) {
+        // The polled compute queue advances an instruction by one cycle per
+        // pass and commits it once its current cycle reaches its cycle count
+        uint64_t remaining = inst->getCycleCount() - inst->getCurrentCycle() + 1;
+        computeWheel[owner->cycle + remaining].push_back(inst);
     }
-    auto queueStop = std::chrono::high_resolution_clock::now();
-    owner->addQueueTime(queueStop-queueStart);
 }
 
+void
+LLVMInterface::ActiveFunction::commitComputeWheel()
+{
+    std::vector<std::shared_ptr<SALAM::Instruction>> due;
+    for (auto wheel_iter = computeWheel.begin();
+         (wheel_iter != computeWheel.end()) && (wheel_iter->first <= (uint64_t)(owner->cycle));) {
+        due.insert(due.end(), wheel_iter->second.begin(), wheel_iter->second.end());
+        wheel_iter = computeWheel.erase(wheel_iter);
+    }
+    // Commit in UID order, as the compute queue is iterated
+    std::sort(due.begin(), due.end(),
+        [](const std::shared_ptr<SALAM::Instruction> &a,
+           const std::shared_ptr<SALAM::Instruction> &b) {
+            return a->getUID() < b->getUID();
+        });
+    for (auto inst : due) {
+        if (dbg) DPRINTFS(Runtime, owner,  "\n\t\t %s \n\t\t %s%s%s%d%s \n",
+        " |-[Compute Wheel]--------------",
+        " | Instruction: ", llvm::Instruction::getOpcodeName((inst)->getOpode()),
+        " | UID[", (inst)->getUID(), "]"
+        );
+        inst->fastForward();
+        inst->commit();
+        // Calls stay owned by their callee until it returns
+        retire(inst, !(inst)->isCall());
+        computeQueue.erase((inst)->getUID());
+        hw_cycle_stats.compCommited++;
+        owner->progress = true;
+    }
+    hw_cycle_stats.compFUStall += computeQueue.size();
+}
 
+void
+LLVMInterface::ActiveFunction::trackReady(std::shared_ptr<SALAM::Instruction> inst)
+{
+    // Returns are never issued, canReturn() handles them
+    if ((inst)->isReturn()) return;
+    uint64_t sequence = nextSequence++;
+    auto queue_iter = std::prev(reservation.end());
+    inst->setWakeup([this, sequence, queue_iter]() {
+        readyList.insert({sequence, queue_iter});
+    });
+    if ((inst)->getDependencyCount() == 0) readyList.insert({sequence, queue_iter});
+}
 
 /*********************************************************************************************
  CN Scheduling
@@ -250,13 +452,27 @@ LLVMInterface::ActiveFunction::processQueues()
 void
 LLVMInterface::tick()
 {
-    auto tickStart = std::chrono::high_resolution_clock::now();
+    tickTimer.start();
 
     if (dbg) DPRINTF(LLVMInterface, "\n%s\n%s %d\n%s\n",
         "********************************************************************************",
         "   Cycle", cycle,
         "********************************************************************************");
+    if (quiesced) {
+        // Account for the cycles skipped while every function waited
+        int skipped = (curTick() - lastTick) / clock_period - 1;
+        if (dbg) DPRINTF(LLVMInterface, "Woke up after skipping %d idle cycles\n", skipped);
+        cycle += skipped;
+        stats.cycles += skipped;
+        stats.quiescedCycles += skipped;
+        recordStall(quiescedCause, skipped);
+        quiesced = false;
+    }
+    lastTick = curTick();
+    progress = false;
     cycle++;
+    stats.cycles++;
+    hw->advanceFunctionalUnits(cycle);
 
     // Process Queues in Active Functions
     for (auto func_iter = activeFunctions.begin(); func_iter != activeFunctions.end();) {
@@ -267,21 +483,105 @@ LLVMInterface::tick()
             func_iter = activeFunctions.erase(func_iter);
         }
     }
+    if (hw->hw_statistics->use_cycle_tracking()) {
+        // One trace record per cycle, summed over the active functions
+        hwTimer.start();
+        hw->hw_statistics->traceCycle(cycle, hw->functional_units->functional_unit_list);
+        stats.hostStatsSeconds += hwTimer.stop();
+    }
     if (activeFunctions.empty()) {
         // We are finished executing all functions. Signal completion to the CommInterface
         running = false;
+        stats.hostActiveSeconds += tickTimer.stop();
         finalize();
         return;
     }
+    if (!progress) recordStall(stallCause(), 1);
     //////////////// Schedule Next Cycle ////////////////////////
     if (running && !tickEvent.scheduled()) {
-        schedule(tickEvent, curTick() + clock_period);// * process_delay);
+        if (!(quiescence && !progress && quiesce()))
+            schedule(tickEvent, curTick() + clock_period);// * process_delay);
+    }
+    stats.hostActiveSeconds += tickTimer.stop();
+}
+
+LLVMInterface::StallCause
+LLVMInterface::stallCause()
+{
+    bool loads = false;
+    bool stores = false;
+    for (auto &func : activeFunctions) {
+        loads |= func.loadsInFlight();
+        stores |= func.storesInFlight();
+    }
+    if (loads && stores) return LoadStoreStall;
+    if (loads) return LoadStall;
+    if (stores) return StoreStall;
+    return ComputeStall;
+}
+
+void
+LLVMInterface::recordStall(StallCause cause, uint64_t cycles)
+{
+    stats.stallCycles += cycles;
+    switch (cause) {
+      case LoadStall: stats.loadStallCycles += cycles; break;
+      case StoreStall: stats.storeStallCycles += cycles; break;
+      case LoadStoreStall: stats.loadStoreStallCycles += cycles; break;
+      case ComputeStall: stats.computeStallCycles += cycles; break;
     }
-    auto tickStop = std::chrono::high_resolution_clock::now();
-    simTime = simTime + (tickStop - tickStart);
 }
 
 
+bool
+LLVMInterface::quiesce()
+{
+/*********************************************************************************************
+ Stop ticking while every active function waits on memory
+
+ Called after a cycle in which no function made progress. Until a memory request commits or
+ an in-flight compute instruction completes, every following cycle would be identical, so the
+ tick event is only rescheduled for the earliest compute completion. readCommit and writeCommit
+ wake the compute unit up on the next clock edge.
+*********************************************************************************************/
+    // Cycle tracking records every cycle
+    if (hw->hw_statistics->use_cycle_tracking()) return false;
+    bool waiting = false;
+    uint64_t wakeCycle = 0;
+    for (auto &func : activeFunctions) {
+        if (!func.canQuiesce()) return false;
+        waiting |= func.memoryInFlight();
+        uint64_t due = func.nextComputeCycle();
+        if (due && (!wakeCycle || (due < wakeCycle))) wakeCycle = due;
+    }
+    // Instructions stalled on a functional unit retry once it is released
+    uint64_t release = hw->nextFunctionalUnitRelease();
+    if (release && (!wakeCycle || (release < wakeCycle))) wakeCycle = release;
+    // Nothing would ever wake us up again
+    if (!waiting && !wakeCycle) return false;
+
+    if (dbg) DPRINTF(LLVMInterface, "Quiescing at cycle %d\n", cycle);
+    quiesced = true;
+    // Nothing issues until a wakeup, so the skipped cycles stall on the same
+    quiescedCause = stallCause();
+    if (wakeCycle) schedule(tickEvent, curTick() + (wakeCycle - cycle) * clock_period);
+    return true;
+}
+
+void
+LLVMInterface::wakeup()
+{
+    if (!quiesced) return;
+    // Resume on the next clock edge
+    Tick edges = std::max<Tick>(1, divCeil(curTick() - lastTick, clock_period));
+    Tick next = lastTick + edges * clock_period;
+    if (!tickEvent.scheduled()) {
+        schedule(tickEvent, next);
+    } else if (tickEvent.when() > next) {
+        reschedule(tickEvent, next);
+    }
+}
+
 /*********************************************************************************************
 - findDynamicDeps(std::list<std::shared_ptr<SALAM::Instructions>, std::shared_ptr<SALAM::Instruction>)
 - only parse queue once for each instruction until all dependencies are found
@@ -303,108 +603,21 @@ LLVMInterface::ActiveFunction::findDynamicDeps(std::shared_ptr<SALAM::Instructio
     // // instances of the same instruction shouldn't execute simultaneously
     // // dep_uids.push_back(inst->getUID());
 
-    // Find dependencies currently in queues
-
-    // Reverse search the reservation queue because we want to link only the last instance of each dep
-    auto queue_iter = reservation.rbegin();
-    while ((queue_iter != reservation.rend()) && !dep_uids.empty()) {
-        auto queued_inst = *queue_iter;
-        // Look at each instruction in runtime queue once
-        for (auto dep_it = dep_uids.begin(); dep_it != dep_uids.end();) {
-            // Check if any of the instruction to be scheduled dependencies match the current instruction from queue
-            if (queued_inst->getUID() == *dep_it) {
-                // If dependency found, create two way link
-                inst->addRuntimeDependency(queued_inst);
-                queued_inst->addRuntimeUser(inst);
-                dep_it = dep_uids.erase(dep_it);
-            } else {
-                dep_it++;
-            }
-        }
-        queue_iter++;
-    }
-
-    // The other queues do not need to be reverse-searched since only 1 instance of any instruction can exist in them
-    // Check the compute queue
-    for (auto dep_it = dep_uids.begin(); dep_it != dep_uids.end();) {
-        auto queue_iter = computeQueue.find(*dep_it);
-        if (queue_iter != computeQueue.end()) {
-            auto queued_inst = queue_iter->second;
-            inst->addRuntimeDependency(queued_inst);
-            queued_inst->addRuntimeUser(inst);
-            dep_it = dep_uids.erase(dep_it);
-        } else {
-            dep_it++;
-        }
-    }
-    // Check the memory read queue
-    for (auto dep_it = dep_uids.begin(); dep_it != dep_uids.end();) {
-        auto queue_iter = readQueue.find(*dep_it);
-        if (queue_iter != readQueue.end()) {
-            auto queued_inst = queue_iter->second;
+    // Link each dependency to the latest in-flight instance of its static
+    // instruction. Instances in the reservation queue are always newer than
+    // the single instance a UID may have in the compute, read or write queues
+    size_t unresolved = 0;
+    for (size_t i = 0; i < dep_uids.size(); i++) {
+        auto queued_inst = inFlight.latest(dep_uids[i]);
+        if (queued_inst) {
+            // If dependency found, create two way link
             inst->addRuntimeDependency(queued_inst);
             queued_inst->addRuntimeUser(inst);
-            dep_it = dep_uids.erase(dep_it);
         } else {
-            dep_it++;
+            dep_uids[unresolved++] = dep_uids[i];
         }
     }
-
-    // if (!dep_uids.empty()) {
-    //     // Check the memory read queue
-    //     // for (auto queued_read : readQueue) {
-    //     for (auto rq_it = readQueue.begin(); rq_it != readQueue.end(); rq_it++) {
-    //         auto queued_read = *rq_it;
-    //         auto queued_inst = queued_read.second;
-    //         // Look at each instruction in runtime queue once
-    //         for (auto dep_it = dep_uids.begin(); dep_it != dep_uids.end();) {
-    //             // Check if any of the instruction to be scheduled dependencies match the current instruction from queue
-    //             if (queued_inst->getUID() == *dep_it) {
-    //                 // If dependency found, create two way link
-    //                 inst->addRuntimeDependency(queued_inst);
-    //                 queued_inst->addRuntimeUser(inst);
-    //                 dep_it = dep_uids.erase(dep_it);
-    //             } else {
-    //                 dep_it++;
-    //             }
-    //         }
-    //         if (dep_uids.empty()) break;
-    //     }
-    // }
-    // Check the memory write queue
-    for (auto dep_it = dep_uids.begin(); dep_it != dep_uids.end();) {
-        auto queue_iter = writeQueue.find(*dep_it);
-        if (queue_iter != writeQueue.end()) {
-            auto queued_inst = queue_iter->second;
-            inst->addRuntimeDependency(queued_inst);
-            queued_inst->addRuntimeUser(inst);
-            dep_it = dep_uids.erase(dep_it);
-        } else {
-            dep_it++;
-        }
-    }
-
-    // if (!dep_uids.empty()) {
-    //     // Check the memory write queue
-    //     // for (auto queued_write : writeQueue) {
-    //     for (auto wq_it = writeQueue.begin(); wq_it != writeQueue.end(); wq_it++) {
-    //         auto queued_write = *wq_it;
-    //         auto queued_inst = queued_write.second;
-    //         // Look at each instruction in runtime queue once
-    //         for (auto dep_it = dep_uids.begin(); dep_it != dep_uids.end();) {
-    //             // Check if any of the instruction to be scheduled dependencies match the current instruction from queue
-    //             if (queued_inst->getUID() == *dep_it) {
-    //                 // If dependency found, create two way link
-    //                 inst->addRuntimeDependency(queued_inst);
-    //                 queued_inst->addRuntimeUser(inst);
-    //                 dep_it = dep_uids.erase(dep_it);
-    //             } else {
-    //                 dep_it++;
-    //             }
-    //         }
-    //         if (dep_uids.empty()) break;
-    //     }
-    // }
+    dep_uids.resize(unresolved);
 
     // Fetch values for resolved dependencies, static elements, and immediate values
     if (!dep_uids.empty()) {
@@ -449,7 +662,16 @@ LLVMInterface::constructStaticGraph() {
     std::unique_ptr<llvm::DominatorTree> dt(new llvm::DominatorTree());
     std::unique_ptr<llvm::LoopInfoBase<llvm::BasicBlock, llvm::Loop>> loopInfo(new llvm::LoopInfoBase<llvm::BasicBlock, llvm::Loop>());
 
-    m = llvm::parseIRFile(file, *error, *context);
+    // Loop latches are stored in the graph cache by value ID
+    SALAM::GraphCache graphCache(graphCacheDir, filename);
+    std::vector<uint64_t> latches;
+    m = graphCache.load(*context, latches);
+    graphCacheHit = (m != nullptr);
+    if (graphCacheHit) {
+        DPRINTF(LLVMParse, "Loaded static graph from %s\n", graphCache.path());
+    } else {
+        m = llvm::parseIRFile(file, *error, *context);
+    }
     if(!m) panic("Error reading Module");
 
     // Construct the LLVM::Value to SALAM::Value map
@@ -495,6 +717,7 @@ LLVMInterface::constructStaticGraph() {
             for (auto inst_iter = bb.begin(); inst_iter != bb.end(); inst_iter++) {
                 llvm::Instruction &inst = *inst_iter;
                 std::shared_ptr<SALAM::Instruction> sinst = createInstruction(&inst, valueID);
+                sinst->linkFunctionalUnit(hw);
                 values.push_back(sinst);
                 vmap.insert(SALAM::irvmaptype(&inst, sinst));
                 valueID++;
@@ -525,27 +748,69 @@ LLVMInterface::constructStaticGraph() {
     if (functions.size() == 1) functions.front()->setTop(true);
 
     // Detect Loop Latches
-    for (auto func_iter = m->begin(); func_iter != m->end(); func_iter++) {
-        llvm::Function &func = *func_iter;
-        dt->recalculate(func);
-        loopInfo->releaseMemory();
-        loopInfo->analyze(*dt);
-        for (auto loop=loopInfo->begin(); loop!=loopInfo->end(); ++loop) {
-            if (llvm::BasicBlock *exBB = (*loop)->getExitingBlock()) {
-                auto latchingBr = exBB->getTerminator();
-                auto mapIt = vmap.find(latchingBr);
-                if (mapIt != vmap.end()) {
-                    auto salamValue = mapIt->second;
-                    if (std::shared_ptr<SALAM::Br> sBr =
-                        std::dynamic_pointer_cast<SALAM::Br>(salamValue)) {
-                            sBr->setLatching(true);
-                        }
+    if (!graphCacheHit) {
+        for (auto func_iter = m->begin(); func_iter != m->end(); func_iter++) {
+            llvm::Function &func = *func_iter;
+            dt->recalculate(func);
+            loopInfo->releaseMemory();
+            loopInfo->analyze(*dt);
+            for (auto loop=loopInfo->begin(); loop!=loopInfo->end(); ++loop) {
+                if (llvm::BasicBlock *exBB = (*loop)->getExitingBlock()) {
+                    auto latchingBr = exBB->getTerminator();
+                    auto mapIt = vmap.find(latchingBr);
+                    if (mapIt != vmap.end()) latches.push_back(mapIt->second->getUID());
                 }
             }
         }
+        if (graphCache.enabled()) {
+            if (graphCache.store(*m, latches))
+                DPRINTF(LLVMParse, "Stored static graph in %s\n", graphCache.path());
+            else
+                warn("Unable to write static graph cache %s\n", graphCache.path());
+        }
+    }
+    for (auto uid : latches) {
+        // Value IDs are assigned in construction order
+        assert(uid < values.size() && values[uid]->getUID() == uid);
+        if (std::shared_ptr<SALAM::Br> sBr =
+            std::dynamic_pointer_cast<SALAM::Br>(values[uid])) {
+                sBr->setLatching(true);
+            }
     }
+
+    // Lower instructions to specialized compute kernels. Lane-wise vector
+    // instructions are always lowered since they have no compute().
+    size_t lowered = 0;
+    for (auto val : values) {
+        if (!val->isInstruction()) continue;
+        auto inst = std::static_pointer_cast<SALAM::Instruction>(val);
+        if (SALAM::isLaneWise(inst.get())) {
+            SALAM::ComputeKernel kernel = SALAM::lowerVectorKernel(inst.get());
+            if (!kernel) panic("Unsupported vector instruction: %s\n", inst->getIRString());
+            inst->setVectorKernel(kernel);
+        } else if (compute_kernels) {
+            inst->setComputeKernel(SALAM::lowerComputeKernel(inst.get()));
+        }
+        if (inst->hasComputeKernel()) lowered++;
+    }
+    DPRINTF(LLVMParse, "Lowered %d instructions to compute kernels\n", lowered);
+
+    // Pack the return registers of the static graph into one register file.
+    // Dynamic instances are cloned later and point to the same slots.
+    size_t numRegisters = 0;
+    size_t laneBytes = 0;
+    for (auto val : values) {
+        if (!val->getReg()) continue;
+        numRegisters++;
+        laneBytes += SALAM::RegisterFile::laneSpace(*(val->getReg()));
+    }
+    registerFile.reserve(numRegisters, laneBytes);
+    for (auto val : values) {
+        if (val->getReg()) val->bindRegister(registerFile.bind(*(val->getReg())));
+    }
+    DPRINTF(LLVMParse, "Packed %d registers into the register file\n", registerFile.size());
     auto parseStop = std::chrono::high_resolution_clock::now();
-    setupTime = parseStop - parseStart;
+    stats.hostSetupSeconds += std::chrono::duration<double>(parseStop - parseStart).count();
 }
 
 void
@@ -596,6 +861,7 @@ LLVMInterface::readCommit(MemoryRequest * req) {
         DPRINTF(Runtime, "Global Read Commit\n");
         // delete queue_iter->first; // The CommInterface will ultimately delete this memory request
         globalReadQueue.erase(queue_iter);
+        wakeup();
     } else {
         panic("Could not find memory request in global read queue!");
     }
@@ -619,6 +885,7 @@ LLVMInterface::ActiveFunction::readCommit(MemoryRequest * req) {
             load_inst->commit();
             readQueue.erase(queue_iter);
             readQueueMap.erase(map_iter);
+            retire(load_inst);
         } else {
             panic("Could not find memory request in read queue for function %u!", func->getUID());
         }
@@ -638,6 +905,7 @@ LLVMInterface::writeCommit(MemoryRequest * req) {
         queue_iter->second->writeCommit(req);
         // delete queue_iter->first; // The CommInterface will ultimately delete this memory request
         globalWriteQueue.erase(queue_iter);
+        wakeup();
     } else {
         panic("Could not find memory request in global write queue!");
     }
@@ -653,11 +921,13 @@ LLVMInterface::ActiveFunction::writeCommit(MemoryRequest * req) {
     if (map_iter != writeQueueMap.end()) {
         auto queue_iter = writeQueue.find(map_iter->second);
         if (queue_iter != writeQueue.end()) {
-            queue_iter->second->commit();
+            auto store_inst = queue_iter->second;
+            store_inst->commit();
             Addr addressWritten = map_iter->first->getAddress();
             untrackWrite(addressWritten);
             writeQueue.erase(queue_iter);
             writeQueueMap.erase(map_iter);
+            retire(store_inst);
         } else {
             panic("Could not find memory request in write queue for function %u!", func->getUID());
         }
@@ -676,14 +946,8 @@ LLVMInterface::initialize() {
 *********************************************************************************************/
     // if (DTRACE(Trace)) DPRINTF(Runtime, "Trace: %s \n", __PRETTY_FUNCTION__);
     if (dbg) DPRINTF(LLVMInterface, "Initializing LLVM Runtime Engine!\n");
-    setupTime = std::chrono::seconds(0);
-    simTime = std::chrono::seconds(0);
-    schedulingTime = std::chrono::seconds(0);
-    queueProcessTime = std::chrono::seconds(0);
-    computeTime = std::chrono::seconds(0);
-    hwTime = std::chrono::seconds(0);
     constructStaticGraph();
-    timeStart = std::chrono::high_resolution_clock::now();
+    hw->salam_power_model->kernelStart(clock_period);
     if (dbg) DPRINTF(LLVMInterface, "================================================================\n");
     launchTopFunction();
     
@@ -697,8 +961,8 @@ LLVMInterface::initialize() {
            "*                 Begin Runtime Simulation Computation Engine                 *",
            "*******************************************************************************");
     running = true;
+    quiesced = false;
     cycle = 0;
-    stalls = 0;
     tick();
 }
 
@@ -744,166 +1008,49 @@ LLVMInterface::startup() {
 void
 LLVMInterface::finalize() {
     // if (DTRACE(Trace)) DPRINTF(Runtime, "Trace: %s \n", __PRETTY_FUNCTION__);
-    // Simulation Times
-    simStop = std::chrono::high_resolution_clock::now();
-    simTotal = simStop - timeStart;
-    printResults();
+    recordResults();
+    hw->hw_statistics->flushTrace();
+    instructionPools.clear();
     functions.clear();
     values.clear();
     comm->finish();
 }
 
 void
-LLVMInterface::printResults() {
-
-
-    std::map<uint64_t, uint64_t> totals_reads;
-    std::map<uint64_t, uint64_t> totals_writes;
+LLVMInterface::recordResults() {
+/*********************************************************************************************
+ Account the register and instruction pool activity of the finished kernel
 
-    std::cout << "********************************************************************************" << std::endl;
-    std::cout << name() << std::endl;
-    
+ Registers and pools count over the whole kernel, so these are added once it finishes. Every
+ other statistic of the compute unit is updated as the kernel runs.
+*********************************************************************************************/
+    uint64_t reg_bits = 0;
+    uint64_t reg_reads = 0;
+    uint64_t reg_writes = 0;
+    uint64_t reg_bit_accesses = 0;
     for (auto it : values) {
-        if (it->isInstruction()) { 
-            //std::cout << "Instruction: " << llvm::Instruction::getOpcodeName(it->getOpode()) << "\n";
-            if (it->getReg()) {
-                totals_reads[it->getOpode()] += it->getReg()->getReads();
-                totals_writes[it->getOpode()] += it->getReg()->getWrites();
-            }
+        if (it->isInstruction() && it->getReg()) {
+            uint64_t bits = it->getSizeInBytes() * 8;
+            uint64_t accesses = it->getReg()->getReads() + it->getReg()->getWrites();
+            reg_bits += bits;
+            reg_reads += it->getReg()->getReads();
+            reg_writes += it->getReg()->getWrites();
+            reg_bit_accesses += accesses * bits;
         }
     }
-
-    /*
-    for(const auto& count : hw->opcodes->usage) {
-        if (count.second) std::cout << "\nInstruction: " << llvm::Instruction::getOpcodeName(count.first) << "\n\tIR Count: " << count.second << "\n\tTotal Reads: " << totals_reads[count.first] << "\n\tTotal Writes: " << totals_writes[count.first];
+    stats.registerBits += reg_bits;
+    stats.registerReads += reg_reads;
+    stats.registerWrites += reg_writes;
+    stats.registerBitAccesses += reg_bit_accesses;
+    hw->salam_power_model->kernelEnd(cycle, reg_bits, reg_reads, reg_writes, reg_bit_accesses);
+
+    for (auto &it : instructionPools) {
+        stats.instPoolAllocations += it.second.getAllocations();
+        stats.instPoolReuses += it.second.getReuses();
+        stats.instPoolDiscards += it.second.getDiscards();
     }
-    std::cout << "\n";
-    */
-
-   //hw->hw_statistics->print();
-
-
-    double adder_area = (hw->opcodes->get_usage(13) + hw->opcodes->get_usage(20) + hw->opcodes->get_usage(15)) *  1.794430e+02;
-    double adder_reads = (totals_reads[13] + totals_reads[15]);
-    double adder_writes = (totals_writes[13] + totals_writes[15]);
-    double adder_power_static = adder_reads*2.380803e-03; 
-    double adder_power_dynamic =  adder_writes*(8.115300e-03+6.162853e-03);
-
-    double bitwise_area = (hw->opcodes->get_usage(29) + hw->opcodes->get_usage(30) + hw->opcodes->get_usage(25) + hw->opcodes->get_usage(26) + hw->opcodes->get_usage(27) + hw->opcodes->get_usage(28)) * 5.036996e+01;
-    double bitwise_reads = (totals_reads[25] + totals_reads[26] + totals_reads[27] + totals_reads[28] + totals_reads[29] + totals_reads[30]);
-    double bitwise_writes = (totals_writes[25] + totals_writes[26] + totals_writes[27] + totals_writes[28] + totals_writes[29] + totals_writes[30]);
-    double bitwise_power_static = bitwise_reads*6.111633e-04;
-    double bitwise_power_dynamic = bitwise_writes*(1.680942e-03+1.322420e-03);
-
-    double multiplier_area = (hw->opcodes->get_usage(17) + hw->opcodes->get_usage(19) + hw->opcodes->get_usage(20))*4.595000e+03;
-    double multiplier_reads = totals_reads[17] + totals_reads[19] + totals_reads[20];
-    double multiplier_writes = totals_writes[17] + totals_writes[19] + totals_writes[20];
-    double multiplier_power_static = multiplier_reads*4.817683e-02;
-    double multiplier_power_dynamic = multiplier_writes*(5.725752e-01+8.662890e-01);
-
-    double reg_area = hw->opcodes->get_usage(34)*32*5.981433e+00;
-    double reg_reads = totals_reads[34]*32;
-    double reg_writes = totals_writes[34]*32;
-    double register_power_static = reg_reads*7.395312e-05;
-    double register_power_dynamic = reg_writes*(1.322600e-03+1.792126e-04);
-
-    double total_area = adder_area + bitwise_area + multiplier_area + reg_area;
-    double total_power_static = adder_power_static + bitwise_power_static + multiplier_power_static + register_power_static;
-    double total_power_dynamic = adder_power_dynamic + bitwise_power_dynamic + multiplier_power_dynamic + register_power_dynamic;
-
-    std::cout << "Total Area: " << total_area;
-    std::cout << "\nTotal Power Static: " << total_power_static << "\n";
-    std::cout << "\nTotal Power Dynamic: " << total_power_dynamic << "\n";
-
-    // if (DTRACE(Trace)) DPRINTF(Runtime, "Trace: %s \n", __PRETTY_FUNCTION__);
-    Tick cycle_time = clock_period/1000;
-
-    auto hwTimingMS = std::chrono::duration_cast<std::chrono::milliseconds>(hwTime);
-    auto hwHours = std::chrono::duration_cast<std::chrono::hours>(hwTimingMS);
-    hwTimingMS -= std::chrono::duration_cast<std::chrono::seconds>(hwHours);
-    auto hwMins = std::chrono::duration_cast<std::chrono::minutes>(hwTimingMS);
-    hwTimingMS -= std::chrono::duration_cast<std::chrono::seconds>(hwMins);
-    auto hwSecs = std::chrono::duration_cast<std::chrono::seconds>(hwTimingMS);
-    hwTimingMS -= std::chrono::duration_cast<std::chrono::seconds>(hwSecs);
-
-    //auto setupMS = std::chrono::duration_cast<std::chrono::milliseconds>(setupTime);
-    
-    //auto setupHours = std::chrono::duration_cast<std::chrono::hours>(setupMS);
-    //setupMS -= std::chrono::duration_cast<std::chrono::seconds>(setupHours);
-    //auto setupMins = std::chrono::duration_cast<std::chrono::minutes>(setupMS);
-    //setupMS -= std::chrono::duration_cast<std::chrono::seconds>(setupMins);
-    //auto setupSecs = std::chrono::duration_cast<std::chrono::seconds>(setupMS);
-    //setupMS -= std::chrono::duration_cast<std::chrono::seconds>(setupSecs);
-    
-    auto setupUS = std::chrono::duration_cast<std::chrono::microseconds>(setupTime);
-    auto setupHours = std::chrono::duration_cast<std::chrono::hours>(setupUS);
-    setupUS -= std::chrono::duration_cast<std::chrono::seconds>(setupHours);
-    auto setupMins = std::chrono::duration_cast<std::chrono::minutes>(setupUS);
-    setupUS -= std::chrono::duration_cast<std::chrono::seconds>(setupMins);
-    auto setupSecs = std::chrono::duration_cast<std::chrono::seconds>(setupUS);
-    setupUS -= std::chrono::duration_cast<std::chrono::seconds>(setupSecs);
-    
-    auto setupMS = std::chrono::duration_cast<std::chrono::milliseconds>(setupUS);
-    
-    setupUS -= std::chrono::duration_cast<std::chrono::milliseconds>(setupMS);
-
-    auto totalMS = std::chrono::duration_cast<std::chrono::milliseconds>(simTotal);
-    auto totalHours = std::chrono::duration_cast<std::chrono::hours>(totalMS);
-    totalMS -= std::chrono::duration_cast<std::chrono::seconds>(totalHours);
-    auto totalMins = std::chrono::duration_cast<std::chrono::minutes>(totalMS);
-    totalMS -= std::chrono::duration_cast<std::chrono::seconds>(totalMins);
-    auto totalSecs = std::chrono::duration_cast<std::chrono::seconds>(totalMS);
-    totalMS -= std::chrono::duration_cast<std::chrono::seconds>(totalSecs);
-    
-    auto simMS = std::chrono::duration_cast<std::chrono::milliseconds>(simTime);
-    auto simHours = std::chrono::duration_cast<std::chrono::hours>(simMS);
-    simMS -= std::chrono::duration_cast<std::chrono::seconds>(simHours);
-    auto simMins = std::chrono::duration_cast<std::chrono::minutes>(simMS);
-    simMS -= std::chrono::duration_cast<std::chrono::seconds>(simMins);
-    auto simSecs = std::chrono::duration_cast<std::chrono::seconds>(simMS);
-    simMS -= std::chrono::duration_cast<std::chrono::seconds>(simSecs);
-
-    auto queueMS = std::chrono::duration_cast<std::chrono::milliseconds>(queueProcessTime);
-    auto queueHours = std::chrono::duration_cast<std::chrono::hours>(queueMS);
-    queueMS -= std::chrono::duration_cast<std::chrono::seconds>(queueHours);
-    auto queueMins = std::chrono::duration_cast<std::chrono::minutes>(queueMS);
-    queueMS -= std::chrono::duration_cast<std::chrono::seconds>(queueMins);
-    auto queueSecs = std::chrono::duration_cast<std::chrono::seconds>(queueMS);
-    queueMS -= std::chrono::duration_cast<std::chrono::seconds>(queueSecs);
-
-    auto schedMS = std::chrono::duration_cast<std::chrono::milliseconds>(schedulingTime);
-    auto schedHours = std::chrono::duration_cast<std::chrono::hours>(schedMS);
-    schedMS -= std::chrono::duration_cast<std::chrono::seconds>(schedHours);
-    auto schedMins = std::chrono::duration_cast<std::chrono::minutes>(schedMS);
-    schedMS -= std::chrono::duration_cast<std::chrono::seconds>(schedMins);
-    auto schedSecs = std::chrono::duration_cast<std::chrono::seconds>(schedMS);
-    schedMS -= std::chrono::duration_cast<std::chrono::seconds>(schedSecs);
-
-    auto computeMS = std::chrono::duration_cast<std::chrono::milliseconds>(computeTime);
-    auto computeHours = std::chrono::duration_cast<std::chrono::hours>(computeMS);
-    computeMS -= std::chrono::duration_cast<std::chrono::seconds>(computeHours);
-    auto computeMins = std::chrono::duration_cast<std::chrono::minutes>(computeMS);
-    computeMS -= std::chrono::duration_cast<std::chrono::seconds>(computeMins);
-    auto computeSecs = std::chrono::duration_cast<std::chrono::seconds>(computeMS);
-    computeMS -= std::chrono::duration_cast<std::chrono::seconds>(computeSecs);
-
-/*********************************************************************************************
- Prints usage statistics of how many times each instruction was accessed during runtime
-*********************************************************************************************/
-
-    std::cout << "   ========= Performance Analysis =============" << std::endl;
-    std::cout << "   Setup Time:                      " << setupHours.count() << "h " << setupMins.count() << "m " << setupSecs.count() << "s " << setupMS.count() << "ms " << setupUS.count() << "us" << std::endl;
-    std::cout << "   Simulation Time (Total):         " << totalHours.count() << "h " << totalMins.count() << "m " << totalSecs.count() << "s " << totalMS.count() << "ms" << std::endl;
-    std::cout << "   Simulation Time (Active):        " << simHours.count() << "h " << simMins.count() << "m " << simSecs.count() << "s " << simMS.count() << "ms" << std::endl;
-    std::cout << "        Queue Processing Time:      " << queueHours.count() << "h " << queueMins.count() << "m " << queueSecs.count() << "s " << queueMS.count() << "ms" << std::endl;
-    std::cout << "             Scheduling Time:       " << schedHours.count() << "h " << schedMins.count() << "m " << schedSecs.count() << "s " << schedMS.count() << "ms" << std::endl;
-    std::cout << "             Computation Time:      " << computeHours.count() << "h " << computeMins.count() << "m " << computeSecs.count() << "s " << computeMS.count() << "ms" << std::endl;
-    std::cout << "   System Clock:                    " << 1.0/(cycle_time) << "GHz" << std::endl;
-    std::cout << "   Runtime:                         " << cycle << " cycles" << std::endl;
-    std::cout << "   Runtime:                         " << (cycle*cycle_time*(1e-3)) << " us" << std::endl;
-    std::cout << "   Stalls:                          " << stalls << " cycles" << std::endl;
-    std::cout << "   Executed Nodes:                  " << (cycle-stalls-1) << " cycles" << std::endl;
-    std::cout << std::endl;
+    if (dbg) DPRINTF(LLVMInterface, "Kernel finished after %d cycles%s\n", cycle,
+        graphCacheDir.empty() ? "" : (graphCacheHit ? " (graph cache hit)" : " (graph cache miss)"));
 }
 
 void
@@ -996,6 +1143,14 @@ void LLVMInterface::ActiveFunction::launch() {
     scheduleBB(func->entry());
 }
 
+uint64_t
+LLVMInterface::vectorCycles(llvm::Instruction * inst, uint64_t cycles) {
+    // Vectors wider than the datapath issue in several passes
+    if (!simd_lanes || !inst->getType()->isVectorTy()) return cycles;
+    uint64_t lanes = SALAM::vectorLanes(inst->getType());
+    return cycles * ((lanes + simd_lanes - 1) / simd_lanes);
+}
+
 std::shared_ptr<SALAM::Instruction>
 LLVMInterface::createInstruction(llvm::Instruction * inst, uint64_t id) {
     // if (DTRACE(Trace)) DPRINTF(Runtime, "Trace: %s \n", __PRETTY_FUNCTION__);
@@ -1010,59 +1165,57 @@ LLVMInterface::createInstruction(llvm::Instruction * inst, uint64_t id) {
         if(OpCode == hw_inst->get_opcode_num()) {
             //std::cout << "\n\n\nTest 4\n\n\n";
             functional_unit = hw_inst->get_functional_unit();
-            for (auto hw_fu : hw->functional_units->functional_unit_list) {
-                //std::cout << "\n\n\nTest 5\n\n\n";
-                if(hw_fu->get_enum_value() == functional_unit) {
-                    //std::cout << "\n\n\nTest 6\n\n\n";
-                    hw_fu->inc_functional_unit_limit();
-                    break;
-                }
-            }
+            auto hw_fu = hw->getFunctionalUnit(functional_unit);
+            if (hw_fu) hw_fu->inc_functional_unit_limit();
             break;
         } 
     }
 
     switch(OpCode) {
-        case llvm::Instruction::Ret : return SALAM::createRetInst(id, this, debug(), OpCode, hw->cycle_counts->ret_inst, functional_unit); break;
-        case llvm::Instruction::Br: return SALAM::createBrInst(id, this, debug(), OpCode, hw->cycle_counts->br_inst, functional_unit); break;
-        case llvm::Instruction::Switch: return SALAM::createSwitchInst(id, this, debug(), OpCode, hw->cycle_counts->switch_inst, functional_unit); break;
-        case llvm::Instruction::Add: return SALAM::createAddInst(id, this, debug(), OpCode, hw->cycle_counts->add_inst, functional_unit); break;
-        case llvm::Instruction::FAdd: return SALAM::createFAddInst(id, this, debug(), OpCode, hw->cycle_counts->fadd_inst, functional_unit); break;
-        case llvm::Instruction::Sub: return SALAM::createSubInst(id, this, debug(), OpCode, hw->cycle_counts->sub_inst, functional_unit); break;
-        case llvm::Instruction::FSub: return SALAM::createFSubInst(id, this, debug(), OpCode, hw->cycle_counts->fsub_inst, functional_unit); break;
-        case llvm::Instruction::Mul: return SALAM::createMulInst(id, this, debug(), OpCode, hw->cycle_counts->mul_inst, functional_unit); break;
-        case llvm::Instruction::FMul: return SALAM::createFMulInst(id, this, debug(), OpCode, hw->cycle_counts->fmul_inst, functional_unit); break;
-        case llvm::Instruction::UDiv: return SALAM::createUDivInst(id, this, debug(), OpCode, hw->cycle_counts->udiv_inst, functional_unit); break;
-        case llvm::Instruction::SDiv: return SALAM::createSDivInst(id, this, debug(), OpCode, hw->cycle_counts->sdiv_inst, functional_unit); break;
-        case llvm::Instruction::FDiv: return SALAM::createFDivInst(id, this, debug(), OpCode, hw->cycle_counts->fdiv_inst, functional_unit); break;
-        case llvm::Instruction::URem: return SALAM::createURemInst(id, this, debug(), OpCode, hw->cycle_counts->urem_inst, functional_unit); break;
-        case llvm::Instruction::SRem: return SALAM::createSRemInst(id, this, debug(), OpCode, hw->cycle_counts->srem_inst, functional_unit); break;
-        case llvm::Instruction::FRem: return SALAM::createFRemInst(id, this, debug(), OpCode, hw->cycle_counts->frem_inst, functional_unit); break;
-        case llvm::Instruction::Shl: return SALAM::createShlInst(id, this, debug(), OpCode, hw->cycle_counts->shl_inst, functional_unit); break;
-        case llvm::Instruction::LShr: return SALAM::createLShrInst(id, this, debug(), OpCode, hw->cycle_counts->lshr_inst, functional_unit); break;
-        case llvm::Instruction::AShr: return SALAM::createAShrInst(id, this, debug(), OpCode, hw->cycle_counts->ashr_inst, functional_unit); break;
-        case llvm::Instruction::And: return SALAM::createAndInst(id, this, debug(), OpCode, hw->cycle_counts->and_inst, functional_unit); break;
-        case llvm::Instruction::Or: return SALAM::createOrInst(id, this, debug(), OpCode, hw->cycle_counts->or_inst, functional_unit); break;
-        case llvm::Instruction::Xor: return SALAM::createXorInst(id, this, debug(), OpCode, hw->cycle_counts->xor_inst, functional_unit); break;
-        case llvm::Instruction::Load: return SALAM::createLoadInst(id, this, debug(), OpCode, hw->cycle_counts->load_inst, functional_unit); break;
-        case llvm::Instruction::Store: return SALAM::createStoreInst(id, this, debug(), OpCode, hw->cycle_counts->store_inst, functional_unit); break;
-        case llvm::Instruction::GetElementPtr : return SALAM::createGetElementPtrInst(id, this, debug(), OpCode, hw->cycle_counts->gep_inst, functional_unit); break;
-        case llvm::Instruction::Trunc: return SALAM::createTruncInst(id, this, debug(), OpCode, hw->cycle_counts->trunc_inst, functional_unit); break;
-        case llvm::Instruction::ZExt: return SALAM::createZExtInst(id, this, debug(), OpCode, hw->cycle_counts->zext_inst, functional_unit); break;
-        case llvm::Instruction::SExt: return SALAM::createSExtInst(id, this, debug(), OpCode, hw->cycle_counts->sext_inst, functional_unit); break;
-        case llvm::Instruction::FPToUI: return SALAM::createFPToUIInst(id, this, debug(), OpCode, hw->cycle_counts->fptoui_inst, functional_unit); break;
-        case llvm::Instruction::FPToSI: return SALAM::createFPToSIInst(id, this, debug(), OpCode, hw->cycle_counts->fptosi_inst, functional_unit); break;
-        case llvm::Instruction::UIToFP: return SALAM::createUIToFPInst(id, this, debug(), OpCode, hw->cycle_counts->uitofp_inst, functional_unit); break;
-        case llvm::Instruction::SIToFP: return SALAM::createSIToFPInst(id, this, debug(), OpCode, hw->cycle_counts->sitofp_inst, functional_unit); break; 
-        case llvm::Instruction::FPTrunc: return SALAM::createFPTruncInst(id, this, debug(), OpCode, hw->cycle_counts->fptrunc_inst, functional_unit); break;
-        case llvm::Instruction::FPExt: return SALAM::createFPExtInst(id, this, debug(), OpCode, hw->cycle_counts->fpext_inst, functional_unit); break;
-        case llvm::Instruction::PtrToInt: return SALAM::createPtrToIntInst(id, this, debug(), OpCode, hw->cycle_counts->ptrtoint_inst, functional_unit); break;
-        case llvm::Instruction::IntToPtr: return SALAM::createIntToPtrInst(id, this, debug(), OpCode, hw->cycle_counts->inttoptr_inst, functional_unit); break;
-        case llvm::Instruction::ICmp: return SALAM::createICmpInst(id, this, debug(), OpCode, hw->cycle_counts->icmp_inst, functional_unit); break;
-        case llvm::Instruction::FCmp: return SALAM::createFCmpInst(id, this, debug(), OpCode, hw->cycle_counts->fcmp_inst, functional_unit); break;
-        case llvm::Instruction::PHI: return SALAM::createPHIInst(id, this, debug(), OpCode, hw->cycle_counts->phi_inst, functional_unit); break;
-        case llvm::Instruction::Call: return SALAM::createCallInst(id, this, debug(), OpCode, hw->cycle_counts->call_inst, functional_unit); break;
-        case llvm::Instruction::Select: return SALAM::createSelectInst(id, this, debug(), OpCode, hw->cycle_counts->select_inst, functional_unit); break;
+        case llvm::Instruction::Ret : return SALAM::createRetInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->ret_inst), functional_unit); break;
+        case llvm::Instruction::Br: return SALAM::createBrInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->br_inst), functional_unit); break;
+        case llvm::Instruction::Switch: return SALAM::createSwitchInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->switch_inst), functional_unit); break;
+        case llvm::Instruction::Add: return SALAM::createAddInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->add_inst), functional_unit); break;
+        case llvm::Instruction::FAdd: return SALAM::createFAddInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fadd_inst), functional_unit); break;
+        case llvm::Instruction::Sub: return SALAM::createSubInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->sub_inst), functional_unit); break;
+        case llvm::Instruction::FSub: return SALAM::createFSubInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fsub_inst), functional_unit); break;
+        case llvm::Instruction::Mul: return SALAM::createMulInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->mul_inst), functional_unit); break;
+        case llvm::Instruction::FMul: return SALAM::createFMulInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fmul_inst), functional_unit); break;
+        case llvm::Instruction::UDiv: return SALAM::createUDivInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->udiv_inst), functional_unit); break;
+        case llvm::Instruction::SDiv: return SALAM::createSDivInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->sdiv_inst), functional_unit); break;
+        case llvm::Instruction::FDiv: return SALAM::createFDivInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fdiv_inst), functional_unit); break;
+        case llvm::Instruction::URem: return SALAM::createURemInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->urem_inst), functional_unit); break;
+        case llvm::Instruction::SRem: return SALAM::createSRemInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->srem_inst), functional_unit); break;
+        case llvm::Instruction::FRem: return SALAM::createFRemInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->frem_inst), functional_unit); break;
+        case llvm::Instruction::Shl: return SALAM::createShlInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->shl_inst), functional_unit); break;
+        case llvm::Instruction::LShr: return SALAM::createLShrInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->lshr_inst), functional_unit); break;
+        case llvm::Instruction::AShr: return SALAM::createAShrInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->ashr_inst), functional_unit); break;
+        case llvm::Instruction::And: return SALAM::createAndInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->and_inst), functional_unit); break;
+        case llvm::Instruction::Or: return SALAM::createOrInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->or_inst), functional_unit); break;
+        case llvm::Instruction::Xor: return SALAM::createXorInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->xor_inst), functional_unit); break;
+        case llvm::Instruction::Load: return SALAM::createLoadInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->load_inst), functional_unit); break;
+        case llvm::Instruction::Store: return SALAM::createStoreInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->store_inst), functional_unit); break;
+        case llvm::Instruction::GetElementPtr : return SALAM::createGetElementPtrInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->gep_inst), functional_unit); break;
+        case llvm::Instruction::Trunc: return SALAM::createTruncInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->trunc_inst), functional_unit); break;
+        case llvm::Instruction::ZExt: return SALAM::createZExtInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->zext_inst), functional_unit); break;
+        case llvm::Instruction::SExt: return SALAM::createSExtInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->sext_inst), functional_unit); break;
+        case llvm::Instruction::FPToUI: return SALAM::createFPToUIInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fptoui_inst), functional_unit); break;
+        case llvm::Instruction::FPToSI: return SALAM::createFPToSIInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fptosi_inst), functional_unit); break;
+        case llvm::Instruction::UIToFP: return SALAM::createUIToFPInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->uitofp_inst), functional_unit); break;
+        case llvm::Instruction::SIToFP: return SALAM::createSIToFPInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->sitofp_inst), functional_unit); break; 
+        case llvm::Instruction::FPTrunc: return SALAM::createFPTruncInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fptrunc_inst), functional_unit); break;
+        case llvm::Instruction::FPExt: return SALAM::createFPExtInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fpext_inst), functional_unit); break;
+        case llvm::Instruction::PtrToInt: return SALAM::createPtrToIntInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->ptrtoint_inst), functional_unit); break;
+        case llvm::Instruction::IntToPtr: return SALAM::createIntToPtrInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->inttoptr_inst), functional_unit); break;
+        case llvm::Instruction::BitCast: return SALAM::createBitCastInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->bitcast_inst), functional_unit); break;
+        case llvm::Instruction::ICmp: return SALAM::createICmpInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->icmp_inst), functional_unit); break;
+        case llvm::Instruction::FCmp: return SALAM::createFCmpInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->fcmp_inst), functional_unit); break;
+        case llvm::Instruction::PHI: return SALAM::createPHIInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->phi_inst), functional_unit); break;
+        case llvm::Instruction::Call: return SALAM::createCallInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->call_inst), functional_unit); break;
+        case llvm::Instruction::Select: return SALAM::createSelectInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->select_inst), functional_unit); break;
+        case llvm::Instruction::ExtractElement: return SALAM::createExtractElementInst(id, this, debug(), OpCode, hw->cycle_counts->extractelement_inst, functional_unit); break;
+        case llvm::Instruction::InsertElement: return SALAM::createInsertElementInst(id, this, debug(), OpCode, hw->cycle_counts->insertelement_inst, functional_unit); break;
+        case llvm::Instruction::ShuffleVector: return SALAM::createShuffleVectorInst(id, this, debug(), OpCode, vectorCycles(inst, hw->cycle_counts->shufflevector_inst), functional_unit); break;
         default: {
             warn("Tried to create instance of undefined instruction type!"); 
             return SALAM::createBadInst(id, this, dbg, OpCode, 0, 0); break;
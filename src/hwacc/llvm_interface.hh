@@ -34,36 +34,55 @@
 #include "hwacc/HWModeling/src/hw_interface.hh"
 #include "hwacc/LLVMRead/src/basic_block.hh"
 #include "hwacc/LLVMRead/src/debug_flags.hh"
+#include "hwacc/LLVMRead/src/flat_map.hh"
 #include "hwacc/LLVMRead/src/function.hh"
+#include "hwacc/LLVMRead/src/graph_cache.hh"
+#include "hwacc/LLVMRead/src/inflight_index.hh"
+#include "hwacc/LLVMRead/src/instruction_pool.hh"
 #include "hwacc/LLVMRead/src/operand.hh"
 #include "hwacc/compute_unit.hh"
+#include "hwacc/sampled_timer.hh"
+#include "base/statistics.hh"
 #include "params/LLVMInterface.hh"
 
 class LLVMInterface : public ComputeUnit {
   private:
     std::string filename;
     std::string topName;
+    std::string graphCacheDir;
+    bool graphCacheHit = false;
     uint32_t scheduling_threshold;
     int32_t clock_period;
     int cycle;
-    int stalls;
+    Tick lastTick;
+    bool progress;
+    bool quiesced;
 
     bool running;
     bool loadOpScheduled;
     bool storeOpScheduled;
     bool compOpScheduled;
     bool lockstep;
+    bool ready_list_scheduling;
+    bool quiescence;
+    bool compute_kernels;
+    uint32_t simd_lanes;
     bool dbg;
-    std::chrono::duration<float> setupTime;
-    std::chrono::duration<float> simTotal;
-    std::chrono::duration<float> simTime;
-    std::chrono::duration<float> schedulingTime;
-    std::chrono::duration<float> queueProcessTime;
-    std::chrono::duration<float> computeTime;
-    std::chrono::duration<float> hwTime;
-    std::chrono::high_resolution_clock::time_point simStop;
-    std::chrono::high_resolution_clock::time_point setupStop;
-    std::chrono::high_resolution_clock::time_point timeStart;
+
+    // What every active function waited on in a cycle without progress
+    enum StallCause { LoadStall, StoreStall, LoadStoreStall, ComputeStall };
+    StallCause stallCause();
+    // Cause of the stall the cycles skipped by quiescence are accounted to
+    StallCause quiescedCause;
+    void recordStall(StallCause cause, uint64_t cycles);
+
+    /** @{ Sampled host time profilers of the runtime engine */
+    SampledTimer tickTimer;
+    SampledTimer queueTimer;
+    SampledTimer schedulingTimer;
+    SampledTimer computeTimer;
+    SampledTimer hwTimer;
+    /** @} */
 
 
     class ActiveFunction {
@@ -73,24 +92,33 @@ class LLVMInterface : public ComputeUnit {
         HWInterface* hw;
         std::shared_ptr<SALAM::Function> func;
         std::shared_ptr<SALAM::Instruction> caller;
+        SALAM::InstructionPool * pool;
         std::list<std::shared_ptr<SALAM::Instruction>> reservation;
-        std::map<uint64_t, std::shared_ptr<SALAM::Instruction>> readQueue;
-        std::map<MemoryRequest *, uint64_t> readQueueMap;
-        std::map<uint64_t, std::shared_ptr<SALAM::Instruction>> writeQueue;
-        std::map<MemoryRequest *, uint64_t> writeQueueMap;
-        std::map<uint64_t, std::shared_ptr<SALAM::Instruction>> computeQueue;
+        SALAM::FlatMap<uint64_t, std::shared_ptr<SALAM::Instruction>> readQueue;
+        SALAM::FlatMap<MemoryRequest *, uint64_t> readQueueMap;
+        SALAM::FlatMap<uint64_t, std::shared_ptr<SALAM::Instruction>> writeQueue;
+        SALAM::FlatMap<MemoryRequest *, uint64_t> writeQueueMap;
+        SALAM::FlatMap<uint64_t, std::shared_ptr<SALAM::Instruction>> computeQueue;
+        SALAM::InFlightIndex<std::shared_ptr<SALAM::Instruction>> inFlight;
+        // Ready-list scheduling: reserved instructions without outstanding
+        // dependencies keyed by scheduling order, and in-flight compute
+        // instructions keyed by the cycle they commit in
+        std::map<uint64_t, std::list<std::shared_ptr<SALAM::Instruction>>::iterator> readyList;
+        std::map<uint64_t, std::vector<std::shared_ptr<SALAM::Instruction>>> computeWheel;
+        uint64_t nextSequence = 0;
         std::shared_ptr<SALAM::BasicBlock> previousBB;
         HW_Cycle_Stats hw_cycle_stats;
         uint32_t scheduling_threshold;
         bool returned = false;
         bool lockstep;
+        bool readyListScheduling;
         bool dbg;
 
         inline bool uidActive(uint64_t id) {
           return computeUIDActive(id) || readUIDActive(id) || writeUIDActive(id);
         }
 
-        std::map<Addr, std::shared_ptr<SALAM::Instruction>> activeWrites;
+        SALAM::FlatMap<Addr, std::shared_ptr<SALAM::Instruction>> activeWrites;
         inline void trackWrite(Addr writeAddr, std::shared_ptr<SALAM::Instruction> writeInst) {
           activeWrites.insert({writeAddr, writeInst});
         }
@@ -128,13 +156,35 @@ class LLVMInterface : public ComputeUnit {
         inline bool computeUIDActive(uint64_t uid) {
           return (computeQueue.find(uid) != computeQueue.end());
         }
+        // Structural hazard check, counted as a stall for the issue ports or
+        // the unit type
+        inline bool functionalUnitAvailable(std::shared_ptr<SALAM::Instruction> inst) {
+          if (!inst->hasFunctionalUnit()) return true;
+          if (!hw->availableIssuePort(inst->getFunctionalUnit())) {
+            hw->stallIssuePort();
+            owner->stallIssuePort();
+            return false;
+          }
+          if (hw->availableFunctionalUnit(inst->getFunctionalUnit())) return true;
+          hw->stallFunctionalUnit(inst->getFunctionalUnit());
+          owner->stallFunctionalUnit(inst->getFunctionalUnit());
+          return false;
+        }
+        // Called once an instance has left every runtime queue
+        inline void retire(std::shared_ptr<SALAM::Instruction> inst, bool recycle=true) {
+          inFlight.remove(inst);
+          if (recycle) pool->release(inst);
+        }
     public:
         ActiveFunction(LLVMInterface * _owner, std::shared_ptr<SALAM::Function> _func,
                        std::shared_ptr<SALAM::Instruction> _caller):
                        owner(_owner), func(_func), caller(_caller),
                        previousBB(nullptr) {
+                          hw = owner->hw;
+                          pool = owner->getInstructionPool(func);
                           scheduling_threshold = owner->getSchedulingThreshold();
                           lockstep = (owner->getLockstepStatus());
+                          readyListScheduling = owner->getReadyListScheduling();
                           dbg = owner->debug();
                        }
         void readCommit(MemoryRequest *req);
@@ -142,10 +192,27 @@ class LLVMInterface : public ComputeUnit {
         void findDynamicDeps(std::shared_ptr<SALAM::Instruction> inst);
         void scheduleBB(std::shared_ptr<SALAM::BasicBlock> bb);
         void processQueues();
+        void recordCycleStats();
+        bool issue(std::shared_ptr<SALAM::Instruction> inst);
+        void trackReady(std::shared_ptr<SALAM::Instruction> inst);
+        void trackCompute(std::shared_ptr<SALAM::Instruction> inst);
+        void commitComputeWheel();
         void launch();
         inline bool queuesClear() {
           return readQueue.empty() && writeQueue.empty() && computeQueue.empty();
         }
+        // Quiescence is only possible if no compute instruction needs polling
+        inline bool canQuiesce() {
+          return readyListScheduling || computeQueue.empty();
+        }
+        inline bool memoryInFlight() {
+          return !readQueue.empty() || !writeQueue.empty();
+        }
+        inline bool loadsInFlight() { return !readQueue.empty(); }
+        inline bool storesInFlight() { return !writeQueue.empty(); }
+        inline uint64_t nextComputeCycle() {
+          return computeWheel.empty() ? 0 : computeWheel.begin()->first;
+        }
         inline bool lockstepReady() {
           return !lockstep || queuesClear();
         }
@@ -158,11 +225,65 @@ class LLVMInterface : public ComputeUnit {
     };
 
     std::list<ActiveFunction> activeFunctions;
-    std::map<MemoryRequest *, ActiveFunction *> globalReadQueue;
-    std::map<MemoryRequest *, ActiveFunction *> globalWriteQueue;
+    SALAM::FlatMap<MemoryRequest *, ActiveFunction *> globalReadQueue;
+    SALAM::FlatMap<MemoryRequest *, ActiveFunction *> globalWriteQueue;
 
     std::vector<std::shared_ptr<SALAM::Function>> functions;
     std::vector<std::shared_ptr<SALAM::Value>> values;
+    SALAM::RegisterFile registerFile;
+    std::map<uint64_t, SALAM::InstructionPool> instructionPools;
+
+    struct ComputeStats : public statistics::Group
+    {
+        ComputeStats(LLVMInterface &unit);
+
+        void regStats() override;
+
+        LLVMInterface &unit;
+        // Stat index of each functional unit enum value, -1 if not modeled
+        std::vector<int> fuIndex;
+
+        /** @{ Cycles of the datapath */
+        statistics::Scalar cycles;
+        statistics::Scalar stallCycles;
+        statistics::Scalar quiescedCycles;
+        statistics::Scalar loadStallCycles;
+        statistics::Scalar storeStallCycles;
+        statistics::Scalar loadStoreStallCycles;
+        statistics::Scalar computeStallCycles;
+        statistics::Formula activeCycles;
+        /** @} */
+
+        /** @{ Issue attempts held back by a hazard */
+        statistics::Scalar rawStalls;
+        statistics::Vector fuStalls;
+        statistics::Scalar issueStalls;
+        /** @} */
+
+        /** Dynamic instructions by LLVM opcode */
+        statistics::Vector opcodes;
+        statistics::Formula dynamicInsts;
+        statistics::Scalar instPoolAllocations;
+        statistics::Scalar instPoolReuses;
+        statistics::Scalar instPoolDiscards;
+
+        /** @{ Register activity, recorded when the kernel finishes */
+        statistics::Scalar registerBits;
+        statistics::Scalar registerReads;
+        statistics::Scalar registerWrites;
+        statistics::Scalar registerBitAccesses;
+        /** @} */
+
+        /** @{ Host time, sampled by the profilers */
+        statistics::Scalar hostSetupSeconds;
+        statistics::Scalar hostActiveSeconds;
+        statistics::Scalar hostQueueSeconds;
+        statistics::Scalar hostSchedulingSeconds;
+        statistics::Scalar hostComputeSeconds;
+        statistics::Scalar hostStatsSeconds;
+        statistics::Formula hostMIPS;
+        /** @} */
+    } stats;
   protected:
     // const std::string name() const { return comm->getName() + ".compute"; }
     virtual bool debug() { return comm->debug(); }
@@ -175,12 +296,15 @@ class LLVMInterface : public ComputeUnit {
     void startup();
     void initialize();
     void finalize();
+    bool quiesce();
+    void wakeup();
     void debug(uint64_t flags);
     bool getLockstepStatus() { return lockstep; }
+    bool getReadyListScheduling() { return ready_list_scheduling; }
     void readCommit(MemoryRequest *req);
     void writeCommit(MemoryRequest *req);
     void dumpModule(llvm::Module *m);
-    void printResults();
+    void recordResults();
     void launchFunction(std::shared_ptr<SALAM::Function> callee,
                         std::shared_ptr<SALAM::Instruction> caller);
     void launchTopFunction();
@@ -189,12 +313,17 @@ class LLVMInterface : public ComputeUnit {
     void launchWrite(MemoryRequest * memReq, ActiveFunction * func);
     std::shared_ptr<SALAM::Instruction> createInstruction(llvm::Instruction *inst,
                                                           uint64_t id);
+    uint64_t vectorCycles(llvm::Instruction *inst, uint64_t cycles);
     void dumpQueues();
     uint32_t getSchedulingThreshold() { return scheduling_threshold; }
-    void addSchedulingTime(std::chrono::duration<float> timeDelta) { schedulingTime = schedulingTime + timeDelta; }
-    void addQueueTime(std::chrono::duration<float> timeDelta) { queueProcessTime = queueProcessTime + timeDelta; }
-    void addComputeTime(std::chrono::duration<float> timeDelta) { computeTime = computeTime + timeDelta; }
-    void addHWTime(std::chrono::duration<float> timeDelta) { hwTime = hwTime + timeDelta; }
+    SALAM::InstructionPool * getInstructionPool(std::shared_ptr<SALAM::Function> func) {
+      return &(instructionPools[func->getUID()]);
+    }
+    void stallFunctionalUnit(uint64_t functional_unit) {
+      int index = (functional_unit < stats.fuIndex.size()) ? stats.fuIndex[functional_unit] : -1;
+      if (index >= 0) stats.fuStalls[index]++;
+    }
+    void stallIssuePort() { stats.issueStalls++; }
 };
 
 #endif //__HWACC_LLVM_INTERFACE_HH__
@@ -15,22 +15,108 @@ NoncoherentDma::NoncoherentDma(const NoncoherentDmaParams &p)
     intNum(p.int_num),
     clock_period(p.clock_period),
     tickEvent([this]{tick();}, name()),
-    accPort(this, sys, p.sid, p.ssid) {
-    memSideReadFifo = new DmaReadFifo(dmaPort, size_t(bufferSize/2), maxReqSize, maxPending);
+    accPort(this, sys, p.sid, p.ssid),
+    dmaStats(*this) {
+    memSideReadFifo = new StridedReadFifo(dmaPort, size_t(bufferSize/2), maxReqSize, maxPending);
     memSideWriteFifo = new DmaWriteFifo(dmaPort, size_t(bufferSize/2), maxReqSize, maxPending);
-    accSideReadFifo = new DmaReadFifo(accPort, size_t(bufferSize/2), maxReqSize, maxPending);
+    accSideReadFifo = new StridedReadFifo(accPort, size_t(bufferSize/2), maxReqSize, maxPending);
     accSideWriteFifo = new DmaWriteFifo(accPort, size_t(bufferSize/2), maxReqSize, maxPending);
+    memSideReadFifo->setWakeup([this]{ wakeup(); });
+    memSideWriteFifo->setWakeup([this]{ wakeup(); });
+    accSideReadFifo->setWakeup([this]{ wakeup(); });
+    accSideWriteFifo->setWakeup([this]{ wakeup(); });
+    moveBuffer.resize(maxReqSize);
     readFifo = nullptr;
     writeFifo = nullptr;
-    mmreg = new uint8_t[pioSize];
-    for (int i=0; i<pioSize; i++)
+    // Registers past pio_size are never written and keep their defaults
+    Addr mmregSize = (pioSize > channelOffset) ? pioSize : channelOffset;
+    mmreg = new uint8_t[mmregSize];
+    for (Addr i=0; i<mmregSize; i++)
         mmreg[i]=0;
     FLAGS = mmreg;
     last_flag = 0;
     SRC = (uint64_t *)(mmreg+1);
     DST = (uint64_t *)(mmreg+9);
     LEN = (int *)(mmreg+17);
+    ELEM_SIZE = (uint32_t *)(mmreg+stridedOffset);
+    ROWS = (uint32_t *)(mmreg+stridedOffset+4);
+    PLANES = (uint32_t *)(mmreg+stridedOffset+8);
+    SRC_ROW_STRIDE = (uint32_t *)(mmreg+stridedOffset+12);
+    DST_ROW_STRIDE = (uint32_t *)(mmreg+stridedOffset+16);
+    SRC_PLANE_STRIDE = (uint32_t *)(mmreg+stridedOffset+20);
+    DST_PLANE_STRIDE = (uint32_t *)(mmreg+stridedOffset+24);
     running = false;
+
+    // Without channels pio_size only has to cover the registers in use
+    fatal_if(p.descriptor_channels > 0 &&
+             pioSize < channelOffset + p.descriptor_channels * channelSize,
+             "%s needs pio_size %d for %d descriptor channels\n", name(),
+             channelOffset + p.descriptor_channels * channelSize, p.descriptor_channels);
+    for (unsigned i = 0; i < p.descriptor_channels; i++)
+        channels.emplace_back(new Channel(this, i));
+}
+
+NoncoherentDma::Channel::Channel(NoncoherentDma *dma, unsigned _id)
+    : id(_id),
+    state(Idle),
+    lastFlags(0),
+    next(0),
+    fetchEvent([this, dma]{ dma->descriptorFetched(*this); },
+               dma->name() + ".channel" + std::to_string(_id) + ".fetch"),
+    writesLeft(0),
+    startTime(0) {
+    uint8_t *regs = dma->mmreg + channelOffset + id * channelSize;
+    head = (uint64_t *)regs;
+    completed = (uint32_t *)(regs + 8);
+    flags = (uint32_t *)(regs + 12);
+    size_t fifoSize = dma->bufferSize / 2;
+    memSideReadFifo = new StridedReadFifo(dma->dmaPort, fifoSize, dma->maxReqSize, dma->maxPending);
+    memSideWriteFifo = new DmaWriteFifo(dma->dmaPort, fifoSize, dma->maxReqSize, dma->maxPending);
+    accSideReadFifo = new StridedReadFifo(dma->accPort, fifoSize, dma->maxReqSize, dma->maxPending);
+    accSideWriteFifo = new DmaWriteFifo(dma->accPort, fifoSize, dma->maxReqSize, dma->maxPending);
+    memSideReadFifo->setWakeup([dma]{ dma->wakeup(); });
+    memSideWriteFifo->setWakeup([dma]{ dma->wakeup(); });
+    accSideReadFifo->setWakeup([dma]{ dma->wakeup(); });
+    accSideWriteFifo->setWakeup([dma]{ dma->wakeup(); });
+    readFifo = nullptr;
+    writeFifo = nullptr;
+}
+
+void
+DmaDescriptor::fromGuest() {
+    src = letoh(src);
+    dst = letoh(dst);
+    next = letoh(next);
+    len = letoh(len);
+    flags = letoh(flags);
+    rows = letoh(rows);
+    planes = letoh(planes);
+    srcRowStride = letoh(srcRowStride);
+    dstRowStride = letoh(dstRowStride);
+    srcPlaneStride = letoh(srcPlaneStride);
+    dstPlaneStride = letoh(dstPlaneStride);
+    elemSize = letoh(elemSize);
+}
+
+StridedBlock
+DmaDescriptor::srcBlock() const {
+    Addr elem = std::max(elemSize, 1u);
+    return StridedBlock(src, len * elem, rows, srcRowStride * elem,
+                        planes, srcPlaneStride * elem);
+}
+
+StridedBlock
+DmaDescriptor::dstBlock() const {
+    Addr elem = std::max(elemSize, 1u);
+    return StridedBlock(dst, len * elem, rows, dstRowStride * elem,
+                        planes, dstPlaneStride * elem);
+}
+
+StridedBlock
+NoncoherentDma::mmrBlock(Addr start, uint32_t row_stride, uint32_t plane_stride) const {
+    Addr elem = std::max(*ELEM_SIZE, 1u);
+    return StridedBlock(start, (uint32_t)*LEN * elem, *ROWS, row_stride * elem,
+                        *PLANES, plane_stride * elem);
 }
 
 AddrRangeList
@@ -43,59 +129,150 @@ NoncoherentDma::getAddrRanges() const
     return ranges;
 }
 
-// Select the appropriate DmaReadFifo based on which port holds
-// the active read address
-DmaReadFifo *
-NoncoherentDma::getActiveReadFifo() {
+// Check whether the cluster-side port reaches an address
+bool
+NoncoherentDma::onAccSide(Addr add) {
     AddrRangeList accPortRanges = accPort.getAddrRanges();
     for (auto range : accPortRanges) {
-        if (range.contains(activeSrc)) return accSideReadFifo;
+        if (range.contains(add)) return true;
     }
-    return memSideReadFifo;
+    return false;
+}
+
+// Select the appropriate read FIFO based on which port holds
+// the active read address
+StridedReadFifo *
+NoncoherentDma::getActiveReadFifo() {
+    return onAccSide(activeSrc) ? accSideReadFifo : memSideReadFifo;
 }
 
 // Select the appropriate DmaWriteFifo based on which port holds
 // the active write address
 DmaWriteFifo *
 NoncoherentDma::getActiveWriteFifo() {
-    AddrRangeList accPortRanges = accPort.getAddrRanges();
-    for (auto range : accPortRanges) {
-        if (range.contains(activeDst)) return accSideWriteFifo;
+    return onAccSide(activeDst) ? accSideWriteFifo : memSideWriteFifo;
+}
+
+void
+NoncoherentDma::clearInterrupt() {
+    if ((*FLAGS&0x04)==0x04) return;
+    for (auto &ch : channels) {
+        if ((*ch->flags&0x04)==0x04) return;
+    }
+    gic->clearInt(intNum);
+}
+
+void
+NoncoherentDma::fetchDescriptor(Channel &ch) {
+    DPRINTF(NoncoherentDma, "Channel %d fetching descriptor at 0x%016x\n", ch.id, ch.next);
+    ch.state = Channel::Fetching;
+    DmaPort &port = onAccSide(ch.next) ? accPort : dmaPort;
+    port.dmaAction(MemCmd::ReadReq, ch.next, sizeof(DmaDescriptor), &ch.fetchEvent,
+                   ch.descData, 0);
+}
+
+void
+NoncoherentDma::descriptorFetched(Channel &ch) {
+    std::memcpy(&ch.desc, ch.descData, sizeof(DmaDescriptor));
+    ch.desc.fromGuest();
+    DPRINTF(NoncoherentDma, "Channel %d SRC:0x%016x, DST:0x%016x, LEN:%d, ROWS:%d, PLANES:%d\n",
+            ch.id, ch.desc.src, ch.desc.dst, ch.desc.len, ch.desc.rows, ch.desc.planes);
+    ch.state = Channel::Transferring;
+    ch.startTime = curTick();
+    // A descriptor stays on one side of the cluster for each direction
+    ch.readFifo = onAccSide(ch.desc.src) ? ch.accSideReadFifo : ch.memSideReadFifo;
+    ch.writeFifo = onAccSide(ch.desc.dst) ? ch.accSideWriteFifo : ch.memSideWriteFifo;
+    StridedBlock srcBlock = ch.desc.srcBlock();
+    ch.writesLeft = srcBlock.size();
+    ch.readFifo->startFill(srcBlock);
+    ch.writeFifo->startEmpty(ch.desc.dstBlock());
+    wakeup();
+}
+
+bool
+NoncoherentDma::tickChannel(Channel &ch) {
+    if ((ch.state == Channel::Idle) && ((*ch.flags&0x01)==0x01)) {
+        *ch.flags &= ~0x01u;
+        *ch.flags |= 0x02;
+        ch.next = *ch.head;
+        if (ch.next) fetchDescriptor(ch);
+        else *ch.flags &= ~0x02u;
+    }
+    if (((ch.lastFlags&0x04)==0x04) && ((*ch.flags&0x04) != 0x04)) {
+        clearInterrupt();
+    }
+    bool progress = false;
+    if (ch.state == Channel::Transferring) {
+        if (ch.writesLeft > 0) {
+            progress = moveData(ch.readFifo, ch.writeFifo, ch.writesLeft);
+        } else if (!ch.writeFifo->isActive()) {
+            (*ch.completed)++;
+            double xfer_time = (double)(curTick() - ch.startTime) * (1e-6);
+            DPRINTF(NoncoherentDma, "Channel %d descriptor completed in %f us\n", ch.id, xfer_time);
+            if (ch.desc.flags & DmaDescriptor::IntOnComplete) {
+                *ch.flags |= 0x04;
+                gic->sendInt(intNum);
+            }
+            ch.state = Channel::Idle;
+            ch.next = ch.desc.next;
+            if (ch.next) fetchDescriptor(ch);
+            else *ch.flags &= ~0x02u;
+        }
+    }
+    ch.lastFlags = *ch.flags;
+    return progress;
+}
+
+void
+NoncoherentDma::wakeup() {
+    if (!tickEvent.scheduled()) {
+        schedule(tickEvent, curTick() + clock_period*1000);
     }
-    return memSideWriteFifo;
+}
+
+// Move one request worth of data from a read FIFO to a write FIFO. Returns
+// true if the transfer can progress again on the next cycle, otherwise the
+// engine sleeps until a FIFO response or an MMR write wakes it up.
+bool
+NoncoherentDma::moveData(StridedReadFifo *rd, DmaWriteFifo *wr, uint64_t &left) {
+    unsigned toWrite = MIN((uint64_t)maxReqSize, left);
+    if (wr->canFill(toWrite) && rd->tryGet(moveBuffer.data(), toWrite)) {
+        wr->fill(moveBuffer.data(), toWrite);
+        left -= toWrite;
+        dmaStats.bytes += toWrite;
+    }
+    if (left == 0) return !wr->isActive();
+    toWrite = MIN((uint64_t)maxReqSize, left);
+    return wr->canFill(toWrite) && (rd->size() >= toWrite);
 }
 
 void
 NoncoherentDma::tick() {
+    dmaStats.tickEvents++;
+    bool progress = false;
     if (!running && ((*FLAGS&0x01)==0x01)) {
         running = true;
         *FLAGS &= 0xFE;
         *FLAGS |= 0x02;
         activeSrc = *SRC;
         activeDst = *DST;
-        writesLeft = *LEN;
-        DPRINTF(NoncoherentDma, "SRC:0x%016x, DST:0x%016x, LEN:%d\n", activeSrc, activeDst, writesLeft);
+        StridedBlock srcBlock = mmrBlock(activeSrc, *SRC_ROW_STRIDE, *SRC_PLANE_STRIDE);
+        writesLeft = srcBlock.size();
+        DPRINTF(NoncoherentDma, "SRC:0x%016x, DST:0x%016x, LEN:%d, ROWS:%d, PLANES:%d\n",
+                activeSrc, activeDst, *LEN, *ROWS, *PLANES);
         start_time = curTick();
         readFifo = getActiveReadFifo();
         writeFifo = getActiveWriteFifo();
-        readFifo->startFill(activeSrc, writesLeft);
-        writeFifo->startEmpty(activeDst, writesLeft);
+        readFifo->startFill(srcBlock);
+        writeFifo->startEmpty(mmrBlock(activeDst, *DST_ROW_STRIDE, *DST_PLANE_STRIDE));
     }
     if (((last_flag&0x04)==0x04) && ((*FLAGS&0x04) != 0x04)) {
         //clear interrupts
-        gic->clearInt(intNum);
+        clearInterrupt();
     }
     if (running) {
         if (writesLeft > 0) {
-            int toWrite = MIN(maxReqSize, writesLeft);
-            if (writeFifo->canFill(toWrite)) {
-                uint8_t * data = new uint8_t[toWrite];
-                if (readFifo->tryGet(data, toWrite)) {
-                    writeFifo->fill(data, toWrite);
-                    writesLeft -= toWrite;
-                }
-                delete[] data;
-            }
+            progress = moveData(readFifo, writeFifo, writesLeft);
         } else {
             if (!writeFifo->isActive()) {
                 running = false;
@@ -109,9 +286,10 @@ NoncoherentDma::tick() {
         }
     }
 	last_flag = *FLAGS;
-    if (!tickEvent.scheduled() && running) {
-        schedule(tickEvent, curTick() + clock_period*1000);
+    for (auto &ch : channels) {
+        progress |= tickChannel(*ch);
     }
+    if (progress) wakeup();
 }
 
 Tick
@@ -157,13 +335,24 @@ NoncoherentDma::write(PacketPtr pkt) {
 
     pkt->writeData(mmreg + (pkt->req->getPaddr() - pioAddr));
 
-    if (!tickEvent.scheduled()) {
-        schedule(tickEvent, curTick() + clock_period*1000);
-    }
+    wakeup();
     pkt->makeAtomicResponse();
     return pioDelay;
 }
 
+NoncoherentDma::DmaStats::DmaStats(NoncoherentDma &dma)
+    : statistics::Group(&dma, "engine"),
+    ADD_STAT(tickEvents, statistics::units::Count::get(),
+             "Number of engine tick events processed"),
+    ADD_STAT(bytes, statistics::units::Byte::get(),
+             "Number of bytes moved from read to write FIFOs"),
+    ADD_STAT(eventsPerByte, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Byte>::get(),
+             "Engine tick events per byte transferred",
+             tickEvents / bytes)
+{
+}
+
 Port &
 NoncoherentDma::getPort(const std::string &if_name, PortID idx)
 {
@@ -5,24 +5,77 @@
 #include "dev/dma_device.hh"
 #include "hwacc/LLVMRead/src/debug_flags.hh"
 #include "hwacc/dma_write_fifo.hh"
+#include "hwacc/strided_read_fifo.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
+#include "base/statistics.hh"
+#include "sim/byteswap.hh"
 #include "params/NoncoherentDma.hh"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 //------------------------------------------
 //    Memory Map
 //    |  Length  | Dst Addr | Src Addr | Flags  |
 //    |----------|----------|----------|--------|
 //    |  4 Bytes | 8 Bytes  | 8 Bytes  | 1 Byte |
+//
+//    Strided Transfer, at offset 24
+//    | Dst Plane Stride | Src Plane Stride | Dst Row Stride | Src Row Stride | Planes  | Rows    | Elem Size |
+//    |------------------|------------------|----------------|----------------|---------|---------|-----------|
+//    |     4 Bytes      |     4 Bytes      |    4 Bytes     |    4 Bytes     | 4 Bytes | 4 Bytes |  4 Bytes  |
+//
+//    Length is the row length, and the length and strides count elements
+//    of Elem Size bytes. Zero sizes and counts mean 1, so a pio_size of
+//    21 keeps plain contiguous transfers in bytes.
+//
+//    Descriptor Channel N, at offset 56 + 16*N
+//    | Desc Head | Completed | Flags   |
+//    |-----------|-----------|---------|
+//    |  8 Bytes  |  4 Bytes  | 4 Bytes |
 //------------------------------------------//
 
+/**
+ * Transfer descriptor fetched from memory by a descriptor channel. It moves
+ * planes * rows rows of len elements each, with the rows and planes of the
+ * source and destination placed by their strides. Lengths and strides count
+ * elements of elemSize bytes. Element sizes, rows and planes of 0 count as 1.
+ * The channel follows next until it reaches a null pointer.
+ */
+struct DmaDescriptor
+{
+    uint64_t src;
+    uint64_t dst;
+    uint64_t next;
+    uint32_t len;
+    uint32_t flags;
+    uint32_t rows;
+    uint32_t planes;
+    uint32_t srcRowStride;
+    uint32_t dstRowStride;
+    uint32_t srcPlaneStride;
+    uint32_t dstPlaneStride;
+    uint32_t elemSize;
+    uint32_t reserved;
+
+    // Raise the DMA interrupt once this descriptor completes
+    static const uint32_t IntOnComplete = 0x1;
+
+    void fromGuest();
+    StridedBlock srcBlock() const;
+    StridedBlock dstBlock() const;
+};
+static_assert(sizeof(DmaDescriptor) == 64, "Descriptors are one 64 byte line");
+
 class NoncoherentDma : public DmaDevice
 {
   private:
     std::string devname;
-    DmaReadFifo *memSideReadFifo;
-    DmaReadFifo *accSideReadFifo;
-    DmaReadFifo *readFifo;
+    StridedReadFifo *memSideReadFifo;
+    StridedReadFifo *accSideReadFifo;
+    StridedReadFifo *readFifo;
     DmaWriteFifo *memSideWriteFifo;
     DmaWriteFifo *accSideWriteFifo;
     DmaWriteFifo *writeFifo;
@@ -41,21 +94,96 @@ class NoncoherentDma : public DmaDevice
     uint64_t * SRC;
     uint64_t * DST;
     int * LEN;
+    uint32_t * ELEM_SIZE;
+    uint32_t * ROWS;
+    uint32_t * PLANES;
+    uint32_t * SRC_ROW_STRIDE;
+    uint32_t * DST_ROW_STRIDE;
+    uint32_t * SRC_PLANE_STRIDE;
+    uint32_t * DST_PLANE_STRIDE;
 
     uint8_t last_flag;
 
     Addr activeSrc;
     Addr activeDst;
-    int writesLeft;
+    uint64_t writesLeft;
     bool running;
 
     Tick start_time;
 
     EventFunctionWrapper tickEvent;
 
+    /**
+     * A descriptor channel walks a linked chain of descriptors on its own
+     * FIFOs, independently of the MMR transfer and of the other channels.
+     */
+    struct Channel
+    {
+        enum State { Idle, Fetching, Transferring };
+
+        Channel(NoncoherentDma *dma, unsigned id);
+
+        unsigned id;
+        State state;
+        uint64_t *head;
+        uint32_t *completed;
+        uint32_t *flags;
+        uint32_t lastFlags;
+
+        Addr next;
+        DmaDescriptor desc;
+        uint8_t descData[sizeof(DmaDescriptor)];
+        EventFunctionWrapper fetchEvent;
+
+        uint64_t writesLeft;
+        Tick startTime;
+
+        StridedReadFifo *memSideReadFifo;
+        StridedReadFifo *accSideReadFifo;
+        StridedReadFifo *readFifo;
+        DmaWriteFifo *memSideWriteFifo;
+        DmaWriteFifo *accSideWriteFifo;
+        DmaWriteFifo *writeFifo;
+    };
+    std::vector<std::unique_ptr<Channel>> channels;
+
+    static const Addr stridedOffset = 24;
+    static const Addr channelOffset = 56;
+    static const Addr channelSize = 16;
+
+    // Block of the MMR transfer starting at start, placed by its strides
+    StridedBlock mmrBlock(Addr start, uint32_t row_stride, uint32_t plane_stride) const;
+
+    void fetchDescriptor(Channel &ch);
+    void descriptorFetched(Channel &ch);
+    // Returns true if the channel can progress on the next cycle
+    bool tickChannel(Channel &ch);
+    // Clear the interrupt once no transfer has one pending
+    void clearInterrupt();
+
+    // Scratch space for moving data between FIFOs
+    std::vector<uint8_t> moveBuffer;
+
+    bool moveData(StridedReadFifo *rd, DmaWriteFifo *wr, uint64_t &left);
+    // Schedule a tick unless one is pending. The engine only ticks after
+    // MMR writes, FIFO responses and descriptor fetches, and while data
+    // can move every cycle.
+    void wakeup();
+
   protected:
     DmaPort accPort;
-    DmaReadFifo * getActiveReadFifo();
+
+    struct DmaStats : public statistics::Group
+    {
+        DmaStats(NoncoherentDma &dma);
+
+        statistics::Scalar tickEvents;
+        statistics::Scalar bytes;
+        statistics::Formula eventsPerByte;
+    } dmaStats;
+
+    bool onAccSide(Addr add);
+    StridedReadFifo * getActiveReadFifo();
     DmaWriteFifo * getActiveWriteFifo();
   public:
     PARAMS(NoncoherentDma);
@@ -0,0 +1,138 @@
+#ifndef __HWACC_PORT_ROUTE_TABLE_HH__
+#define __HWACC_PORT_ROUTE_TABLE_HH__
+
+#include "base/addr_range.hh"
+#include "base/addr_range_map.hh"
+#include "base/logging.hh"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * Routes an address to the ports that can reach it. Every port is added with
+ * a kind, and where ranges of different kinds overlap the lowest kind wins,
+ * matching the order in which CommInterface used to probe its port lists.
+ *
+ * Plain ranges are split at every range boundary so each entry of the map
+ * holds the winning kind and all of its ports for that piece of the address
+ * space. Interleaved ranges are inserted as they are and must not overlap
+ * any other range. Lookups binary search a flat copy of the plain entries,
+ * which avoids the per-lookup allocations of AddrRangeMap::contains, and
+ * only fall back to the map for interleaved ranges.
+ */
+template <class Port>
+class PortRouteTable
+{
+  public:
+    struct Route
+    {
+        unsigned kind;
+        std::vector<Port *> ports;
+    };
+
+  private:
+    struct Entry
+    {
+        unsigned kind;
+        Port *port;
+        gem5::AddrRange range;
+    };
+    std::vector<Entry> entries;
+    gem5::AddrRangeMap<Route> routes;
+
+    struct Span
+    {
+        gem5::Addr start;
+        gem5::Addr end;
+        const Route *route;
+    };
+    std::vector<Span> spans;
+    bool interleaved = false;
+
+  public:
+    void
+    clear()
+    {
+        entries.clear();
+        routes.clear();
+        spans.clear();
+        interleaved = false;
+    }
+
+    void
+    add(unsigned kind, Port *port, const gem5::AddrRangeList &ranges)
+    {
+        for (auto &range : ranges) {
+            if (range.valid() && range.size()) entries.push_back({kind, port, range});
+        }
+    }
+
+    void
+    build()
+    {
+        routes.clear();
+        spans.clear();
+        interleaved = false;
+        std::vector<gem5::Addr> bounds;
+        for (auto &entry : entries) {
+            if (entry.range.interleaved()) continue;
+            bounds.push_back(entry.range.start());
+            bounds.push_back(entry.range.end());
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        for (size_t i = 0; i + 1 < bounds.size(); i++) {
+            // Plain ranges either cover the whole piece or none of it
+            Route route = {0, {}};
+            for (auto &entry : entries) {
+                if (entry.range.interleaved() || !entry.range.contains(bounds[i]))
+                    continue;
+                if (route.ports.empty() || (entry.kind < route.kind)) {
+                    route.kind = entry.kind;
+                    route.ports.clear();
+                }
+                if ((entry.kind == route.kind) &&
+                    (std::find(route.ports.begin(), route.ports.end(), entry.port) ==
+                     route.ports.end())) route.ports.push_back(entry.port);
+            }
+            if (!route.ports.empty())
+                routes.insert(gem5::AddrRange(bounds[i], bounds[i + 1]), route);
+        }
+
+        for (auto &entry : entries) {
+            if (!entry.range.interleaved()) continue;
+            auto it = routes.intersects(entry.range);
+            if (it != routes.end() && it->first == entry.range &&
+                it->second.kind == entry.kind) {
+                it->second.ports.push_back(entry.port);
+                continue;
+            }
+            fatal_if(it != routes.end(), "Interleaved range %s overlaps range %s\n",
+                     entry.range.to_string(), it->first.to_string());
+            routes.insert(entry.range, {entry.kind, {entry.port}});
+        }
+
+        // The map orders plain ranges by start address
+        for (auto &route : routes) {
+            if (route.first.interleaved()) interleaved = true;
+            else spans.push_back({route.first.start(), route.first.end(), &route.second});
+        }
+    }
+
+    // Returns nullptr if no port reaches the address
+    const Route *
+    find(gem5::Addr add) const
+    {
+        auto span = std::upper_bound(spans.begin(), spans.end(), add,
+            [](gem5::Addr a, const Span &s) { return a < s.start; });
+        if ((span != spans.begin()) && (add < (--span)->end)) return span->route;
+        if (!interleaved) return nullptr;
+        auto it = routes.contains(add);
+        return (it == routes.end()) ? nullptr : &(it->second);
+    }
+
+    size_t size() const { return routes.size(); }
+};
+
+#endif //__HWACC_PORT_ROUTE_TABLE_HH__
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "hwacc/port_route_table.hh"
+
+/*
+ * Checks PortRouteTable against the linear range scans CommInterface used to
+ * route requests, and benchmarks both on cluster configurations with many SPM
+ * ports. Port kinds follow CommInterface: 0 reg, 1 stream, 2 SPM, 3 local and
+ * 4 global.
+ */
+
+using namespace gem5;
+
+namespace
+{
+
+struct FakePort
+{
+    unsigned kind;
+    AddrRangeList ranges;
+
+    // Like RequestPort, hand out a copy of the peer's ranges
+    AddrRangeList getAddrRanges() const { return ranges; }
+};
+
+typedef PortRouteTable<FakePort>::Route Route;
+
+// Original algorithm: probe each kind in priority order, then scan its ports
+struct LinearRouter
+{
+    std::vector<std::vector<FakePort *>> kinds;
+
+    LinearRouter() : kinds(5) { }
+    void add(FakePort *port) { kinds[port->kind].push_back(port); }
+
+    bool
+    inRange(unsigned kind, Addr add) const
+    {
+        for (auto port : kinds[kind]) {
+            AddrRangeList adl = port->getAddrRanges();
+            for (auto &range : adl) {
+                if (range.contains(add)) return true;
+            }
+        }
+        return false;
+    }
+
+    FakePort *
+    find(Addr add) const
+    {
+        for (unsigned kind = 0; kind < kinds.size(); kind++) {
+            if (!inRange(kind, add)) continue;
+            for (auto port : kinds[kind]) {
+                AddrRangeList adl = port->getAddrRanges();
+                for (auto &range : adl) {
+                    if (range.contains(add)) return port;
+                }
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * A cluster with numSPMs scratchpads reached through portsPerSPM ports each,
+ * a register bank, a stream buffer, and local and global buses. The local
+ * bus range overlaps the SPMs, as a cluster xbar does.
+ */
+struct Cluster
+{
+    std::vector<FakePort> ports;
+    PortRouteTable<FakePort> table;
+    LinearRouter linear;
+
+    static constexpr Addr spmBase = 0x10020000;
+    static constexpr Addr spmSize = 0x4000;
+
+    Cluster(unsigned numSPMs, unsigned portsPerSPM)
+    {
+        ports.push_back({0, {RangeSize(0x10000000, 0x100)}});
+        ports.push_back({1, {RangeSize(0x10010000, 0x40)}});
+        for (unsigned spm = 0; spm < numSPMs; spm++) {
+            for (unsigned p = 0; p < portsPerSPM; p++)
+                ports.push_back({2, {RangeSize(spmBase + spm * spmSize, spmSize)}});
+        }
+        ports.push_back({3, {RangeSize(0x10000000, 0x1000000)}});
+        ports.push_back({4, {RangeSize(0x80000000, 0x40000000)}});
+        for (auto &port : ports) {
+            table.add(port.kind, &port, port.ranges);
+            linear.add(&port);
+        }
+        table.build();
+    }
+};
+
+} // anonymous namespace
+
+TEST(PortRouteTable, PriorityAndOverlap)
+{
+    Cluster cluster(4, 2);
+
+    // Register range wins over the overlapping local bus
+    const Route *route = cluster.table.find(0x10000010);
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->kind, 0u);
+
+    // Both ports of the second SPM, and only those
+    route = cluster.table.find(Cluster::spmBase + Cluster::spmSize + 8);
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->kind, 2u);
+    ASSERT_EQ(route->ports.size(), 2u);
+    for (auto port : route->ports) {
+        EXPECT_TRUE(port->ranges.front().contains(Cluster::spmBase + Cluster::spmSize));
+    }
+
+    // Gaps between the SPMs fall back to the local bus
+    route = cluster.table.find(0x10000100);
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->kind, 3u);
+
+    route = cluster.table.find(0x90000000);
+    ASSERT_NE(route, nullptr);
+    EXPECT_EQ(route->kind, 4u);
+
+    EXPECT_EQ(cluster.table.find(0x20000000), nullptr);
+}
+
+TEST(PortRouteTable, MatchesLinearScan)
+{
+    Cluster cluster(32, 2);
+    std::mt19937_64 rng(12345);
+    for (int i = 0; i < 100000; i++) {
+        Addr add = 0x0fff0000 + rng() % 0x1100000;
+        if (rng() % 4 == 0) add = 0x7fff0000 + rng() % 0x40020000;
+        FakePort *expected = cluster.linear.find(add);
+        const Route *route = cluster.table.find(add);
+        if (!expected) {
+            ASSERT_EQ(route, nullptr) << std::hex << add;
+            continue;
+        }
+        ASSERT_NE(route, nullptr) << std::hex << add;
+        ASSERT_EQ(route->kind, expected->kind) << std::hex << add;
+        // The first free port of the route is the one the scan returned
+        ASSERT_EQ(route->ports.front(), expected) << std::hex << add;
+    }
+}
+
+TEST(PortRouteTable, RoutingMicrobenchmark)
+{
+    for (unsigned numSPMs : {8, 16, 32}) {
+        Cluster cluster(numSPMs, 4);
+        const size_t lookups = 200000;
+        std::mt19937_64 rng(1);
+        std::vector<Addr> addrs(lookups);
+        for (auto &add : addrs)
+            add = Cluster::spmBase + rng() % (numSPMs * Cluster::spmSize);
+
+        size_t linearHits = 0;
+        auto linearStart = std::chrono::high_resolution_clock::now();
+        for (auto add : addrs) linearHits += (cluster.linear.find(add) != nullptr);
+        auto linearStop = std::chrono::high_resolution_clock::now();
+
+        size_t tableHits = 0;
+        auto tableStart = std::chrono::high_resolution_clock::now();
+        for (auto add : addrs) tableHits += !cluster.table.find(add)->ports.empty();
+        auto tableStop = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double, std::nano> linearTime = linearStop - linearStart;
+        std::chrono::duration<double, std::nano> tableTime = tableStop - tableStart;
+        std::cout << "SPM Ports: " << numSPMs * 4
+                  << "   Linear Scan: " << linearTime.count() / lookups << " ns/lookup"
+                  << "   Route Table: " << tableTime.count() / lookups << " ns/lookup"
+                  << std::endl;
+        EXPECT_EQ(linearHits, lookups);
+        EXPECT_EQ(tableHits, lookups);
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef __HWACC_READY_BITMAP_HH__
+#define __HWACC_READY_BITMAP_HH__
+
+#include "base/bitfield.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * One ready bit per scratchpad byte, packed into 64-bit words. Range
+ * operations touch each covered word once with a mask, so an access costs
+ * a word operation per 64 bytes instead of a loop over every byte.
+ */
+class ReadyBitmap
+{
+  private:
+    std::vector<uint64_t> words;
+    size_t bits = 0;
+
+    static constexpr size_t wordBits = 64;
+
+    // Bits [lo, hi) of a word, with 0 <= lo < hi <= 64
+    static uint64_t
+    wordMask(size_t lo, size_t hi)
+    {
+        uint64_t upper = (hi == wordBits) ? ~0ULL : ((1ULL << hi) - 1);
+        return upper & ~((1ULL << lo) - 1);
+    }
+
+    /**
+     * Call op(word, mask) for each word covering [start, start + len),
+     * stopping early when op returns false.
+     *
+     * @return false if op stopped the walk
+     */
+    template <class Words, class Op>
+    static bool
+    forRange(Words &words, size_t start, size_t len, Op op)
+    {
+        if (len == 0) return true;
+        size_t end = start + len;
+        size_t first = start / wordBits;
+        size_t last = (end - 1) / wordBits;
+        for (size_t w = first; w <= last; w++) {
+            size_t lo = (w == first) ? (start % wordBits) : 0;
+            size_t hi = (w == last) ? ((end - 1) % wordBits + 1) : wordBits;
+            if (!op(words[w], wordMask(lo, hi))) return false;
+        }
+        return true;
+    }
+
+  public:
+    ReadyBitmap(size_t size=0) { resize(size); }
+
+    void
+    resize(size_t size)
+    {
+        bits = size;
+        words.assign((size + wordBits - 1) / wordBits, 0);
+    }
+
+    size_t size() const { return bits; }
+
+    void
+    setAll(bool ready)
+    {
+        std::fill(words.begin(), words.end(), ready ? ~0ULL : 0ULL);
+        // Keep the bits past the end clear so count() stays exact
+        if (ready && (bits % wordBits))
+            words.back() &= wordMask(0, bits % wordBits);
+    }
+
+    void
+    set(size_t start, size_t len)
+    {
+        assert(start + len <= bits);
+        forRange(words, start, len,
+                 [](uint64_t &word, uint64_t mask) { word |= mask; return true; });
+    }
+
+    void
+    clear(size_t start, size_t len)
+    {
+        assert(start + len <= bits);
+        forRange(words, start, len,
+                 [](uint64_t &word, uint64_t mask) { word &= ~mask; return true; });
+    }
+
+    // True if every byte in the range is ready
+    bool
+    allSet(size_t start, size_t len) const
+    {
+        assert(start + len <= bits);
+        return forRange(words, start, len,
+                        [](uint64_t word, uint64_t mask) { return (word & mask) == mask; });
+    }
+
+    // True if no byte in the range is ready
+    bool
+    noneSet(size_t start, size_t len) const
+    {
+        assert(start + len <= bits);
+        return forRange(words, start, len,
+                        [](uint64_t word, uint64_t mask) { return (word & mask) == 0; });
+    }
+
+    bool test(size_t pos) const { return allSet(pos, 1); }
+
+    // Number of ready bytes in the range
+    size_t
+    count(size_t start, size_t len) const
+    {
+        assert(start + len <= bits);
+        size_t ready = 0;
+        forRange(words, start, len,
+                 [&ready](uint64_t word, uint64_t mask) {
+                     ready += gem5::popCount(word & mask);
+                     return true;
+                 });
+        return ready;
+    }
+
+    size_t count() const { return count(0, bits); }
+};
+
+#endif //__HWACC_READY_BITMAP_HH__
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "hwacc/ready_bitmap.hh"
+
+/*
+ * Correctness checks for ReadyBitmap against a byte-per-entry reference, and
+ * a microbenchmark comparing it to the bool array loops ScratchpadMemory used
+ * for its readyMode checks. The benchmark replays the access pattern of a
+ * readyMode SPM: a producer writes each line, a consumer validates and reads
+ * it back, and the whole SPM is periodically reset.
+ */
+
+namespace
+{
+
+// Original algorithm: one bool per byte
+struct BoolReady
+{
+    std::unique_ptr<bool[]> ready;
+    size_t size;
+
+    BoolReady(size_t _size) : ready(new bool[_size]()), size(_size) { }
+    void set(size_t start, size_t len, bool r) {
+        for (size_t i = start; i < start + len; i++) ready[i] = r;
+    }
+    bool allSet(size_t start, size_t len) const {
+        for (size_t i = start; i < start + len; i++)
+            if (ready[i] == false) return false;
+        return true;
+    }
+    bool noneSet(size_t start, size_t len) const {
+        for (size_t i = start; i < start + len; i++)
+            if (ready[i] == true) return false;
+        return true;
+    }
+    void setAll(bool r) {
+        for (size_t i = 0; i < size; i++) ready[i] = r;
+    }
+};
+
+} // anonymous namespace
+
+TEST(ReadyBitmap, RangeOperations)
+{
+    ReadyBitmap ready(200);
+    EXPECT_EQ(ready.size(), 200u);
+    EXPECT_TRUE(ready.noneSet(0, 200));
+    EXPECT_EQ(ready.count(), 0u);
+
+    // A range crossing two word boundaries
+    ready.set(60, 80);
+    EXPECT_TRUE(ready.allSet(60, 80));
+    EXPECT_FALSE(ready.allSet(59, 2));
+    EXPECT_FALSE(ready.allSet(139, 2));
+    EXPECT_TRUE(ready.noneSet(0, 60));
+    EXPECT_TRUE(ready.noneSet(140, 60));
+    EXPECT_EQ(ready.count(), 80u);
+    EXPECT_EQ(ready.count(64, 64), 64u);
+
+    ready.clear(100, 8);
+    EXPECT_FALSE(ready.test(100));
+    EXPECT_TRUE(ready.test(99));
+    EXPECT_TRUE(ready.test(108));
+    EXPECT_EQ(ready.count(), 72u);
+
+    // Empty ranges are trivially satisfied
+    EXPECT_TRUE(ready.allSet(0, 0));
+    EXPECT_TRUE(ready.noneSet(64, 0));
+}
+
+TEST(ReadyBitmap, SetAllKeepsTail)
+{
+    ReadyBitmap ready(70);
+    ready.setAll(true);
+    EXPECT_TRUE(ready.allSet(0, 70));
+    EXPECT_EQ(ready.count(), 70u);
+    ready.setAll(false);
+    EXPECT_TRUE(ready.noneSet(0, 70));
+    EXPECT_EQ(ready.count(), 0u);
+}
+
+TEST(ReadyBitmap, MatchesBoolArray)
+{
+    const size_t size = 4096;
+    ReadyBitmap ready(size);
+    BoolReady reference(size);
+    std::mt19937_64 rng(12345);
+
+    for (int i = 0; i < 20000; i++) {
+        size_t len = rng() % 130;
+        size_t start = rng() % (size - len);
+        switch (rng() % 5) {
+          case 0: ready.set(start, len); reference.set(start, len, true); break;
+          case 1: ready.clear(start, len); reference.set(start, len, false); break;
+          case 2: ASSERT_EQ(ready.allSet(start, len), reference.allSet(start, len)); break;
+          case 3: ASSERT_EQ(ready.noneSet(start, len), reference.noneSet(start, len)); break;
+          case 4:
+            if (rng() % 64 == 0) {
+                bool r = rng() % 2;
+                ready.setAll(r);
+                reference.setAll(r);
+            }
+            break;
+        }
+    }
+}
+
+TEST(ReadyBitmap, ReadyModeMicrobenchmark)
+{
+    const size_t size = 4 * 1024 * 1024;
+    const int resets = 4;
+    for (size_t line : {4, 8, 64}) {
+        const size_t accesses = (size / line) * resets;
+
+        BoolReady reference(size);
+        size_t refHits = 0;
+        auto boolStart = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < resets; r++) {
+            reference.setAll(false);
+            for (size_t addr = 0; addr < size; addr += line) {
+                if (reference.noneSet(addr, line)) reference.set(addr, line, true);
+                if (reference.allSet(addr, line)) {
+                    reference.set(addr, line, false);
+                    refHits++;
+                }
+            }
+        }
+        auto boolStop = std::chrono::high_resolution_clock::now();
+
+        ReadyBitmap ready(size);
+        size_t hits = 0;
+        auto bitmapStart = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < resets; r++) {
+            ready.setAll(false);
+            for (size_t addr = 0; addr < size; addr += line) {
+                if (ready.noneSet(addr, line)) ready.set(addr, line);
+                if (ready.allSet(addr, line)) {
+                    ready.clear(addr, line);
+                    hits++;
+                }
+            }
+        }
+        auto bitmapStop = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double, std::nano> boolTime = boolStop - boolStart;
+        std::chrono::duration<double, std::nano> bitmapTime = bitmapStop - bitmapStart;
+        std::cout << "Access Size: " << line << "B"
+                  << "   Bool Array: " << boolTime.count() / accesses << " ns/access"
+                  << "   Bitmap: " << bitmapTime.count() / accesses << " ns/access"
+                  << std::endl;
+        EXPECT_EQ(hits, refHits);
+        EXPECT_EQ(hits, accesses);
+    }
+}
@@ -26,7 +26,11 @@ RegisterBank::RegisterBank(const RegisterBankParams &p) :
     deltaTime(p.delta_time),
     retryResp(false),
     dequeueEvent([this]{ dequeue(); }, name()),
-    deltaEvent([this]{ delta(); }, name())
+    deltaEvent([this]{ delta(); }, name()),
+    cacti(p.cacti),
+    cactiWordSize(p.cacti_word_size),
+    cactiCache(p.cacti_cache),
+    power(this)
 {
     // Setup of the delta memory container
     int shm_fd = -1;
@@ -79,6 +83,7 @@ RegisterBank::registerAccess(PacketPtr pkt)
         if (pmemAddr) {
             pkt->setData(hostAddr);
         }
+        power.access(true, pkt->getSize());
         stats.numReads[pkt->req->requestorId()]++;
         stats.bytesRead[pkt->req->requestorId()] += pkt->getSize();
     } else if (pkt->isWrite()) {
@@ -91,6 +96,7 @@ RegisterBank::registerAccess(PacketPtr pkt)
             }
             assert(!pkt->req->isInstFetch());
             TRACE_PACKET("Write");
+            power.access(false, pkt->getSize());
             stats.numWrites[pkt->req->requestorId()]++;
             stats.bytesWritten[pkt->req->requestorId()] += pkt->getSize();
             if (!deltaEvent.scheduled())
@@ -116,6 +122,15 @@ RegisterBank::init()
     if (load.isConnected()) {
         load.sendRangeChange();
     }
+
+    if (cacti) {
+        CactiConfig config;
+        config.size = range.size();
+        config.wordSize = cactiWordSize;
+        config.ports = 1;
+        config.type = 0;
+        power.configure(cactiEstimate(config, cactiCache), 1, cactiWordSize);
+    }
 }
 
 Tick
@@ -1,6 +1,7 @@
 #ifndef __HWACC_REGISTER_BANK_HH__
 #define __HWACC_REGISTER_BANK_HH__
 
+#include "hwacc/HWModeling/src/sram_power.hh"
 #include "mem/abstract_mem.hh"
 #include "mem/port.hh"
 #include "mem/tport.hh"
@@ -110,6 +111,15 @@ class RegisterBank : public AbstractMemory
     void delta();
     EventFunctionWrapper deltaEvent;
 
+    /**
+     * CACTI model of the registers as a single ported array. Estimates
+     * are memoized in cactiCache.
+     */
+    const bool cacti;
+    const unsigned cactiWordSize;
+    const std::string cactiCache;
+    SRAMPower power;
+
   public:
     DrainState drain() override;
 
@@ -0,0 +1,56 @@
+#ifndef __HWACC_SAMPLED_TIMER_HH__
+#define __HWACC_SAMPLED_TIMER_HH__
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Host time profiler for a code section that runs many times per simulated
+ * cycle. Only one in every period runs of the section reads the clock, and
+ * the measured time is scaled by the period, so profiling costs two clock
+ * reads per period runs instead of two per run. A period of 0 disables it.
+ */
+class SampledTimer
+{
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    uint32_t period;
+    uint32_t calls = 0;
+    bool sampled = false;
+    Clock::time_point begin;
+
+  public:
+    explicit SampledTimer(uint32_t _period=0) : period(_period) { }
+
+    void setPeriod(uint32_t _period) { period = _period; calls = 0; sampled = false; }
+    uint32_t getPeriod() const { return period; }
+    /** True between the start() and stop() of a sampled run */
+    bool isSampling() const { return sampled; }
+
+    /** Enter the section, the clock is read if this run is sampled */
+    void
+    start()
+    {
+        if (!period || (++calls < period)) return;
+        calls = 0;
+        sampled = true;
+        begin = Clock::now();
+    }
+
+    /**
+     * Leave the section.
+     *
+     * @return the estimated host seconds of the runs since the last sample,
+     *         0 if this run was not sampled
+     */
+    double
+    stop()
+    {
+        if (!sampled) return 0;
+        sampled = false;
+        return std::chrono::duration<double>(Clock::now() - begin).count() * period;
+    }
+};
+
+#endif //__HWACC_SAMPLED_TIMER_HH__
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include "hwacc/sampled_timer.hh"
+
+/*
+ * Checks that SampledTimer only measures one run per period.
+ */
+
+TEST(SampledTimerTest, Disabled)
+{
+    SampledTimer timer;
+    for (int i = 0; i < 100; i++) {
+        timer.start();
+        EXPECT_FALSE(timer.isSampling());
+        EXPECT_EQ(0, timer.stop());
+    }
+}
+
+TEST(SampledTimerTest, OneSamplePerPeriod)
+{
+    SampledTimer timer(4);
+    int samples = 0;
+    for (int i = 0; i < 40; i++) {
+        timer.start();
+        if (timer.isSampling()) samples++;
+        timer.stop();
+    }
+    EXPECT_EQ(10, samples);
+
+    // Changing the period restarts the count
+    timer.setPeriod(8);
+    samples = 0;
+    for (int i = 0; i < 40; i++) {
+        timer.start();
+        if (timer.isSampling()) samples++;
+        timer.stop();
+    }
+    EXPECT_EQ(5, samples);
+}
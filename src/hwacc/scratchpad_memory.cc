@@ -8,6 +8,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <iomanip>
 
 using namespace std;
@@ -30,13 +31,28 @@ ScratchpadMemory::ScratchpadMemory(const ScratchpadMemoryParams &p) :
     latency(p.latency),
     latency_var(p.latency_var),
     bandwidth(p.bandwidth),
-    dequeueEvent([this]{ dequeue(); }, name()) {
-    ready = new bool[range.size()];
-    if (readyMode) {
-        for (auto i=0;i<range.size();i++) {
-            ready[i] = false;
-        }
+    dequeueEvent([this]{ dequeue(); }, name()),
+    numBanks(p.num_banks),
+    bankPartition(p.bank_partition),
+    bankInterleave(p.bank_interleave),
+    bankReadPorts(p.bank_read_ports),
+    bankWritePorts(p.bank_write_ports),
+    bankCycle(p.bank_cycle),
+    bankSize(0),
+    banks(p.num_banks),
+    bankStats(*this),
+    cacti(p.cacti),
+    cactiWordSize(p.cacti_word_size),
+    cactiCache(p.cacti_cache),
+    power(this) {
+    if (numBanks) {
+        fatal_if(!bankReadPorts || !bankWritePorts,
+                 "%s: Each SPM bank needs at least one read and one write port\n", name());
+        fatal_if(!bankCycle, "%s: SPM bank cycle must be non-zero\n", name());
+        fatal_if(!bankInterleave, "%s: SPM bank interleave must be non-zero\n", name());
+        bankSize = divCeil(range.size(), numBanks);
     }
+    ready.resize(range.size());
     // Each port has its own release and dequeue events, as well as signals
     // Adding these events and signals for ".port"
     // const std::string releaseEventName = csprintf("%s_release[0]", name());
@@ -56,20 +72,12 @@ ScratchpadMemory::isReady(Addr ad, size_t size, bool read) {
         // We are reading. We can read if readOnInvalid or
         // if all segments are valid.
         if (readOnInvalid) return true;
-        Addr start_offset = ad - range.start();
-        Addr end_offset = start_offset + size;
-        for (auto i=start_offset; i<end_offset; i++) {
-            if (ready[i] == false) return false;
-        }
+        if (!ready.allSet(ad - range.start(), size)) return false;
     } else {
         // We are writing. We can write if writeOnValid or
         // if all segments are invalid.
         if (writeOnValid) return true;
-        Addr start_offset = ad - range.start();
-        Addr end_offset = start_offset + size;
-        for (auto i=start_offset; i<end_offset; i++) {
-            if (ready[i] == true) return false;
-        }
+        if (!ready.noneSet(ad - range.start(), size)) return false;
     }
     return true;
 }
@@ -77,13 +85,98 @@ ScratchpadMemory::isReady(Addr ad, size_t size, bool read) {
 void
 ScratchpadMemory::setAllReady(bool r) {
     if (readyMode && !initial){
-        for (auto i=0;i<range.size();i++) {
-            ready[i] = r;
-        }
+        ready.setAll(r);
     }
     initial = true;
 }
 
+unsigned
+ScratchpadMemory::bankOf(Addr offset) const
+{
+    if (bankPartition == SPMBankPartition::block)
+        return offset / bankSize;
+    return (offset / bankInterleave) % numBanks;
+}
+
+Addr
+ScratchpadMemory::nextBankBoundary(Addr offset) const
+{
+    Addr granule = (bankPartition == SPMBankPartition::block) ? bankSize : bankInterleave;
+    return (offset / granule + 1) * granule;
+}
+
+Tick
+ScratchpadMemory::reserveBanks(PacketPtr pkt)
+{
+    if (!numBanks) return 0;
+    bool read = pkt->isRead();
+    unsigned ports = read ? bankReadPorts : bankWritePorts;
+    Tick now = curTick() / bankCycle;
+    Tick served = now;
+
+    Addr start = pkt->getAddr() - range.start();
+    Addr end = start + pkt->getSize();
+    std::vector<unsigned> touched;
+    for (Addr offset = start; offset < end; offset = nextBankBoundary(offset)) {
+        unsigned bank = bankOf(offset);
+        if (!banks[bank].granules++) touched.push_back(bank);
+    }
+
+    for (unsigned bank : touched) {
+        unsigned granules = banks[bank].granules;
+        banks[bank].granules = 0;
+
+        BankSlot &slot = read ? banks[bank].read : banks[bank].write;
+        if (slot.cycle < now) {
+            slot.cycle = now;
+            slot.used = 0;
+        }
+        // Fill the ports left in the current cycle, then whole cycles
+        unsigned total = slot.used + granules;
+        slot.cycle += (total - 1) / ports;
+        slot.used = (total - 1) % ports + 1;
+
+        if (read) bankStats.reads[bank]++;
+        else bankStats.writes[bank]++;
+        if (slot.cycle > now) {
+            bankStats.conflicts[bank]++;
+            bankStats.conflictCycles[bank] += slot.cycle - now;
+            DPRINTF(MemoryAccess, "Bank %d conflict on %#x, served in %d cycles\n",
+                    bank, pkt->getAddr(), slot.cycle - now);
+        }
+        served = std::max(served, slot.cycle);
+    }
+    return (served - now) * bankCycle;
+}
+
+ScratchpadMemory::BankStats::BankStats(ScratchpadMemory &_spm)
+    : statistics::Group(&_spm, "banks"), spm(_spm),
+    ADD_STAT(reads, statistics::units::Count::get(),
+             "Number of reads served by each bank"),
+    ADD_STAT(writes, statistics::units::Count::get(),
+             "Number of writes served by each bank"),
+    ADD_STAT(conflicts, statistics::units::Count::get(),
+             "Number of accesses that waited for a free bank port"),
+    ADD_STAT(conflictCycles, statistics::units::Cycle::get(),
+             "Number of bank cycles spent waiting for a free bank port")
+{
+}
+
+void
+ScratchpadMemory::BankStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    // A disabled banking model reports nothing
+    unsigned banks = std::max(1u, spm.numBanks);
+    reads.init(banks).flags(total | nozero);
+    writes.init(banks).flags(total | nozero);
+    conflicts.init(banks).flags(total | nozero);
+    conflictCycles.init(banks).flags(total | nozero);
+}
+
 static inline void
 tracePacket(System *sys, const char *label, PacketPtr pkt)
 {
@@ -183,17 +276,14 @@ ScratchpadMemory::scratchpadAccess(PacketPtr pkt, bool validateAccess)
                 panic("Scratchpad read at address: 0x%lx is invalid! Sector has not been written yet!\n", pkt->getAddr());
             }
             if (resetOnScratchpadRead) {
-                Addr start_offset = pkt->getAddr() - range.start();
-                Addr end_offset = start_offset + pkt->getSize();
-                for (auto i=start_offset; i<end_offset; i++) {
-                    ready[i] = false;
-                }
+                ready.clear(pkt->getAddr() - range.start(), pkt->getSize());
             }
         }
         if (pmemAddr) {
             pkt->setData(hostAddr);
         }
         TRACE_PACKET(pkt->req->isInstFetch() ? "IFetch" : "Read");
+        power.access(true, pkt->getSize());
         stats.numReads[pkt->req->requestorId()]++;
         stats.bytesRead[pkt->req->requestorId()] += pkt->getSize();
         if (pkt->req->isInstFetch())
@@ -213,6 +303,7 @@ ScratchpadMemory::scratchpadAccess(PacketPtr pkt, bool validateAccess)
             }
             assert(!pkt->req->isInstFetch());
             TRACE_PACKET("Write");
+            power.access(false, pkt->getSize());
             stats.numWrites[pkt->req->requestorId()]++;
             stats.bytesWritten[pkt->req->requestorId()] += pkt->getSize();
         }
@@ -223,11 +314,7 @@ ScratchpadMemory::scratchpadAccess(PacketPtr pkt, bool validateAccess)
         }
         // Set ready bits on external writes
         if (readyMode) {
-            Addr start_offset = pkt->getAddr() - range.start();
-            Addr end_offset = start_offset + pkt->getSize();
-            for (auto i=start_offset; i<end_offset; i++) {
-                ready[i] = true;
-            }
+            ready.set(pkt->getAddr() - range.start(), pkt->getSize());
         }
     } else {
         panic("Unexpected packet %s", pkt->print());
@@ -247,6 +334,23 @@ ScratchpadMemory::init()
         port.sendRangeChange();
     }
     initial = true;
+
+    if (cacti) {
+        // The generic port and every SPM port reach the array, which CACTI
+        // models as read/write ports. Banks have their own ports
+        CactiConfig config;
+        config.wordSize = cactiWordSize;
+        config.type = 0;
+        if (numBanks) {
+            config.size = bankSize;
+            config.ports = std::max(bankReadPorts, bankWritePorts);
+        } else {
+            config.size = range.size();
+            config.ports = 1 + spm_ports.size();
+        }
+        power.configure(cactiEstimate(config, cactiCache),
+                        std::max(1u, numBanks), cactiWordSize);
+    }
 }
 
 Tick
@@ -336,6 +440,9 @@ ScratchpadMemory::recvTimingReq(PacketPtr pkt, PortID recvPort, bool validateAcc
         isBusy[idx] = true;
     }
 
+    // serialize on the bank ports before the access is performed
+    Tick bank_delay = reserveBanks(pkt);
+
     // go ahead and deal with the packet and put the response in the
     // queue if there is one
     bool needsResponse = pkt->needsResponse();
@@ -346,7 +453,7 @@ ScratchpadMemory::recvTimingReq(PacketPtr pkt, PortID recvPort, bool validateAcc
         // atomic response
         assert(pkt->isResponse());
 
-        Tick when_to_send = curTick() + receive_delay + getLatency();
+        Tick when_to_send = curTick() + receive_delay + bank_delay + getLatency();
 
         // typically this should be added at the end, so start the
         // insertion sort with the last element, also make sure not to
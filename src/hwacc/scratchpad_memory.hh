@@ -1,6 +1,9 @@
 #ifndef __HWACC_SCRATCHPAD_MEMORY_HH__
 #define __HWACC_SCRATCHPAD_MEMORY_HH__
 
+#include "base/statistics.hh"
+#include "hwacc/HWModeling/src/sram_power.hh"
+#include "hwacc/ready_bitmap.hh"
 #include "mem/abstract_mem.hh"
 #include "mem/port.hh"
 
@@ -67,7 +70,8 @@ class ScratchpadMemory : public AbstractMemory
     bool writeOnValid;
     bool resetOnScratchpadRead;
     bool initial;
-    bool *ready;
+    // One ready bit per byte of the SPM range
+    ReadyBitmap ready;
   public:
     // typedef ScratchpadMemoryParams Params;
     // const Params *
@@ -220,6 +224,73 @@ class ScratchpadMemory : public AbstractMemory
      */
     std::unique_ptr<Packet> pendingDelete;
 
+    /**
+     * Banking model. The address range is partitioned over numBanks banks,
+     * each serving bankReadPorts reads and bankWritePorts writes per
+     * bankCycle. Accesses beyond that serialize into later bank cycles and
+     * the wait is added to the response latency.
+     */
+    const unsigned numBanks;
+    const SPMBankPartition bankPartition;
+    const Addr bankInterleave;
+    const unsigned bankReadPorts;
+    const unsigned bankWritePorts;
+    const Tick bankCycle;
+    Addr bankSize;
+
+    // Latest bank cycle with reserved ports, accesses arrive in tick order
+    struct BankSlot
+    {
+        Tick cycle = 0;
+        unsigned used = 0;
+    };
+    struct Bank
+    {
+        BankSlot read;
+        BankSlot write;
+        // Granules of the packet being reserved that fall in this bank
+        unsigned granules = 0;
+    };
+    std::vector<Bank> banks;
+
+    unsigned bankOf(Addr offset) const;
+    Addr nextBankBoundary(Addr offset) const;
+
+    /**
+     * Reserve a port per granule in every bank the packet touches. A bank
+     * covered by several granules of the packet serves them over
+     * ceil(granules / ports) bank cycles.
+     *
+     * @return the delay until the last bank serves the packet
+     */
+    Tick reserveBanks(PacketPtr pkt);
+
+    struct BankStats : public statistics::Group
+    {
+        BankStats(ScratchpadMemory &spm);
+
+        void regStats() override;
+
+        const ScratchpadMemory &spm;
+
+        /** Accesses served by each bank */
+        statistics::Vector reads;
+        statistics::Vector writes;
+        /** Accesses that waited for a free bank port */
+        statistics::Vector conflicts;
+        /** Bank cycles spent waiting for a free bank port */
+        statistics::Vector conflictCycles;
+    } bankStats;
+
+    /**
+     * CACTI model of the SPM arrays, one per bank when banking is modeled.
+     * Estimates are memoized in cactiCache.
+     */
+    const bool cacti;
+    const unsigned cactiWordSize;
+    const std::string cactiCache;
+    SRAMPower power;
+
   public:
     DrainState drain() override;
 
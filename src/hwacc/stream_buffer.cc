@@ -29,45 +29,64 @@ StreamBuffer::StreamBuffer(const StreamBufferParams &p) :
     statusAddr(p.status_address),
     statusSize(p.status_size),
     streamDelay(p.stream_latency),
-    bandwidth(p.bandwidth) {}
+    bandwidth(p.bandwidth),
+    tdataWidth(p.tdata_width),
+    frames(p.buffer_size, p.frame_size),
+    streamStats(*this) {}
+
+void
+StreamBuffer::flush() {
+    buffer.flush();
+    frames.flush();
+    streamStats.occupancy = 0;
+}
+
+void
+StreamBuffer::checkBeats(size_t len) const {
+    panic_if(tdataWidth && (len % tdataWidth),
+             "%s: stream access of %d bytes is not a whole number of %d byte beats\n",
+             name(), len, tdataWidth);
+}
+
+// Account for len bytes that were just published to the ring
+void
+StreamBuffer::pushed(size_t len, bool last) {
+    streamStats.bytesWritten += len;
+    streamStats.frames += frames.pushed(len, last);
+    streamStats.occupancy = buffer.size();
+}
+
+// Account for len bytes that were just consumed from the ring
+void
+StreamBuffer::popped(size_t len) {
+    streamStats.bytesRead += len;
+    frames.popped(len);
+    streamStats.occupancy = buffer.size();
+}
 
 bool
 StreamBuffer::canReadStream(size_t len) {
-    if (buffer.size() >= len) {
-        return true;
-    } else {
-        return false;
-    }
+    return buffer.size() >= len;
 }
 
 bool
 StreamBuffer::canWriteStream(size_t len) {
-    if ((buffer.size()+len) <= fifoSize) {
-        return true;
-    } else {
-        return false;
-    }
+    return buffer.space() >= len;
 }
 
 bool
 StreamBuffer::tryReadStream(uint8_t *dst, size_t len) {
-    if (buffer.size() >= len) {
-        buffer.read(dst, len);
-        return true;
-    } else {
-        return false;
-    }
+    if (!buffer.tryRead(dst, len)) return false;
+    popped(len);
+    return true;
 }
 
 bool
-StreamBuffer::tryWriteStream(uint8_t *src, size_t len)
+StreamBuffer::tryWriteStream(const uint8_t *src, size_t len, bool last)
 {
-    if ((buffer.size()+len) <= fifoSize) {
-        buffer.write(src, len);
-        return true;
-    } else {
-        return false;
-    }
+    if (!buffer.tryWrite(src, len)) return false;
+    pushed(len, last);
+    return true;
 }
 
 void
@@ -77,8 +96,8 @@ StreamBuffer::readStream(uint8_t *dst, size_t len) {
 }
 
 void
-StreamBuffer::writeStream(uint8_t *src, size_t len) {
-    const bool success(tryWriteStream(src, len));
+StreamBuffer::writeStream(const uint8_t *src, size_t len, bool last) {
+    const bool success(tryWriteStream(src, len, last));
     panic_if(!success, "Buffer overrun in StreamBuffer::writeStream()\n");
 }
 
@@ -87,33 +106,45 @@ bool StreamBuffer::tvalid(PacketPtr pkt) {
 }
 
 bool StreamBuffer::tvalid(size_t len, bool isRead) {
-    return isRead ? canReadStream(len) : canWriteStream(len);
+    checkBeats(len);
+    if (isRead) {
+        if (canReadStream(len)) return true;
+        streamStats.readStalls++;
+    } else {
+        if (canWriteStream(len)) return true;
+        streamStats.writeStalls++;
+    }
+    return false;
 }
 
 Tick
 StreamBuffer::streamRead(PacketPtr pkt) {
     DPRINTF(StreamBuffer, "A read request of size %d was received by this stream buffer\n", pkt->getSize());
-    uint8_t *buff = new uint8_t[pkt->getSize()];
-    readStream(buff, pkt->getSize());
-    uint64_t data = *(uint64_t *)buff;
-    delete[] buff;
-
-    switch(pkt->getSize()) {
-      case 1:
-        pkt->set<uint8_t>(data, endian);
-        break;
-      case 2:
-        pkt->set<uint16_t>(data, endian);
-        break;
-      case 4:
-        pkt->set<uint32_t>(data, endian);
-        break;
-      case 8:
-        pkt->set<uint64_t>(data, endian);
-        break;
-      default:
-        panic("Read size too big?\n");
-        break;
+    checkBeats(pkt->getSize());
+    if (pkt->getSize() > sizeof(uint64_t)) {
+        // Wide TDATA beats are copied straight into the packet
+        readStream(pkt->getPtr<uint8_t>(), pkt->getSize());
+    } else {
+        uint64_t data = 0;
+        readStream((uint8_t *)&data, pkt->getSize());
+
+        switch(pkt->getSize()) {
+          case 1:
+            pkt->set<uint8_t>(data, endian);
+            break;
+          case 2:
+            pkt->set<uint16_t>(data, endian);
+            break;
+          case 4:
+            pkt->set<uint32_t>(data, endian);
+            break;
+          case 8:
+            pkt->set<uint64_t>(data, endian);
+            break;
+          default:
+            panic("Read size too big?\n");
+            break;
+        }
     }
     Tick duration = pkt->getSize() * bandwidth;
     pkt->makeAtomicResponse();
@@ -123,10 +154,8 @@ StreamBuffer::streamRead(PacketPtr pkt) {
 Tick
 StreamBuffer::streamWrite(PacketPtr pkt) {
     DPRINTF(StreamBuffer, "A write request of size %d was received by this stream buffer\n", pkt->getSize());
-    uint8_t * data = new uint8_t[pkt->getSize()];
-    pkt->writeData(data);
-    writeStream(data, pkt->getSize());
-    delete data;
+    checkBeats(pkt->getSize());
+    writeStream(pkt->getConstPtr<uint8_t>(), pkt->getSize());
     pkt->makeAtomicResponse();
     return streamDelay;
 }
@@ -134,11 +163,14 @@ StreamBuffer::streamWrite(PacketPtr pkt) {
 Tick
 StreamBuffer::status(PacketPtr pkt, bool readStatus) {
     // Provide a means of reading the current buffer capacity of the stream
-    // Writes to this register do nothing
+    // and the bytes up to the next TLAST. Writes to this register do nothing
     if (pkt->isRead()) {
-        DPRINTF(StreamBuffer, "The status of the buffer has been read. Current capacity is %d of %d bytes\n",
-                buffer.size(), fifoSize);
-        uint64_t data = buffer.size();
+        DPRINTF(StreamBuffer, "The status of the buffer has been read. Current capacity is %d of %d bytes, "
+                "%d bytes to TLAST\n", buffer.size(), fifoSize, untilLast());
+        Addr offset = pkt->getAddr() - statusAddr;
+        panic_if(offset + pkt->getSize() > sizeof(uint64_t),
+                 "%s: status access past the status register\n", name());
+        uint64_t data = frames.status(buffer.size()) >> (8 * offset);
         switch(pkt->getSize()) {
             case 1:
                 pkt->set<uint8_t>(data, endian);
@@ -197,12 +229,43 @@ StreamBuffer::getPort(const std::string &if_name, PortID idx)
 
 void
 StreamBuffer::serialize(CheckpointOut &cp) const {
-    SERIALIZE_CONTAINER(buffer);
+    std::vector<uint8_t> data(buffer.size());
+    buffer.peek(data.data(), data.size());
+    SERIALIZE_CONTAINER(data);
+    std::vector<uint64_t> marks = frames.pendingMarks();
+    SERIALIZE_CONTAINER(marks);
+    uint64_t frameLeft = frames.frameLeft();
+    SERIALIZE_SCALAR(frameLeft);
 }
 
 void
 StreamBuffer::unserialize(CheckpointIn &cp) {
-    UNSERIALIZE_CONTAINER(buffer);
+    std::vector<uint8_t> data;
+    UNSERIALIZE_CONTAINER(data);
+    std::vector<uint64_t> marks;
+    UNSERIALIZE_CONTAINER(marks);
+    uint64_t frameLeft;
+    UNSERIALIZE_SCALAR(frameLeft);
+    flush();
+    buffer.tryWrite(data.data(), data.size());
+    frames.restore(data.size(), marks, frameLeft);
+}
+
+StreamBuffer::StreamStats::StreamStats(StreamBuffer &buffer)
+    : statistics::Group(&buffer, "stream"),
+    ADD_STAT(bytesWritten, statistics::units::Byte::get(),
+             "Number of bytes pushed into the stream"),
+    ADD_STAT(bytesRead, statistics::units::Byte::get(),
+             "Number of bytes pulled from the stream"),
+    ADD_STAT(frames, statistics::units::Count::get(),
+             "Number of frames ended by TLAST"),
+    ADD_STAT(writeStalls, statistics::units::Count::get(),
+             "Number of writes refused because the buffer was full"),
+    ADD_STAT(readStalls, statistics::units::Count::get(),
+             "Number of reads refused because the buffer was empty"),
+    ADD_STAT(occupancy, statistics::units::Byte::get(),
+             "Average number of bytes held in the buffer")
+{
 }
 
 // StreamBuffer *
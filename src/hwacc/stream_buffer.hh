@@ -3,17 +3,27 @@
 
 #include "params/StreamBuffer.hh"
 // #include "dev/io_device.hh"
-#include "base/circlebuf.hh"
+#include "base/statistics.hh"
 #include "sim/clocked_object.hh"
+#include "hwacc/stream_frames.hh"
 #include "hwacc/stream_port.hh"
+#include "hwacc/stream_ring.hh"
 
+/**
+ * AXI-Stream style FIFO between a producer and a consumer. Data lives in a
+ * lock-free power-of-two ring and moves in bulk copies. With a TDATA width
+ * set, every stream access must be a whole number of beats. TLAST is
+ * asserted every frame_size bytes or by a producer through writeStream(),
+ * and consumers see the bytes up to the next TLAST in the status register,
+ * laid out in stream_frames.hh.
+ */
 class StreamBuffer : public ClockedObject {
   private:
     StreamResponsePortT<StreamBuffer> streamIn;
     StreamResponsePortT<StreamBuffer> streamOut;
     StatusPort<StreamBuffer> statusIn;
     StatusPort<StreamBuffer> statusOut;
-    Fifo<uint8_t> buffer;
+    StreamRing<uint8_t> buffer;
     size_t const fifoSize;
     ByteOrder endian;
     Addr streamAddr;
@@ -22,6 +32,28 @@ class StreamBuffer : public ClockedObject {
   Addr statusSize;
     Tick streamDelay;
     const double bandwidth;
+    const unsigned tdataWidth;
+
+    StreamFrames frames;
+
+    void checkBeats(size_t len) const;
+    void pushed(size_t len, bool last);
+    void popped(size_t len);
+
+    struct StreamStats : public statistics::Group
+    {
+        StreamStats(StreamBuffer &buffer);
+
+        statistics::Scalar bytesWritten;
+        statistics::Scalar bytesRead;
+        statistics::Scalar frames;
+        /** Accesses refused by tvalid because the buffer was full */
+        statistics::Scalar writeStalls;
+        /** Accesses refused by tvalid because the buffer was empty */
+        statistics::Scalar readStalls;
+        /** Time average of the bytes held in the buffer */
+        statistics::Average occupancy;
+    } streamStats;
 
   public:
     // typedef StreamBufferParams Params;
@@ -34,13 +66,16 @@ class StreamBuffer : public ClockedObject {
     StreamBuffer(const StreamBufferParams &p);
 
     size_t size() const { return buffer.size(); }
-    void flush() { buffer.flush(); }
+    void flush();
     bool canReadStream(size_t len);
     bool canWriteStream(size_t len);
     void readStream(uint8_t *dst, size_t len);
-    void writeStream(uint8_t *src, size_t len);
+    void writeStream(const uint8_t *src, size_t len, bool last=false);
     bool tryReadStream(uint8_t *dst, size_t len);
-    bool tryWriteStream(uint8_t *src, size_t len);
+    bool tryWriteStream(const uint8_t *src, size_t len, bool last=false);
+
+    /** Bytes up to and including the next TLAST, 0 if none is buffered */
+    size_t untilLast() const { return frames.untilLast(); }
 
     bool tvalid(PacketPtr pkt);
     bool tvalid(size_t len, bool isRead);
@@ -60,4 +95,4 @@ class StreamBuffer : public ClockedObject {
     double getBandwidth(){ return bandwidth; };
 };
 
-#endif // __HWACC_STREAM_BUFFER_HH__
\ No newline at end of file
+#endif // __HWACC_STREAM_BUFFER_HH__
@@ -12,6 +12,8 @@ StreamDma::StreamDma(const StreamDmaParams &p)
     pioAddr(p.pio_addr),
     pioDelay(p.pio_delay),
     pioSize(p.pio_size),
+    strided(p.strided),
+    bufferAccessOff(p.strided ? STRIDED_BUFFER_ACCESS_OFF : BUFFER_ACCESS_OFF),
     streamAddr(p.stream_addr),
     streamSize(p.stream_size),
     statusAddr(p.status_addr),
@@ -25,11 +27,14 @@ StreamDma::StreamDma(const StreamDmaParams &p)
     rdInt(p.rd_int),
     wrInt(p.wr_int),
     tickEvent(this),
-    bandwidth(p.bandwidth) {
-    readFifo = new DmaReadFifo(dmaPort, rdBufferSize, maxReqSize, maxPending);
+    bandwidth(p.bandwidth),
+    dmaStats(*this) {
+    readFifo = new StridedReadFifo(dmaPort, rdBufferSize, maxReqSize, maxPending);
     writeFifo = new DmaWriteFifo(dmaPort, wrBufferSize, maxReqSize, maxPending);
-    mmreg = new uint8_t[32];
-    for (int i=0; i<pioSize; i++)
+    readFifo->setWakeup([this]{ frameCheck(); });
+    writeFifo->setWakeup([this]{ frameCheck(); });
+    mmreg = new uint8_t[bufferAccessOff];
+    for (Addr i=0; i<bufferAccessOff; i++)
         mmreg[i]=0;
     FLAGS = mmreg;
     CONFIG = (uint16_t *)(mmreg+CONFIG_OFF);
@@ -41,6 +46,17 @@ StreamDma::StreamDma(const StreamDmaParams &p)
     WR_FRAME_SIZE = (uint32_t *)(mmreg+WR_FRAME_SIZE_OFF);
     NUM_WR_FRAMES = (uint8_t *)(mmreg+NUM_WR_FRAMES_OFF);
     WR_FRAME_BUFF_SIZE = (uint8_t *)(mmreg+WR_FRAME_BUFF_SIZE_OFF);
+    if (strided) {
+        ELEM_SIZE = (uint8_t *)(mmreg+ELEM_SIZE_OFF);
+        RD_ROWS = (uint32_t *)(mmreg+RD_ROWS_OFF);
+        RD_ROW_STRIDE = (uint32_t *)(mmreg+RD_ROW_STRIDE_OFF);
+        RD_PLANES = (uint32_t *)(mmreg+RD_PLANES_OFF);
+        RD_PLANE_STRIDE = (uint32_t *)(mmreg+RD_PLANE_STRIDE_OFF);
+        WR_ROWS = (uint32_t *)(mmreg+WR_ROWS_OFF);
+        WR_ROW_STRIDE = (uint32_t *)(mmreg+WR_ROW_STRIDE_OFF);
+        WR_PLANES = (uint32_t *)(mmreg+WR_PLANES_OFF);
+        WR_PLANE_STRIDE = (uint32_t *)(mmreg+WR_PLANE_STRIDE_OFF);
+    }
 
     rdRunning = false;
     wrRunning = false;
@@ -77,8 +93,33 @@ StreamDma::getStatusAddrRanges() const {
     return statusRanges;
 }
 
+StridedBlock
+StreamDma::frameBlock(uint32_t frame_size, uint32_t rows, uint32_t row_stride,
+                      uint32_t planes, uint32_t plane_stride) const {
+    Addr elem = std::max(*ELEM_SIZE, (uint8_t)1);
+    return StridedBlock(0, frame_size * elem, rows, row_stride * elem,
+                        planes, plane_stride * elem);
+}
+
+void
+StreamDma::wakeup() {
+    if (!tickEvent.scheduled()) {
+        schedule(tickEvent, nextCycle());
+    }
+}
+
+// Frames only complete on FIFO responses and buffer accesses, so the engine
+// sleeps between MMR writes and completed frames instead of polling.
+void
+StreamDma::frameCheck() {
+    if ((rdRunning && !readFifo->isActive()) || (wrRunning && !writeFifo->isActive())) {
+        wakeup();
+    }
+}
+
 void
 StreamDma::tick() {
+    dmaStats.tickEvents++;
 
     if (!rdRunning && ((*FLAGS&RD_START_MASK)==RD_START_MASK)) {
         rdRunning = true;
@@ -86,13 +127,20 @@ StreamDma::tick() {
         *FLAGS |= RD_RUNNING_MASK;
         readAddr = *RD_ADDR;
         readPtr = readAddr;
-        readFrameSize = *RD_FRAME_SIZE;
+        if (strided) {
+            readFrame = frameBlock(*RD_FRAME_SIZE, *RD_ROWS, *RD_ROW_STRIDE,
+                                   *RD_PLANES, *RD_PLANE_STRIDE);
+        } else {
+            readFrame = StridedBlock(0, *RD_FRAME_SIZE);
+        }
+        readFrame.start = readPtr;
+        readFrameSize = readFrame.size();
         framesToRead = *NUM_RD_FRAMES;
         readFrameBuffSize = *RD_FRAME_BUFF_SIZE;
         framesRead = 0;
         readIntFrames = *(uint8_t *)CONFIG;
         DPRINTF(StreamDma, "Initializing frame read from 0x%016x with frame size of %d Bytes\n", readPtr, readFrameSize);
-        readFifo->startFill(readPtr, readFrameSize);
+        readFifo->startFill(readFrame);
     }
 
     if (!wrRunning && ((*FLAGS&WR_START_MASK)==WR_START_MASK)) {
@@ -101,14 +149,21 @@ StreamDma::tick() {
         *FLAGS |= WR_RUNNING_MASK;
         writeAddr = *WR_ADDR;
         writePtr = writeAddr;
-        writeFrameSize = *WR_FRAME_SIZE;
+        if (strided) {
+            writeFrame = frameBlock(*WR_FRAME_SIZE, *WR_ROWS, *WR_ROW_STRIDE,
+                                    *WR_PLANES, *WR_PLANE_STRIDE);
+        } else {
+            writeFrame = StridedBlock(0, *WR_FRAME_SIZE);
+        }
+        writeFrame.start = writePtr;
+        writeFrameSize = writeFrame.size();
         framesToWrite = *NUM_WR_FRAMES;
         writeFrameBuffSize = *WR_FRAME_BUFF_SIZE;
         framesWritten = 0;
         writeIntFrames = *CONFIG>>8;
         DPRINTF(StreamDma, "MMR After Write: %08x\n", *FLAGS);
         DPRINTF(StreamDma, "Initializing frame write to 0x%016x with frame size of %d Bytes\n", writePtr, writeFrameSize);
-        writeFifo->startEmpty(writePtr, writeFrameSize);
+        writeFifo->startEmpty(writeFrame);
     }
 
     if ((*FLAGS&RD_INT_MASK) != RD_INT_MASK) {
@@ -133,9 +188,10 @@ StreamDma::tick() {
             *FLAGS &= ~RD_RUNNING_MASK;
         } else {
             assert(readFrameBuffSize != 0);
-            readPtr = readAddr + ((framesRead % readFrameBuffSize) * readFrameSize);
+            readPtr = readAddr + ((framesRead % readFrameBuffSize) * readFrame.footprint());
+            readFrame.start = readPtr;
             DPRINTF(StreamDma, "Initializing frame read from 0x%016x with frame size of %d Bytes\n", readPtr, readFrameSize);
-            readFifo->startFill(readPtr, readFrameSize);
+            readFifo->startFill(readFrame);
         }
     }
 
@@ -153,16 +209,16 @@ StreamDma::tick() {
             *FLAGS &= ~WR_RUNNING_MASK;
         } else {
             assert(writeFrameBuffSize != 0);
-            writePtr = writeAddr + ((framesWritten % writeFrameBuffSize) * writeFrameSize);
+            writePtr = writeAddr + ((framesWritten % writeFrameBuffSize) * writeFrame.footprint());
+            writeFrame.start = writePtr;
             DPRINTF(StreamDma, "Initializing frame write to 0x%016x with frame size of %d Bytes\n", writePtr, writeFrameSize);
-            writeFifo->startEmpty(writePtr, writeFrameSize);
+            writeFifo->startEmpty(writeFrame);
         }
     }
 
     running = rdRunning || wrRunning;
-    if (!tickEvent.scheduled() && running) {
-        schedule(tickEvent, nextCycle());
-    }
+    // A frame that completed without a DMA response, as in bypass mode
+    frameCheck();
 }
 
 Tick
@@ -170,7 +226,7 @@ StreamDma::read(PacketPtr pkt) {
 
     Addr offset = pkt->req->getPaddr() - pioAddr;
 
-    if (offset < BUFFER_ACCESS_OFF) {
+    if (offset < bufferAccessOff) {
         DPRINTF(DeviceMMR, "The MMR associated with this DMA was read from!\n");
 
         uint32_t data;
@@ -198,6 +254,8 @@ StreamDma::read(PacketPtr pkt) {
         readFifo->get(buff, pkt->getSize());
         uint64_t data = *(uint64_t *)buff;
         delete buff;
+        dmaStats.bytes += pkt->getSize();
+        frameCheck();
 
         switch(pkt->getSize()) {
           case 1:
@@ -218,9 +276,6 @@ StreamDma::read(PacketPtr pkt) {
         }
     }
 
-    if (!tickEvent.scheduled()) {
-        schedule(tickEvent, nextCycle());
-    }
     pkt->makeAtomicResponse();
     return pioDelay;
 }
@@ -230,21 +285,21 @@ StreamDma::write(PacketPtr pkt) {
 
     Addr offset = pkt->req->getPaddr() - pioAddr;
 
-    if (offset < BUFFER_ACCESS_OFF) {
+    if (offset < bufferAccessOff) {
         DPRINTF(DeviceMMR, "The MMR associated with this DMA was written to!\n");
 
         pkt->writeData(mmreg + offset);
+        wakeup();
     } else {
         DPRINTF(DeviceMMR, "The data buffer associated with this DMA was written to!\n");
         uint8_t * data = new uint8_t[pkt->getSize()];
         pkt->writeData(data);
         writeFifo->fill(data, pkt->getSize());
         delete data;
+        dmaStats.bytes += pkt->getSize();
+        frameCheck();
     }
 
-    if (!tickEvent.scheduled()) {
-        schedule(tickEvent, nextCycle());
-    }
     pkt->makeAtomicResponse();
     return pioDelay;
 }
@@ -257,6 +312,8 @@ StreamDma::streamRead(PacketPtr pkt) {
     readFifo->get(buff, pkt->getSize());
     uint64_t data = *(uint64_t *)buff;
     delete buff;
+    dmaStats.bytes += pkt->getSize();
+    frameCheck();
 
     switch(pkt->getSize()) {
       case 1:
@@ -289,6 +346,8 @@ StreamDma::streamWrite(PacketPtr pkt) {
     pkt->writeData(data);
     writeFifo->fill(data, pkt->getSize());
     delete data;
+    dmaStats.bytes += pkt->getSize();
+    frameCheck();
 
     pkt->makeAtomicResponse();
     return pioDelay;
@@ -346,6 +405,19 @@ StreamDma::tvalid(size_t len, bool isRead) {
     }
 }
 
+StreamDma::DmaStats::DmaStats(StreamDma &dma)
+    : statistics::Group(&dma, "engine"),
+    ADD_STAT(tickEvents, statistics::units::Count::get(),
+             "Number of engine tick events processed"),
+    ADD_STAT(bytes, statistics::units::Byte::get(),
+             "Number of bytes moved through the stream and buffer interfaces"),
+    ADD_STAT(eventsPerByte, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Byte>::get(),
+             "Engine tick events per byte transferred",
+             tickEvents / bytes)
+{
+}
+
 Port &
 StreamDma::getPort(const std::string &if_name, PortID idx) {
     if (if_name == "stream_in") {
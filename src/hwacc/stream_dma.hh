@@ -3,12 +3,14 @@
 //------------------------------------------//
 #include "hwacc/LLVMRead/src/debug_flags.hh"
 #include "hwacc/dma_write_fifo.hh"
+#include "hwacc/strided_read_fifo.hh"
 #include "params/StreamDma.hh"
 #include "dev/dma_device.hh"
 #include "dev/arm/base_gic.hh"
 #include "hwacc/stream_port.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
+#include "base/statistics.hh"
 //------------------------------------------//
 
 /*
@@ -36,14 +38,24 @@
     Wr_Addr - The base address to which we are writing the first frame.
     Rd_Addr - The base address from which the first frame is read.
 
+    Strided Frame Registers, at offset 32 when strided is set. The Buffer Access Range then starts at offset 64.
+    | WrPlaneStride | WrPlanes | WrRowStride | WrRows  | RdPlaneStride | RdPlanes | RdRowStride | RdRows  |
+    |---------------|----------|-------------|---------|---------------|----------|-------------|---------|
+    |    4 Bytes    | 4 Bytes  |   4 Bytes   | 4 Bytes |    4 Bytes    | 4 Bytes  |   4 Bytes   | 4 Bytes |
+
+    A strided frame is Planes planes of Rows rows, each FrameSize elements long. Frame sizes and strides count
+    elements of ElemSize bytes, and zero sizes and counts mean 1. Frames of a frame buffer are placed back to back
+    by the extent of their last row.
+
     Config Register
-    | Unused  | WrIntFrame | RdIntFrame |
-    |---------|------------|------------|
-    | 1 Byte  |   1 Byte   |   1 Byte   |
-    23        15           7            0
+    | ElemSize | WrIntFrame | RdIntFrame |
+    |----------|------------|------------|
+    |  1 Byte  |   1 Byte   |   1 Byte   |
+    23         15           7            0
 
     RdIntFrame - Number of frames to read before raising interrupt '0' for never
     WrIntFrame - Number of frames to write before raising interrupt '0' for never
+    ElemSize - Size of a frame element in Bytes, only used when strided is set
 
     Flags Register
     | Unused | WrInt | RdInt | WrRunning | RdRunning | WrStart | RdStart |
@@ -64,6 +76,16 @@
 #define NUM_WR_FRAMES_OFF       WR_FRAME_SIZE_OFF+4
 #define WR_FRAME_BUFF_SIZE_OFF  NUM_WR_FRAMES_OFF+1
 #define BUFFER_ACCESS_OFF       WR_FRAME_BUFF_SIZE_OFF+1
+#define ELEM_SIZE_OFF           CONFIG_OFF+2
+#define RD_ROWS_OFF             BUFFER_ACCESS_OFF
+#define RD_ROW_STRIDE_OFF       RD_ROWS_OFF+4
+#define RD_PLANES_OFF           RD_ROW_STRIDE_OFF+4
+#define RD_PLANE_STRIDE_OFF     RD_PLANES_OFF+4
+#define WR_ROWS_OFF             RD_PLANE_STRIDE_OFF+4
+#define WR_ROW_STRIDE_OFF       WR_ROWS_OFF+4
+#define WR_PLANES_OFF           WR_ROW_STRIDE_OFF+4
+#define WR_PLANE_STRIDE_OFF     WR_PLANES_OFF+4
+#define STRIDED_BUFFER_ACCESS_OFF WR_PLANE_STRIDE_OFF+4
 
 #define START_MASK              0x03
 #define RD_START_MASK           0x01
@@ -82,11 +104,13 @@ class StreamDma : public DmaDevice {
     StreamResponsePortT<StreamDma> streamOut;
     StatusPort<StreamDma> statusIn;
     StatusPort<StreamDma> statusOut;
-    DmaReadFifo *readFifo;
+    StridedReadFifo *readFifo;
     DmaWriteFifo *writeFifo;
     Addr pioAddr;
     Tick pioDelay;
     Addr pioSize;
+    bool strided;
+    Addr bufferAccessOff;
     Addr streamAddr;
     Addr streamSize;
     Addr statusAddr;
@@ -132,6 +156,15 @@ class StreamDma : public DmaDevice {
     uint32_t * WR_FRAME_SIZE;
     uint8_t * NUM_WR_FRAMES;
     uint8_t * WR_FRAME_BUFF_SIZE;
+    uint8_t * ELEM_SIZE;
+    uint32_t * RD_ROWS;
+    uint32_t * RD_ROW_STRIDE;
+    uint32_t * RD_PLANES;
+    uint32_t * RD_PLANE_STRIDE;
+    uint32_t * WR_ROWS;
+    uint32_t * WR_ROW_STRIDE;
+    uint32_t * WR_PLANES;
+    uint32_t * WR_PLANE_STRIDE;
 
     uint64_t readAddr;
     uint32_t readFrameSize;
@@ -140,6 +173,7 @@ class StreamDma : public DmaDevice {
     uint64_t framesRead;
     uint8_t readIntFrames;
     uint64_t readPtr;
+    StridedBlock readFrame;
 
     uint64_t writeAddr;
     uint32_t writeFrameSize;
@@ -148,6 +182,25 @@ class StreamDma : public DmaDevice {
     uint64_t framesWritten;
     uint8_t writeIntFrames;
     uint64_t writePtr;
+    StridedBlock writeFrame;
+
+    // Schedule a tick unless one is pending
+    void wakeup();
+    // Tick if a running frame has completed
+    void frameCheck();
+
+    struct DmaStats : public statistics::Group
+    {
+        DmaStats(StreamDma &dma);
+
+        statistics::Scalar tickEvents;
+        statistics::Scalar bytes;
+        statistics::Formula eventsPerByte;
+    } dmaStats;
+
+    // Frame geometry from the MMRs, placed at offset 0
+    StridedBlock frameBlock(uint32_t frame_size, uint32_t rows, uint32_t row_stride,
+                            uint32_t planes, uint32_t plane_stride) const;
 
   protected:
 
@@ -0,0 +1,116 @@
+#ifndef __HWACC_STREAM_FRAMES_HH__
+#define __HWACC_STREAM_FRAMES_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "hwacc/stream_ring.hh"
+
+/**
+ * TLAST framing of a byte stream. Frames end every frame_size bytes, or
+ * where the producer asserts TLAST, and are recorded as the stream
+ * positions just past their last byte while those bytes are buffered.
+ *
+ * The status register of a stream buffer exposes the framing to consumers:
+ * the 32-bit word at offset 0 holds the number of buffered bytes and the
+ * word at offset 4 the number of bytes up to and including the next TLAST,
+ * or 0 while no TLAST is buffered.
+ */
+class StreamFrames
+{
+  private:
+    const uint64_t frameSize;
+    StreamRing<uint64_t> marks;
+    uint64_t bytesIn;
+    uint64_t bytesOut;
+    uint64_t nextFrameEnd;
+    uint64_t lastMark;
+
+    // Frames end in order, so a mark is only added past the previous one
+    bool
+    markLast(uint64_t pos)
+    {
+        if ((pos <= bytesOut) || (pos <= lastMark)) return false;
+        marks.push(pos);
+        lastMark = pos;
+        return true;
+    }
+
+  public:
+    StreamFrames(size_t capacity, uint64_t frame_size)
+        : frameSize(frame_size), marks(capacity), bytesIn(0), bytesOut(0),
+          nextFrameEnd(frame_size), lastMark(0)
+    { }
+
+    /** Account for len bytes pushed, returns the number of frames ended */
+    unsigned
+    pushed(size_t len, bool last)
+    {
+        unsigned ended = 0;
+        bytesIn += len;
+        while (frameSize && (nextFrameEnd <= bytesIn)) {
+            ended += markLast(nextFrameEnd);
+            nextFrameEnd += frameSize;
+        }
+        if (last) ended += markLast(bytesIn);
+        return ended;
+    }
+
+    /** Account for len bytes popped */
+    void
+    popped(size_t len)
+    {
+        bytesOut += len;
+        while (!marks.empty() && (marks.front() <= bytesOut))
+            marks.commitRead(1);
+    }
+
+    /** Drop the buffered bytes and the frame ends among them */
+    void
+    flush()
+    {
+        marks.flush();
+        bytesOut = bytesIn;
+    }
+
+    /** Bytes up to and including the next TLAST, 0 if none is buffered */
+    size_t
+    untilLast() const
+    {
+        return marks.empty() ? 0 : marks.front() - bytesOut;
+    }
+
+    /** Status register of a buffer holding occupancy bytes */
+    uint64_t
+    status(size_t occupancy) const
+    {
+        return ((uint64_t)(uint32_t)untilLast() << 32) |
+               (uint32_t)occupancy;
+    }
+
+    /** @{ Checkpointing, positions are relative to the front of the buffer */
+    std::vector<uint64_t>
+    pendingMarks() const
+    {
+        std::vector<uint64_t> pending(marks.size());
+        marks.peek(pending.data(), pending.size());
+        for (auto &mark : pending) mark -= bytesOut;
+        return pending;
+    }
+    uint64_t frameLeft() const { return nextFrameEnd - bytesIn; }
+
+    void
+    restore(size_t buffered, const std::vector<uint64_t> &pending,
+            uint64_t frame_left)
+    {
+        marks.flush();
+        bytesOut = 0;
+        bytesIn = buffered;
+        marks.tryWrite(pending.data(), pending.size());
+        lastMark = pending.empty() ? 0 : pending.back();
+        nextFrameEnd = bytesIn + frame_left;
+    }
+    /** @} */
+};
+
+#endif //__HWACC_STREAM_FRAMES_HH__
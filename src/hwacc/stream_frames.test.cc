@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "hwacc/stream_frames.hh"
+
+/*
+ * Checks the TLAST framing a StreamBuffer reports in its status register,
+ * for fixed size frames and for frames ended by the producer.
+ */
+
+TEST(StreamFrames, FixedSizeFrames)
+{
+    StreamFrames frames(256, 16);
+    EXPECT_EQ(frames.untilLast(), 0u);
+    EXPECT_EQ(frames.pushed(8, false), 0u);
+    EXPECT_EQ(frames.untilLast(), 0u);
+    EXPECT_EQ(frames.pushed(40, false), 3u);
+    EXPECT_EQ(frames.untilLast(), 16u);
+
+    frames.popped(4);
+    EXPECT_EQ(frames.untilLast(), 12u);
+    frames.popped(12);
+    EXPECT_EQ(frames.untilLast(), 16u);
+    frames.popped(32);
+    EXPECT_EQ(frames.untilLast(), 0u);
+}
+
+TEST(StreamFrames, ProducerAssertsLast)
+{
+    StreamFrames frames(256, 0);
+    EXPECT_EQ(frames.pushed(12, true), 1u);
+    EXPECT_EQ(frames.pushed(4, false), 0u);
+    EXPECT_EQ(frames.untilLast(), 12u);
+    frames.popped(12);
+    EXPECT_EQ(frames.untilLast(), 0u);
+
+    // TLAST on a frame boundary ends a single frame
+    StreamFrames fixed(256, 8);
+    EXPECT_EQ(fixed.pushed(8, true), 1u);
+    EXPECT_EQ(fixed.untilLast(), 8u);
+}
+
+TEST(StreamFrames, StatusRegister)
+{
+    StreamFrames frames(256, 0);
+    frames.pushed(24, true);
+    frames.pushed(8, false);
+    frames.popped(4);
+    uint64_t status = frames.status(28);
+    EXPECT_EQ(status & 0xffffffff, 28u);
+    EXPECT_EQ(status >> 32, 20u);
+
+    frames.flush();
+    EXPECT_EQ(frames.status(0), 0u);
+}
+
+TEST(StreamFrames, Checkpoint)
+{
+    StreamFrames frames(256, 16);
+    frames.pushed(40, false);
+    frames.popped(20);
+    auto marks = frames.pendingMarks();
+    ASSERT_EQ(marks.size(), 1u);
+    EXPECT_EQ(marks[0], 12u);
+
+    StreamFrames restored(256, 16);
+    restored.restore(20, marks, frames.frameLeft());
+    EXPECT_EQ(restored.untilLast(), 12u);
+    EXPECT_EQ(restored.pushed(8, false), 1u);
+    restored.popped(12);
+    EXPECT_EQ(restored.untilLast(), 16u);
+}
@@ -124,8 +124,8 @@ class StreamResponsePortT : public StreamResponsePort
     }
 
   public:
-    StreamResponsePortT(Device *dev) :
-      StreamResponsePort(dev->name() + ".stream", dev),
+    StreamResponsePortT(Device *dev, const std::string &suffix=".stream") :
+      StreamResponsePort(dev->name() + suffix, dev),
       isBusy(false),
       retryReq(false),
       releaseEvent([this]{ release(); }, dev->name()),
@@ -0,0 +1,153 @@
+#ifndef __HWACC_STREAM_RING_HH__
+#define __HWACC_STREAM_RING_HH__
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/**
+ * Single-producer single-consumer ring buffer with a power-of-two number of
+ * slots. Head and tail only ever grow and are masked on access, so the ring
+ * never needs a lock: the producer alone moves the tail and the consumer
+ * alone moves the head. Bulk reads and writes copy at most two contiguous
+ * pieces, and the span interface lets either side work on the ring storage
+ * in place and commit what it used.
+ *
+ * The capacity limits how many slots may be occupied, and may be smaller
+ * than the storage, which is rounded up to a power of two.
+ */
+template <class T>
+class StreamRing
+{
+  public:
+    /** A contiguous piece of ring storage */
+    struct Span
+    {
+        T *data;
+        size_t size;
+    };
+
+  private:
+    std::unique_ptr<T[]> storage;
+    size_t mask;
+    size_t limit;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+
+    static size_t
+    roundUp(size_t n)
+    {
+        size_t slots = 1;
+        while (slots < n) slots <<= 1;
+        return slots;
+    }
+
+  public:
+    StreamRing(size_t capacity)
+        : storage(new T[roundUp(std::max<size_t>(capacity, 1))]()),
+          mask(roundUp(std::max<size_t>(capacity, 1)) - 1),
+          limit(capacity), head(0), tail(0)
+    { }
+
+    size_t capacity() const { return limit; }
+    size_t slots() const { return mask + 1; }
+    size_t
+    size() const
+    {
+        return tail.load(std::memory_order_acquire) -
+               head.load(std::memory_order_acquire);
+    }
+    size_t space() const { return limit - size(); }
+    bool empty() const { return size() == 0; }
+
+    /** Discard everything in the ring */
+    void flush() { head.store(tail.load(std::memory_order_acquire),
+                              std::memory_order_release); }
+
+    /** @{ Consumer side */
+    /** Copy len slots from the front to dst without consuming them */
+    bool
+    peek(T *dst, size_t len, size_t skip=0) const
+    {
+        if (size() < skip + len) return false;
+        uint64_t pos = head.load(std::memory_order_relaxed) + skip;
+        size_t first = std::min(len, slots() - (pos & mask));
+        std::memcpy(dst, &storage[pos & mask], first * sizeof(T));
+        if (len > first)
+            std::memcpy(dst + first, &storage[0], (len - first) * sizeof(T));
+        return true;
+    }
+
+    bool
+    tryRead(T *dst, size_t len)
+    {
+        if (!peek(dst, len)) return false;
+        commitRead(len);
+        return true;
+    }
+
+    /** Largest contiguous piece at the front of the ring */
+    Span
+    readSpan() const
+    {
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        size_t len = std::min(size(), slots() - (pos & mask));
+        return {&storage[pos & mask], len};
+    }
+
+    void
+    commitRead(size_t len)
+    {
+        assert(len <= size());
+        // Only the consumer moves the head, so no read-modify-write is needed
+        head.store(head.load(std::memory_order_relaxed) + len,
+                   std::memory_order_release);
+    }
+
+    const T &
+    front() const
+    {
+        assert(!empty());
+        return storage[head.load(std::memory_order_relaxed) & mask];
+    }
+    /** @} */
+
+    /** @{ Producer side */
+    bool
+    tryWrite(const T *src, size_t len)
+    {
+        if (space() < len) return false;
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        size_t first = std::min(len, slots() - (pos & mask));
+        std::memcpy(&storage[pos & mask], src, first * sizeof(T));
+        if (len > first)
+            std::memcpy(&storage[0], src + first, (len - first) * sizeof(T));
+        tail.store(pos + len, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T &value) { return tryWrite(&value, 1); }
+
+    /** Largest contiguous free piece at the back of the ring */
+    Span
+    writeSpan()
+    {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        size_t len = std::min(space(), slots() - (pos & mask));
+        return {&storage[pos & mask], len};
+    }
+
+    void
+    commitWrite(size_t len)
+    {
+        assert(len <= space());
+        tail.store(tail.load(std::memory_order_relaxed) + len,
+                   std::memory_order_release);
+    }
+    /** @} */
+};
+
+#endif //__HWACC_STREAM_RING_HH__
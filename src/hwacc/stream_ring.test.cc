@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "base/circlebuf.hh"
+#include "hwacc/stream_ring.hh"
+
+/*
+ * Checks StreamRing against a deque reference, and against the Fifo<uint8_t>
+ * StreamBuffer used to keep its data in, for the beat sizes of AXI-Stream
+ * links between accelerators.
+ */
+
+using namespace gem5;
+
+TEST(StreamRing, WrapAround)
+{
+    StreamRing<uint8_t> ring(100);
+    EXPECT_EQ(ring.capacity(), 100u);
+    EXPECT_EQ(ring.slots(), 128u);
+
+    std::vector<uint8_t> in(90), out(90);
+    for (size_t i = 0; i < in.size(); i++) in[i] = i;
+    ASSERT_TRUE(ring.tryWrite(in.data(), 90));
+    EXPECT_FALSE(ring.tryWrite(in.data(), 11));
+    ASSERT_TRUE(ring.tryRead(out.data(), 80));
+    EXPECT_EQ(ring.size(), 10u);
+
+    // The next write wraps past the end of the storage
+    ASSERT_TRUE(ring.tryWrite(in.data(), 90));
+    EXPECT_EQ(ring.space(), 0u);
+    ASSERT_TRUE(ring.tryRead(out.data(), 10));
+    EXPECT_EQ(out[0], 80);
+    ASSERT_TRUE(ring.tryRead(out.data(), 90));
+    EXPECT_EQ(out, in);
+    EXPECT_FALSE(ring.tryRead(out.data(), 1));
+}
+
+TEST(StreamRing, Spans)
+{
+    StreamRing<uint8_t> ring(64);
+    std::vector<uint8_t> in(48, 7);
+    ASSERT_TRUE(ring.tryWrite(in.data(), 48));
+    ring.commitRead(40);
+
+    // Free space wraps, so the first span stops at the end of the storage
+    auto span = ring.writeSpan();
+    EXPECT_EQ(span.size, 16u);
+    for (size_t i = 0; i < span.size; i++) span.data[i] = i;
+    ring.commitWrite(span.size);
+    span = ring.writeSpan();
+    EXPECT_EQ(span.size, 40u);
+
+    auto rd = ring.readSpan();
+    EXPECT_EQ(rd.size, 24u);
+    EXPECT_EQ(rd.data[8], 0);
+    EXPECT_EQ(rd.data[23], 15);
+    ring.commitRead(rd.size);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(StreamRing, MatchesDeque)
+{
+    StreamRing<uint8_t> ring(1000);
+    std::deque<uint8_t> reference;
+    std::mt19937_64 rng(12345);
+    std::vector<uint8_t> buf(300);
+    uint8_t next = 0;
+
+    for (int i = 0; i < 100000; i++) {
+        size_t len = rng() % 300;
+        if (rng() % 2) {
+            for (size_t j = 0; j < len; j++) buf[j] = next++;
+            bool fits = reference.size() + len <= 1000;
+            ASSERT_EQ(ring.tryWrite(buf.data(), len), fits);
+            if (fits) reference.insert(reference.end(), buf.begin(), buf.begin() + len);
+            else next -= len;
+        } else {
+            bool ok = reference.size() >= len;
+            ASSERT_EQ(ring.tryRead(buf.data(), len), ok);
+            for (size_t j = 0; ok && j < len; j++) {
+                ASSERT_EQ(buf[j], reference.front());
+                reference.pop_front();
+            }
+        }
+        ASSERT_EQ(ring.size(), reference.size());
+    }
+}
+
+TEST(StreamRing, MatchesFifo)
+{
+    const size_t depth = 4096;
+    const size_t bytes = 64 * 1024;
+    for (size_t beat : {1, 8, 64}) {
+        std::vector<uint8_t> in(beat), fifoOut(beat), ringOut(beat);
+        Fifo<uint8_t> fifo(depth);
+        StreamRing<uint8_t> ring(depth);
+        uint8_t next = 0;
+
+        // Producer runs ahead by half the buffer, as between two pipeline stages
+        for (size_t i = 0; i < bytes / beat; i++) {
+            for (auto &b : in) b = next++;
+            fifo.write(in.begin(), beat);
+            ASSERT_TRUE(ring.tryWrite(in.data(), beat));
+            ASSERT_EQ(ring.size(), fifo.size());
+            if (fifo.size() >= depth / 2) {
+                fifo.read(fifoOut.begin(), beat);
+                ASSERT_TRUE(ring.tryRead(ringOut.data(), beat));
+                ASSERT_EQ(ringOut, fifoOut) << "beat " << beat << " at " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,268 @@
+#include "hwacc/stream_switch.hh"
+#include "debug/StreamSwitch.hh"
+
+#include "sim/system.hh"
+#include "mem/packet_access.hh"
+#include "debug/AddrRanges.hh"
+
+#include <algorithm>
+
+StreamSwitch::Input::Input(StreamSwitch *sw, unsigned index) :
+    port(sw, true, index),
+    data(sw->inBufferSize),
+    transfers(sw->inBufferSize) {}
+
+StreamSwitch::Output::Output(StreamSwitch *sw, unsigned index) :
+    port(sw, false, index),
+    data(sw->outBufferSize),
+    nextInput(0) {}
+
+StreamSwitch::StreamSwitch(const StreamSwitchParams &p) :
+    ClockedObject(p),
+    endian(p.system->getGuestByteOrder()),
+    inAddress(p.in_address),
+    outAddress(p.out_address),
+    streamSize(p.stream_size),
+    tdestMap(p.tdest_map),
+    broadcast(p.broadcast),
+    inBufferSize(p.in_buffer_size),
+    outBufferSize(p.out_buffer_size),
+    streamDelay(p.stream_latency),
+    bandwidth(p.bandwidth),
+    tickEvent([this]{ tick(); }, name()),
+    switchStats(*this) {}
+
+void
+StreamSwitch::startup() {
+    fatal_if(inputs.empty() || outputs.empty(),
+             "%s needs at least one input and one output\n", name());
+    for (auto dest : tdestMap) {
+        fatal_if((dest != Broadcast) && ((dest < 0) || (dest >= (int)outputs.size())),
+                 "%s routes a TDEST to output %d of %d\n", name(), dest, outputs.size());
+    }
+}
+
+int
+StreamSwitch::route(unsigned tdest) const {
+    if (broadcast) return Broadcast;
+    return tdestMap.empty() ? tdest : tdestMap[tdest];
+}
+
+bool
+StreamSwitch::tvalid(bool input, unsigned index, size_t len) {
+    if (input) {
+        Input &in = *inputs[index];
+        if ((in.data.space() >= len) && (in.transfers.space() > 0)) return true;
+        switchStats.writeStalls++;
+    } else {
+        if (outputs[index]->data.size() >= len) return true;
+        switchStats.readStalls++;
+    }
+    return false;
+}
+
+bool
+StreamSwitch::tvalid(PacketPtr pkt) {
+    panic("%s: stream access without a switch port\n", name());
+}
+
+bool
+StreamSwitch::tvalid(size_t len, bool isRead) {
+    panic("%s: stream access without a switch port\n", name());
+}
+
+void
+StreamSwitch::wakeup() {
+    if (!tickEvent.scheduled()) {
+        schedule(tickEvent, nextCycle());
+    }
+}
+
+Tick
+StreamSwitch::streamWrite(PacketPtr pkt) {
+    Addr offset = pkt->getAddr() - inAddress;
+    unsigned index = offset / inWindow();
+    unsigned tdest = (offset % inWindow()) / streamSize;
+    Input &in = *inputs[index];
+    panic_if(pkt->getSize() > outBufferSize,
+             "%s: %d byte transfer does not fit an output FIFO\n", name(), pkt->getSize());
+    DPRINTF(StreamSwitch, "Input %d received a %d byte transfer for TDEST %d\n",
+            index, pkt->getSize(), tdest);
+    panic_if(!in.data.tryWrite(pkt->getConstPtr<uint8_t>(), pkt->getSize()) ||
+             !in.transfers.push({route(tdest), (uint32_t)pkt->getSize()}),
+             "Buffer overrun in StreamSwitch input %d\n", index);
+    wakeup();
+    pkt->makeAtomicResponse();
+    return streamDelay;
+}
+
+Tick
+StreamSwitch::streamRead(PacketPtr pkt) {
+    unsigned index = (pkt->getAddr() - outAddress) / streamSize;
+    Output &out = *outputs[index];
+    DPRINTF(StreamSwitch, "Output %d received a %d byte read\n", index, pkt->getSize());
+    if (pkt->getSize() > sizeof(uint64_t)) {
+        panic_if(!out.data.tryRead(pkt->getPtr<uint8_t>(), pkt->getSize()),
+                 "Buffer underrun in StreamSwitch output %d\n", index);
+    } else {
+        uint64_t data = 0;
+        panic_if(!out.data.tryRead((uint8_t *)&data, pkt->getSize()),
+                 "Buffer underrun in StreamSwitch output %d\n", index);
+
+        switch(pkt->getSize()) {
+          case 1:
+            pkt->set<uint8_t>(data, endian);
+            break;
+          case 2:
+            pkt->set<uint16_t>(data, endian);
+            break;
+          case 4:
+            pkt->set<uint32_t>(data, endian);
+            break;
+          case 8:
+            pkt->set<uint64_t>(data, endian);
+            break;
+          default:
+            panic("Read size too big?\n");
+            break;
+        }
+    }
+    // Freed space may unblock a transfer waiting for this output
+    wakeup();
+    Tick duration = pkt->getSize() * bandwidth;
+    pkt->makeAtomicResponse();
+    return duration;
+}
+
+// Copy the transfer at the front of an input into an output, leaving the
+// input untouched so a broadcast can copy it again
+void
+StreamSwitch::copyTo(Input &in, Output &out, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        auto span = out.data.writeSpan();
+        size_t n = std::min(len - done, span.size);
+        in.data.peek(span.data, n, done);
+        out.data.commitWrite(n);
+        done += n;
+    }
+}
+
+// Grant output out to one input, starting from its round-robin pointer.
+// Returns true if a transfer moved.
+bool
+StreamSwitch::arbitrate(unsigned out, std::vector<bool> &busy) {
+    Output &output = *outputs[out];
+    unsigned requests = 0;
+    int winner = -1;
+    for (unsigned k = 0; k < inputs.size(); k++) {
+        unsigned i = (output.nextInput + k) % inputs.size();
+        if (inputs[i]->transfers.empty()) continue;
+        const Transfer &t = inputs[i]->transfers.front();
+        if ((t.dest != (int)out) && (t.dest != Broadcast)) continue;
+        requests++;
+        if (winner < 0) winner = i;
+    }
+    if (requests > 1) switchStats.conflicts++;
+    if (winner < 0) return false;
+
+    Input &in = *inputs[winner];
+    Transfer t = in.transfers.front();
+    if (t.dest == Broadcast) {
+        // Every output takes a broadcast transfer in the same cycle
+        for (unsigned j = 0; j < outputs.size(); j++) {
+            if (busy[j] || (outputs[j]->data.space() < t.len)) {
+                switchStats.outputStalls++;
+                return false;
+            }
+        }
+        for (unsigned j = 0; j < outputs.size(); j++) {
+            copyTo(in, *outputs[j], t.len);
+            outputs[j]->nextInput = (winner + 1) % inputs.size();
+            busy[j] = true;
+        }
+        switchStats.broadcasts++;
+    } else {
+        if (output.data.space() < t.len) {
+            switchStats.outputStalls++;
+            return false;
+        }
+        copyTo(in, output, t.len);
+        output.nextInput = (winner + 1) % inputs.size();
+        busy[out] = true;
+    }
+    DPRINTF(StreamSwitch, "Moved %d bytes from input %d to %s\n", t.len, winner,
+            (t.dest == Broadcast) ? "all outputs" : csprintf("output %d", out));
+    in.data.commitRead(t.len);
+    in.transfers.commitRead(1);
+    switchStats.transfers++;
+    switchStats.bytesRouted += t.len;
+    return true;
+}
+
+// Each output accepts at most one transfer per cycle. The switch sleeps
+// until a stream access once nothing moved.
+void
+StreamSwitch::tick() {
+    std::vector<bool> busy(outputs.size(), false);
+    bool moved = false;
+    for (unsigned j = 0; j < outputs.size(); j++) {
+        if (!busy[j]) moved |= arbitrate(j, busy);
+    }
+    if (moved) wakeup();
+}
+
+AddrRangeList
+StreamSwitch::getPortRanges(bool input, unsigned index) const {
+    AddrRangeList ranges;
+    if (input) {
+        ranges.push_back(RangeSize(inAddress + index * inWindow(), inWindow()));
+    } else {
+        ranges.push_back(RangeSize(outAddress + index * streamSize, streamSize));
+    }
+    DPRINTF(AddrRanges, "registering range: %#x-%#x\n", ranges.front().start(),
+            ranges.front().end());
+    return ranges;
+}
+
+AddrRangeList
+StreamSwitch::getStreamAddrRanges() const {
+    AddrRangeList ranges;
+    ranges.push_back(RangeSize(inAddress, inputs.size() * inWindow()));
+    ranges.push_back(RangeSize(outAddress, outputs.size() * streamSize));
+    return ranges;
+}
+
+Port &
+StreamSwitch::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "stream_in") {
+        if (idx >= (PortID)inputs.size()) inputs.resize(idx + 1);
+        if (!inputs[idx]) inputs[idx].reset(new Input(this, idx));
+        return inputs[idx]->port;
+    } else if (if_name == "stream_out") {
+        if (idx >= (PortID)outputs.size()) outputs.resize(idx + 1);
+        if (!outputs[idx]) outputs[idx].reset(new Output(this, idx));
+        return outputs[idx]->port;
+    }
+    return ClockedObject::getPort(if_name, idx);
+}
+
+StreamSwitch::SwitchStats::SwitchStats(StreamSwitch &sw)
+    : statistics::Group(&sw, "switch"),
+    ADD_STAT(transfers, statistics::units::Count::get(),
+             "Number of transfers moved from an input to the outputs"),
+    ADD_STAT(broadcasts, statistics::units::Count::get(),
+             "Number of transfers copied to every output"),
+    ADD_STAT(bytesRouted, statistics::units::Byte::get(),
+             "Number of bytes moved from the inputs"),
+    ADD_STAT(conflicts, statistics::units::Count::get(),
+             "Number of arbitrations with more than one requesting input"),
+    ADD_STAT(outputStalls, statistics::units::Count::get(),
+             "Number of arbitrations whose winner found an output full"),
+    ADD_STAT(writeStalls, statistics::units::Count::get(),
+             "Number of writes refused because an input was full"),
+    ADD_STAT(readStalls, statistics::units::Count::get(),
+             "Number of reads refused because an output was empty")
+{
+}
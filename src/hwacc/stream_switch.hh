@@ -0,0 +1,142 @@
+#ifndef __HWACC_STREAM_SWITCH_HH__
+#define __HWACC_STREAM_SWITCH_HH__
+
+#include "params/StreamSwitch.hh"
+#include "base/statistics.hh"
+#include "sim/clocked_object.hh"
+#include "hwacc/stream_port.hh"
+#include "hwacc/stream_ring.hh"
+
+#include <memory>
+#include <vector>
+
+/**
+ * AXI-Stream style switch between N producers and M consumers, modeled on
+ * StreamBuffer. Each input port owns an address window with one slot of
+ * stream_size bytes per TDEST, so a producer picks the destination of a
+ * transfer by the address it writes. The tdest map sends each TDEST to an
+ * output or broadcasts it to all of them. Each output is its own FIFO, read
+ * through its own window, and picks its next transfer from the inputs in
+ * round-robin order. A transfer moves whole, and a broadcast transfer moves
+ * only once every output has room for it.
+ */
+class StreamSwitch : public ClockedObject {
+  private:
+    class SwitchPort : public StreamResponsePortT<StreamSwitch>
+    {
+      private:
+        bool input;
+        unsigned index;
+
+      protected:
+        bool tvalid(PacketPtr pkt) override {
+            return device->tvalid(input, index, pkt->getSize());
+        }
+        bool tvalid(size_t len, bool isRead) override {
+            return device->tvalid(input, index, len);
+        }
+        AddrRangeList getAddrRanges() const override {
+            return device->getPortRanges(input, index);
+        }
+
+      public:
+        SwitchPort(StreamSwitch *sw, bool _input, unsigned _index) :
+            StreamResponsePortT<StreamSwitch>(sw, csprintf(".stream_%s%d",
+                _input ? "in" : "out", _index)),
+            input(_input), index(_index) {}
+    };
+
+    struct Transfer
+    {
+        int dest;
+        uint32_t len;
+    };
+
+    struct Input
+    {
+        Input(StreamSwitch *sw, unsigned index);
+
+        SwitchPort port;
+        StreamRing<uint8_t> data;
+        StreamRing<Transfer> transfers;
+    };
+
+    struct Output
+    {
+        Output(StreamSwitch *sw, unsigned index);
+
+        SwitchPort port;
+        StreamRing<uint8_t> data;
+        // Input that wins the next tie
+        unsigned nextInput;
+    };
+
+    std::vector<std::unique_ptr<Input>> inputs;
+    std::vector<std::unique_ptr<Output>> outputs;
+
+    ByteOrder endian;
+    Addr inAddress;
+    Addr outAddress;
+    Addr streamSize;
+    std::vector<int> tdestMap;
+    bool broadcast;
+    size_t inBufferSize;
+    size_t outBufferSize;
+    Tick streamDelay;
+    const double bandwidth;
+
+    static const int Broadcast = -1;
+
+    EventFunctionWrapper tickEvent;
+
+    unsigned numDests() const {
+        return tdestMap.empty() ? outputs.size() : tdestMap.size();
+    }
+    Addr inWindow() const { return numDests() * streamSize; }
+    int route(unsigned tdest) const;
+    void copyTo(Input &in, Output &out, size_t len);
+    bool arbitrate(unsigned out, std::vector<bool> &busy);
+    void wakeup();
+    void tick();
+
+    struct SwitchStats : public statistics::Group
+    {
+        SwitchStats(StreamSwitch &sw);
+
+        statistics::Scalar transfers;
+        statistics::Scalar broadcasts;
+        statistics::Scalar bytesRouted;
+        /** Cycles in which several inputs wanted the same output */
+        statistics::Scalar conflicts;
+        /** Cycles in which the winning transfer found its output full */
+        statistics::Scalar outputStalls;
+        /** Accesses refused by tvalid because an input was full */
+        statistics::Scalar writeStalls;
+        /** Accesses refused by tvalid because an output was empty */
+        statistics::Scalar readStalls;
+    } switchStats;
+
+  public:
+    PARAMS(StreamSwitch);
+    StreamSwitch(const StreamSwitchParams &p);
+
+    void startup() override;
+
+    bool tvalid(bool input, unsigned index, size_t len);
+    // Only used by the generic stream port, every switch port overrides it
+    bool tvalid(PacketPtr pkt);
+    bool tvalid(size_t len, bool isRead);
+
+    Tick streamRead(PacketPtr pkt);
+    Tick streamWrite(PacketPtr pkt);
+
+    AddrRangeList getPortRanges(bool input, unsigned index) const;
+    AddrRangeList getStreamAddrRanges() const;
+
+    Port &getPort(const std::string &if_name,
+            PortID idx=InvalidPortID) override;
+
+    double getBandwidth(){ return bandwidth; };
+};
+
+#endif // __HWACC_STREAM_SWITCH_HH__
@@ -0,0 +1,80 @@
+#ifndef __HWACC_STRIDED_BLOCK_HH__
+#define __HWACC_STRIDED_BLOCK_HH__
+
+#include "base/types.hh"
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * A DMA block of planes * rows rows of rowSize bytes. Row r of plane p starts
+ * at start + p * planeStride + r * rowStride, and a contiguous block is a
+ * single row. The DMA FIFOs walk the block in requests that end at the end
+ * of a row or at a maxReqSize boundary, so every burst is line aligned.
+ */
+class StridedBlock
+{
+  public:
+    gem5::Addr start;
+    size_t rowSize;
+    size_t rows;
+    gem5::Addr rowStride;
+    size_t planes;
+    gem5::Addr planeStride;
+
+    // Progress: row index over all planes and bytes done in that row
+    size_t row;
+    size_t offset;
+
+    StridedBlock() : StridedBlock(0, 0) { }
+
+    // Rows and planes of 0 count as 1
+    StridedBlock(gem5::Addr _start, size_t row_size, size_t _rows=1,
+                 gem5::Addr row_stride=0, size_t _planes=1,
+                 gem5::Addr plane_stride=0)
+        : start(_start), rowSize(row_size), rows(std::max<size_t>(_rows, 1)),
+          rowStride(row_stride), planes(std::max<size_t>(_planes, 1)),
+          planeStride(plane_stride), row(0), offset(0)
+    {
+        if (rowSize == 0) row = totalRows();
+    }
+
+    size_t totalRows() const { return rows * planes; }
+    size_t size() const { return totalRows() * rowSize; }
+    bool done() const { return row >= totalRows(); }
+
+    // Bytes from the start of the block to the end of its last row
+    gem5::Addr
+    footprint() const
+    {
+        if (rowSize == 0) return 0;
+        return (planes - 1) * planeStride + (rows - 1) * rowStride + rowSize;
+    }
+
+    gem5::Addr
+    rowAddr(size_t r) const
+    {
+        return start + (r / rows) * planeStride + (r % rows) * rowStride;
+    }
+
+    gem5::Addr nextAddr() const { return rowAddr(row) + offset; }
+
+    size_t
+    nextSize(size_t max_req_size) const
+    {
+        size_t boundary = max_req_size - (nextAddr() % max_req_size);
+        return std::min(rowSize - offset, boundary);
+    }
+
+    void
+    advance(size_t bytes)
+    {
+        offset += bytes;
+        if (offset >= rowSize) {
+            row++;
+            offset = 0;
+        }
+    }
+};
+
+#endif //__HWACC_STRIDED_BLOCK_HH__
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include "hwacc/strided_block.hh"
+
+/*
+ * Checks that StridedBlock walks every byte of a block exactly once, in row
+ * order, in requests that stay within a row and a request-size boundary.
+ */
+
+using namespace gem5;
+
+namespace
+{
+
+// Walk the block and return the bytes it covered, checking every request
+std::map<Addr, size_t>
+walk(StridedBlock block, size_t max_req_size, size_t &requests)
+{
+    std::map<Addr, size_t> covered;
+    requests = 0;
+    while (!block.done()) {
+        Addr addr = block.nextAddr();
+        size_t size = block.nextSize(max_req_size);
+        EXPECT_GT(size, 0u);
+        EXPECT_EQ(addr / max_req_size, (addr + size - 1) / max_req_size);
+        for (size_t i = 0; i < size; i++) covered[addr + i]++;
+        block.advance(size);
+        requests++;
+    }
+    return covered;
+}
+
+} // anonymous namespace
+
+TEST(StridedBlock, Contiguous)
+{
+    StridedBlock block(0x1000, 256);
+    EXPECT_EQ(block.totalRows(), 1u);
+    EXPECT_EQ(block.size(), 256u);
+    EXPECT_EQ(block.footprint(), 256u);
+
+    size_t requests;
+    auto covered = walk(block, 64, requests);
+    EXPECT_EQ(requests, 4u);
+    EXPECT_EQ(covered.size(), 256u);
+
+    // An unaligned start costs one extra request, not one per line
+    walk(StridedBlock(0x1010, 256), 64, requests);
+    EXPECT_EQ(requests, 5u);
+
+    EXPECT_TRUE(StridedBlock(0x1000, 0).done());
+}
+
+TEST(StridedBlock, Tile)
+{
+    // A 3D tile of 2 planes of 4 rows of 40 bytes
+    StridedBlock block(0x2008, 40, 4, 0x100, 2, 0x1000);
+    EXPECT_EQ(block.size(), 320u);
+    EXPECT_EQ(block.footprint(), 0x1000u + 0x300 + 40);
+    EXPECT_EQ(block.rowAddr(5), 0x2008u + 0x1000 + 0x100);
+
+    size_t requests;
+    auto covered = walk(block, 64, requests);
+    EXPECT_EQ(requests, 8u);
+    EXPECT_EQ(covered.size(), 320u);
+    for (size_t r = 0; r < block.totalRows(); r++) {
+        for (size_t i = 0; i < 40; i++)
+            EXPECT_EQ(covered[block.rowAddr(r) + i], 1u);
+    }
+}
+
+TEST(StridedBlock, RandomBlocks)
+{
+    std::mt19937_64 rng(12345);
+    for (int i = 0; i < 1000; i++) {
+        size_t row_size = 1 + rng() % 300;
+        size_t rows = 1 + rng() % 8;
+        size_t planes = 1 + rng() % 4;
+        Addr row_stride = row_size + rng() % 128;
+        Addr plane_stride = rows * row_stride + rng() % 512;
+        StridedBlock block(rng() % 0x10000, row_size, rows, row_stride,
+                           planes, plane_stride);
+
+        size_t requests;
+        auto covered = walk(block, 64, requests);
+        ASSERT_EQ(covered.size(), block.size());
+        for (auto &byte : covered) ASSERT_EQ(byte.second, 1u);
+        ASSERT_LE(requests, block.totalRows() * (row_size / 64 + 2));
+    }
+}
@@ -0,0 +1,248 @@
+//------------------------------------------//
+#include "hwacc/strided_read_fifo.hh"
+//------------------------------------------//
+
+StridedReadFifo::StridedReadFifo(DmaPort &_port, size_t size,
+                                 unsigned max_req_size,
+                                 unsigned max_pending,
+                                 Request::Flags flags)
+    : maxReqSize(max_req_size), fifoSize(size),
+      reqFlags(flags), port(_port), cacheLineSize(port.sys->cacheLineSize()),
+      buffer(size)
+{
+    freeRequests.resize(max_pending);
+    for (auto &e : freeRequests)
+        e.reset(new DmaDoneEvent(this, max_req_size));
+}
+
+StridedReadFifo::~StridedReadFifo()
+{
+    for (auto &p : pendingRequests) {
+        DmaDoneEvent *e(p.release());
+
+        if (e->done()) {
+            delete e;
+        } else {
+            // We can't kill in-flight DMAs, so we'll just transfer
+            // ownership to the event queue so that they get freed
+            // when they are done.
+            e->kill();
+        }
+    }
+}
+
+void
+StridedReadFifo::serialize(CheckpointOut &cp) const
+{
+    assert(pendingRequests.empty());
+
+    SERIALIZE_CONTAINER(buffer);
+    paramOut(cp, "blockStart", block.start);
+    paramOut(cp, "blockRowSize", block.rowSize);
+    paramOut(cp, "blockRows", block.rows);
+    paramOut(cp, "blockRowStride", block.rowStride);
+    paramOut(cp, "blockPlanes", block.planes);
+    paramOut(cp, "blockPlaneStride", block.planeStride);
+    paramOut(cp, "blockRow", block.row);
+    paramOut(cp, "blockOffset", block.offset);
+}
+
+void
+StridedReadFifo::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_CONTAINER(buffer);
+    paramIn(cp, "blockStart", block.start);
+    paramIn(cp, "blockRowSize", block.rowSize);
+    paramIn(cp, "blockRows", block.rows);
+    paramIn(cp, "blockRowStride", block.rowStride);
+    paramIn(cp, "blockPlanes", block.planes);
+    paramIn(cp, "blockPlaneStride", block.planeStride);
+    paramIn(cp, "blockRow", block.row);
+    paramIn(cp, "blockOffset", block.offset);
+}
+
+bool
+StridedReadFifo::tryGet(uint8_t *dst, size_t len)
+{
+    if (buffer.size() >= len) {
+        buffer.read(dst, len);
+        resumeFill();
+        return true;
+    } else {
+        return false;
+    }
+}
+
+void
+StridedReadFifo::get(uint8_t *dst, size_t len)
+{
+    panic_if(!tryGet(dst, len), "Buffer underrun in StridedReadFifo::get()");
+}
+
+void
+StridedReadFifo::startFill(Addr start, size_t size)
+{
+    startFill(StridedBlock(start, size));
+}
+
+void
+StridedReadFifo::startFill(const StridedBlock &blk)
+{
+    assert(atEndOfBlock());
+
+    block = blk;
+    resumeFill();
+}
+
+void
+StridedReadFifo::stopFill()
+{
+    // Prevent new DMA requests by moving past the last row of the
+    // block. Pending requests will still complete.
+    block.row = block.totalRows();
+    block.offset = 0;
+
+    // Flag in-flight accesses as canceled. This prevents their data
+    // from being written to the FIFO.
+    for (auto &p : pendingRequests)
+        p->cancel();
+}
+
+void
+StridedReadFifo::resumeFill()
+{
+    // Don't try to fetch more data if we are draining. This ensures
+    // that the DMA engine settles down before we checkpoint it.
+    if (drainState() == DrainState::Draining)
+        return;
+
+    if (port.sys->bypassCaches())
+        resumeFillBypass();
+    else
+        resumeFillTiming();
+}
+
+void
+StridedReadFifo::resumeFillBypass()
+{
+    assert(pendingRequests.empty());
+    std::vector<uint8_t> tmp_buffer(maxReqSize);
+
+    while (!atEndOfBlock()) {
+        const size_t fifo_space = buffer.capacity() - buffer.size();
+        const size_t xfer_size = block.nextSize(maxReqSize);
+        if (fifo_space < xfer_size)
+            break;
+
+        DPRINTF(DMA, "Direct bypass startAddr=%#x xfer_size=%#x " \
+                "fifo_space=%#x\n", block.nextAddr(), xfer_size, fifo_space);
+
+        port.dmaAction(MemCmd::ReadReq, block.nextAddr(), xfer_size, nullptr,
+                tmp_buffer.data(), 0, reqFlags);
+
+        buffer.write(tmp_buffer.begin(), xfer_size);
+        block.advance(xfer_size);
+    }
+}
+
+void
+StridedReadFifo::resumeFillTiming()
+{
+    size_t size_pending(0);
+    for (auto &e : pendingRequests)
+        size_pending += e->requestSize();
+
+    while (!freeRequests.empty() && !atEndOfBlock()) {
+        const size_t req_size(block.nextSize(maxReqSize));
+        if (buffer.size() + size_pending + req_size > fifoSize)
+            break;
+
+        DmaDoneEventUPtr event(std::move(freeRequests.front()));
+        freeRequests.pop_front();
+        assert(event);
+
+        event->reset(req_size);
+        port.dmaAction(MemCmd::ReadReq, block.nextAddr(), req_size,
+                       event.get(), event->data(), 0, reqFlags);
+        block.advance(req_size);
+        size_pending += req_size;
+
+        pendingRequests.emplace_back(std::move(event));
+    }
+}
+
+void
+StridedReadFifo::dmaDone()
+{
+    handlePending();
+    resumeFill();
+
+    if (onResponse)
+        onResponse();
+}
+
+void
+StridedReadFifo::handlePending()
+{
+    while (!pendingRequests.empty() && pendingRequests.front()->done()) {
+        // Get the first finished pending request
+        DmaDoneEventUPtr event(std::move(pendingRequests.front()));
+        pendingRequests.pop_front();
+
+        if (!event->canceled())
+            buffer.write(event->data(), event->requestSize());
+
+        // Move the event to the list of free requests
+        freeRequests.emplace_back(std::move(event));
+    }
+
+    if (pendingRequests.empty())
+        signalDrainDone();
+}
+
+DrainState
+StridedReadFifo::drain()
+{
+    return pendingRequests.empty() ?
+        DrainState::Drained : DrainState::Draining;
+}
+
+
+StridedReadFifo::DmaDoneEvent::DmaDoneEvent(StridedReadFifo *_parent,
+                                            size_t max_size)
+    : parent(_parent), _data(max_size, 0)
+{
+}
+
+void
+StridedReadFifo::DmaDoneEvent::kill()
+{
+    parent = nullptr;
+    setFlags(AutoDelete);
+}
+
+void
+StridedReadFifo::DmaDoneEvent::cancel()
+{
+    _canceled = true;
+}
+
+void
+StridedReadFifo::DmaDoneEvent::reset(size_t size)
+{
+    assert(size <= _data.size());
+    _done = false;
+    _canceled = false;
+    _requestSize = size;
+}
+
+void
+StridedReadFifo::DmaDoneEvent::process()
+{
+    if (!parent)
+        return;
+
+    assert(!_done);
+    _done = true;
+    parent->dmaDone();
+}
@@ -0,0 +1,149 @@
+#ifndef __HWACC_STRIDED_READ_FIFO_HH__
+#define __HWACC_STRIDED_READ_FIFO_HH__
+//------------------------------------------//
+#include "hwacc/LLVMRead/src/debug_flags.hh"
+#include "dev/dma_device.hh"
+#include "hwacc/strided_block.hh"
+//------------------------------------------//
+
+#include <functional>
+
+using namespace gem5;
+
+/**
+ * A DMA read FIFO, after gem5's DmaReadFifo, that fills from strided blocks.
+ * Requests never cross the end of a row or a max_req_size boundary. The
+ * owner can register a wakeup that runs after every response, so a DMA
+ * engine only needs to run when the FIFO has made progress.
+ */
+class StridedReadFifo : public Drainable, public Serializable
+{
+  public:
+    StridedReadFifo(DmaPort &port, size_t size,
+                    unsigned max_req_size,
+                    unsigned max_pending,
+                    Request::Flags flags = 0);
+
+    ~StridedReadFifo();
+
+  public: // Serializable
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+  public: // Drainable
+    DrainState drain() override;
+
+  public: // FIFO access
+    /**
+     * Try to read data from the FIFO.
+     *
+     * @param dst Pointer to a destination buffer
+     * @param len Amount of data to read.
+     * @return true on success, false otherwise.
+     */
+    bool tryGet(uint8_t *dst, size_t len);
+
+    /** Read data from the FIFO and panic on failure. */
+    void get(uint8_t *dst, size_t len);
+
+    /** Get the amount of data stored in the FIFO */
+    size_t size() const { return buffer.size(); }
+    /** Flush the FIFO */
+    void flush() { buffer.flush(); }
+
+  public: // FIFO fill control
+    /** Start filling the FIFO from a contiguous block */
+    void startFill(Addr start, size_t size);
+
+    /**
+     * Start filling the FIFO from a strided block.
+     *
+     * @warn It's considered an error to call start on an active DMA
+     * engine unless the last request from the active block has been
+     * sent (i.e., atEndOfBlock() is true).
+     */
+    void startFill(const StridedBlock &blk);
+
+    /**
+     * Stop filling the FIFO and ignore incoming responses for pending
+     * requests.
+     */
+    void stopFill();
+
+    /** Has the last request of the active block been sent? */
+    bool atEndOfBlock() const { return block.done(); }
+
+    /** Are there still in-flight accesses or requests to send? */
+    bool isActive() const {
+        return !(pendingRequests.empty() && atEndOfBlock());
+    }
+
+    /** Run wakeup after each DMA response has been handled */
+    void setWakeup(std::function<void()> wakeup) { onResponse = wakeup; }
+
+  private: // Configuration
+    /** Maximum request size in bytes */
+    const Addr maxReqSize;
+    /** Maximum FIFO size in bytes */
+    const size_t fifoSize;
+    /** Request flags */
+    const Request::Flags reqFlags;
+
+    DmaPort &port;
+
+    const int cacheLineSize;
+
+  private:
+    class DmaDoneEvent : public Event
+    {
+      public:
+        DmaDoneEvent(StridedReadFifo *_parent, size_t max_size);
+
+        void kill();
+        void cancel();
+        bool canceled() const { return _canceled; }
+        void reset(size_t size);
+        void process();
+
+        bool done() const { return _done; }
+        size_t requestSize() const { return _requestSize; }
+        const uint8_t *data() const { return _data.data(); }
+        uint8_t *data() { return _data.data(); }
+
+      private:
+        StridedReadFifo *parent;
+        bool _done = false;
+        bool _canceled = false;
+        size_t _requestSize;
+        std::vector<uint8_t> _data;
+    };
+
+    typedef std::unique_ptr<DmaDoneEvent> DmaDoneEventUPtr;
+
+    /** DMA request done, handle incoming data and issue new requests. */
+    void dmaDone();
+
+    /** Handle pending requests that have been flagged as done. */
+    void handlePending();
+
+    /** Try to issue new DMA requests or bypass DMA requests*/
+    void resumeFill();
+
+    /** Try to issue new DMA requests during normal execution*/
+    void resumeFillTiming();
+
+    /** Try to bypass DMA requests in non-caching mode */
+    void resumeFillBypass();
+
+  private: // Internal state
+    Fifo<uint8_t> buffer;
+
+    StridedBlock block;
+
+    std::function<void()> onResponse;
+
+    std::deque<DmaDoneEventUPtr> pendingRequests;
+    std::deque<DmaDoneEventUPtr> freeRequests;
+};
+
+#endif //__HWACC_STRIDED_READ_FIFO_HH__